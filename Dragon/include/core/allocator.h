@@ -0,0 +1,56 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// ------------------------------------------------------------
+
+#ifndef DRAGON_CORE_ALLOCATOR_H_
+#define DRAGON_CORE_ALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dragon {
+
+#define CPU_ALLOCATOR_ALIGNMENT 64
+
+/**************************************************************************
+ *  A caching allocator for the host memory.
+ *  Requests are rounded up to size classes (4 classes per power of two),
+    and the freed blocks are kept in the thread-local free lists first,
+    then in a global arena shared by all threads.
+ *  Blocks are 64-byte aligned, and requests larger than the biggest class
+    bypass the cache.
+ *  The arena stops caching once it holds more than the cache limit.
+ *************************************************************************/
+
+class CPUAllocator {
+ public:
+    struct Stats {
+        int64_t hits = 0;           //  requests served from the cache
+        int64_t misses = 0;         //  requests served by the system
+        int64_t bytes_cached = 0;   //  bytes holding in the free lists
+        int64_t bytes_in_use = 0;   //  bytes holding by the users
+    };
+
+    static void* New(size_t nbytes);
+    static void Delete(void* ptr);
+
+    //  return the blocks cached by the arena and the calling thread
+    static void Trim();
+
+    static void SetCacheLimit(size_t nbytes);
+    static Stats GetStats();
+
+    //  bytes allocated by the calling thread since its start
+    static int64_t ThreadAllocatedBytes();
+};
+
+}    // namespace dragon
+
+#endif    // DRAGON_CORE_ALLOCATOR_H_
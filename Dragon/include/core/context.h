@@ -16,7 +16,9 @@
 #include <ctime>
 
 #include "common.h"
+#include "core/allocator.h"
 #include "utils/logging.h"
+#include "utils/philox.h"
 
 #ifdef WITH_CUDA
 #include "utils/cuda_device.h"
@@ -31,30 +33,41 @@ public:
 
 class CPUContext {
  public:
-    CPUContext(): random_seed_(3) { generator(); }
-    CPUContext(unsigned int random_seed): random_seed_(random_seed) { generator(); }
-    CPUContext(const DeviceOption& option): random_seed_(option.has_random_seed() ?
-                                                         option.random_seed() : 3) { generator(); }
-    virtual ~CPUContext() {}
-
-    inline void SwitchToDevice() {}
-    inline void FinishDeviceCompution() { return; }
+    CPUContext(): random_seed_(3), philox_stream_(0),
+          philox_offset_(0), last_(nullptr) { generator(); }
+    CPUContext(unsigned int random_seed)
+        : random_seed_(random_seed), philox_stream_(0),
+          philox_offset_(0), last_(nullptr) { generator(); }
+    CPUContext(const DeviceOption& option)
+        : random_seed_(option.has_random_seed() ? option.random_seed() : 3),
+          philox_stream_(0), philox_offset_(0), last_(nullptr) { generator(); }
+    virtual ~CPUContext() { if (current_ == this) current_ = nullptr; }
+
+    //  the random kernels draw from the context running on this thread
+    inline void SwitchToDevice() { last_ = current_; current_ = this; }
+    inline void FinishDeviceCompution() { current_ = last_; }
 
     inline static void* New(size_t nbytes) {
         void* data;
 #ifdef WITH_CUDA_HOST_MEM
         CUDA_CHECK(cudaMallocHost(&data, nbytes));
+        CHECK(data) << "Malloc mem: " << nbytes << " bytes failed.";
 #else
-        data = malloc(nbytes);
+        data = CPUAllocator::New(nbytes);
 #endif
-        CHECK(data) << "Malloc mem: " << nbytes << " bytes failed.";
         return data;
     }
 
     inline static void Memset(size_t nbytes, void* ptr) { memset(ptr, 0, nbytes); }
     template<class DstContext, class SrcContext>
     inline static void Memcpy(size_t nbytes, void* dst, const void* src) { memcpy(dst, src, nbytes); }
-    inline static void Delete(void* data) { free(data); }
+    inline static void Delete(void* data) {
+#ifdef WITH_CUDA_HOST_MEM
+        free(data);
+#else
+        CPUAllocator::Delete(data);
+#endif
+    }
 
     template<class DstContext, class SrcContext>
     inline static void MemcpyAsync(size_t nbytes, void* dst, const void* src) { NOT_IMPLEMENTED; }
@@ -75,16 +88,39 @@ class CPUContext {
         return generator.get();
     }
 
+    //  the counter-based generator is keyed by the seed and the stream,
+    //  e.g. the operators sharing a seed take the different streams,
+    //  and each call takes a new offset, i.e. a disjoint sequence
+    inline void set_philox_stream(uint32_t stream) { philox_stream_ = stream; }
+    inline Philox4x32 philox_generator() {
+        return Philox4x32(((uint64_t)philox_stream_ << 32) | random_seed_,
+                          philox_offset_++);
+    }
+
+    static CPUContext* current() {
+        //  the kernels called out of a cpu operator use the default one
+        static thread_local CPUContext default_context;
+        return current_ ? current_ : &default_context;
+    }
+
     static CPUObject cpu_object_;
 
  private:
     unsigned int random_seed_;
+    uint32_t philox_stream_;
+    uint64_t philox_offset_;
+    CPUContext* last_;
+    static thread_local CPUContext* current_;
 };
 
 static inline std::mt19937* rand_generator() {
     return CPUContext::cpu_object_.rand_generator.get();
 }
 
+static inline Philox4x32 philox_generator() {
+    return CPUContext::current()->philox_generator();
+}
+
 }    // namepsace dragon
 
 #endif    // DRAGON_CORE_CONTEXT_H_
\ No newline at end of file
@@ -92,6 +92,9 @@ class CUDAContext {
         cuda_object_.cur_gpu = gpu_id_;
     }
 
+    //  the curand generator is shared by the device
+    inline void set_philox_stream(uint32_t stream) {}
+
     void FinishDeviceCompution() {
         cudaStreamSynchronize(cudaStreamDefault);
         cudaError_t error = cudaGetLastError();
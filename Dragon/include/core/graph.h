@@ -14,6 +14,9 @@
 
 #include "core/common.h"
 #include "core/operator.h"
+#include "core/memory_planner.h"
+#include "core/profiler.h"
+#include "utils/thread_pool.h"
 
 namespace dragon {
 
@@ -40,7 +43,7 @@ class GraphBase {
     Workspace* ws_;
 };
 
-class Graph final : public GraphBase {
+class Graph : public GraphBase {
  public:
     Graph(const GraphDef& meta_graph, Workspace* ws);
     ~Graph() { for (auto* op : ops_) delete op; }
@@ -50,26 +53,117 @@ class Graph final : public GraphBase {
 
     GraphDef Prune(const GraphDef& meta_graph);
     GraphDef MakeUpdate(const GraphDef& meta_graph);
+    vector<OperatorDef> MergeUpdate(const vector<OperatorDef>& update_ops,
+                                    const int max_count);
     GraphDef Share(const GraphDef& optimized_graph);
+    GraphDef FoldInference(const GraphDef& meta_graph);
+    GraphDef EliminateCommon(const GraphDef& meta_graph);
+    GraphDef FoldConstant(const GraphDef& meta_graph,
+                          vector<OperatorDef>* constant_ops);
     void RecomputingAware(const GraphDef& optimized_graph, Workspace* ws);
 
     inline Workspace* ws() const { return ws_; }
+    inline const MemoryPlanner* memory_planner() const { return planner_.get(); }
+
+    inline bool profiling() const {
+        return profiling_ || Profiler::Get()->enabled();
+    }
+
+ protected:
+    //  the operators selected by the rules of include and exclude,
+    //  compiled once for each rules and phase at the first running
+    struct ExecutionPlan {
+        string include, exclude, phase;
+        vector<OperatorBase*> ops;
+        vector<int> op_indices;
+        vector<bool> skipped;
+    };
+    const ExecutionPlan& GetExecutionPlan(const string& include,
+                                          const string& exclude);
+
+    void PlanMemory();
+    void BindHooks();
+    bool MergePendingUpdates();
+
+    vector<OperatorBase*> ops_;
+    unique_ptr<MemoryPlanner> planner_;
+    bool bind_memory_, plan_pending_, profiling_;
+    //  the updates waiting for the parameters to be grouped
+    vector<OperatorDef> pending_updates_;
+    int num_updates_;
+    //  the hooked tensors written by each operator, and the ones it writes last
+    vector<vector<string> > write_hooks_, ready_hooks_;
+    bool bind_hooks_;
+    int hook_version_;
+    Map<string, ExecutionPlan> plans_;
+    const ExecutionPlan* last_plan_;
 
  private:
     void ForwardShareDyeing(string u, string ancestor);
     void ForwardPruneDyeing(string u, string leaf, vector<string> path);
     void BackwardPruneDyeing(string v);
 
-    vector<OperatorBase*> ops_;
     Map<string, Node> dag_;
     Map<string, bool> visited_, colored_;
     Map<string, string> renamed_;
+    Set<string> constants_;
     Set<string> targets_;
 };
 
+/**************************************************************************
+ *  ParallelGraph dispatches the operators to a work-stealing thread pool
+    as soon as all of their producers have finished.
+ *  The dependencies are built once at the creation over the final
+    (pruned and shared) operators, i.e. the in-place renames are resolved.
+ *  Set the graph argument "num_threads" to bound the pool size.
+ *************************************************************************/
+
+class ParallelGraph final : public Graph {
+ public:
+    ParallelGraph(const GraphDef& meta_graph, Workspace* ws);
+
+    bool Run(const string& include, const string& exclude) override;
+
+ private:
+    void BuildDependency();
+    bool InputsReshaped();
+    void Dispatch(int op_idx);
+    void Finish(int op_idx);
+
+    vector<vector<int> > successors_;
+    vector<int> num_parents_;
+    vector<bool> pinned_, skipped_;
+    vector<pair<Tensor*, vector<TIndex> > > external_inputs_;
+    unique_ptr<std::atomic<int>[]> deps_left_;
+    unique_ptr<ThreadPool> pool_;
+    bool serial_mode_, warmed_up_;
+
+    //  the status of a running
+    int num_unfinished_;
+    queue<int> pinned_queue_;
+    std::mutex run_mutex_;
+    std::condition_variable run_cond_;
+};
+
+//  fuse the trees of elementwise operators into FusedElementwise,
+//  whose intermediate results are read by the tree only.
+//  the targets, and the costs and wrts of g_targets are kept
+GraphDef FuseElementwise(const GraphDef& meta_graph);
+
+//  infer the shapes of outputs statically by the schemas of operators,
+//  starting from the non-empty tensors of workspace.
+//  the outputs can not be inferred are excluded,
+//  and the invalid shapes of inputs stop it with the error if given
+Map<string, TensorProto> InferShapes(const GraphDef& meta_graph,
+                                     Workspace* ws,
+                                     string* error = nullptr);
+
 GraphBase* NewGraph(const GraphDef& meta_graph, Workspace* ws);
 DECLARE_REGISTRY(GraphRegistry, GraphBase, const GraphDef&, Workspace*);
 
+#define REGISTER_GRAPH(name, ...) \
+    REGISTER_CLASS(GraphRegistry, name, __VA_ARGS__)
+
 }    // namespace dragon
 
 #endif    // DRAGON_CORE_GRAPH_H_
\ No newline at end of file
@@ -0,0 +1,78 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// ------------------------------------------------------------
+
+#ifndef DRAGON_CORE_MEMORY_PLANNER_H_
+#define DRAGON_CORE_MEMORY_PLANNER_H_
+
+#include "core/common.h"
+#include "core/operator.h"
+
+namespace dragon {
+
+/**************************************************************************
+ *  MemoryPlanner assigns the intermediate tensors of a graph
+    to the offsets of a single arena.
+ *  The live ranges are computed over the final order of operators,
+    a tensor is planned only if it is written before any reading,
+    and is read (but not written) by the last operator touching it.
+ *  The sizes are measured from the first full running, and the offsets
+    are assigned by the best-fit interval coloring (larger blocks first).
+ *  The tensors aliasing the same memory are planned as one block.
+ *************************************************************************/
+
+class MemoryPlanner {
+ public:
+    struct Block {
+        vector<Tensor*> tensors;
+        TypeMeta meta;
+        int start, end;
+        size_t nbytes, offset;
+        shared_ptr<MixedMemory> memory;
+    };
+
+    MemoryPlanner(const vector<OperatorBase*>& ops,
+                  const Set<string>& targets,
+                  Workspace* ws);
+
+    //  measure the sizes and assign the offsets, false if nothing planned
+    bool Plan();
+
+    //  bind the planned tensors to the slices of a new arena
+    void Bind();
+
+    //  check whether any bound tensor has left the arena, e.g. grows
+    bool Escaped();
+
+    //  store the bytes into the arguments of a graph
+    void Report(GraphDef* graph_def) const;
+
+    inline bool planned() const { return planned_; }
+    inline size_t planned_bytes() const { return planned_bytes_; }
+    inline size_t naive_bytes() const { return naive_bytes_; }
+    inline size_t lower_bytes() const { return lower_bytes_; }
+    inline int num_tensors() const {
+        int num_tensors = 0;
+        for (auto& block : blocks_) num_tensors += (int)block.tensors.size();
+        return num_tensors;
+    }
+
+ private:
+    Map<string, pair<int, int> > ranges_;
+    vector<Block> blocks_;
+    shared_ptr<void> arena_;
+    size_t planned_bytes_, naive_bytes_, lower_bytes_;
+    bool planned_;
+    Workspace* ws_;
+};
+
+}    // namespace dragon
+
+#endif    // DRAGON_CORE_MEMORY_PLANNER_H_
@@ -41,6 +41,11 @@ class MixedMemory {
 
     void SwitchToDevice();
 
+    //  borrow the host memory from the outside,
+    //  the owner (if given) will be kept alive until the destruction
+    void set_cpu_data(void* cpu_ptr, size_t nbytes,
+                      shared_ptr<void> owner = nullptr);
+
     inline size_t nbytes() const { return nbytes_; }
 
     inline void* cpu_ptr() { state_ = STATE_AT_CPU; return cpu_ptr_; }
@@ -56,6 +61,8 @@ class MixedMemory {
     State state_;
     size_t nbytes_;
     TypeMeta meta_;
+    bool own_cpu_ptr_ = true;
+    shared_ptr<void> cpu_owner_;
 };
 
 }    // namespace dragon
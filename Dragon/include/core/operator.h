@@ -18,6 +18,8 @@
 #include "core/operator_gradient.h"
 #include "core/operator_schema.h"
 #include "utils/cast.h"
+#include "utils/string.h"
+#include "utils/thread_pool.h"
 
 #ifdef WITH_MPI
 #include <mpi/mpi.h>
@@ -76,6 +78,8 @@ class Operator : public OperatorBase {
  public:
     Operator(const OperatorDef& op_def, Workspace* ws)
         : OperatorBase(op_def, ws), ctx_(op_def.device_option()) {
+        //  the operators sharing a seed draw the different random streams
+        ctx_.set_philox_stream(Philox4x32::StreamOf(name()));
         allow_run_ = true;
         allow_run_ &= _MPICheck();
         allow_run_ &= (!(OutputSize() == 1 && Output(0)->name() == "ignore"));
@@ -182,8 +186,15 @@ DECLARE_REGISTRY(CUDNNOperatorRegistry, OperatorBase, const OperatorDef&, Worksp
         tensor.Reshape(shape); \
     }
 
+//  the scratches shared by the operators are private for each worker,
+//  as the operators may run concurrently in the thread pools
+inline string ScratchName(const string& name) {
+    int id = ThreadPool::ThreadId();
+    return id < 0 ? name : name + "/worker_" + dragon_cast<string, int>(id);
+}
+
 #define INIT_MULTIPLIER(ptr_tensor, size) { \
-    ptr_tensor = ws()->CreateTensor("/share/multiplier"); \
+    ptr_tensor = ws()->CreateTensor(ScratchName("/share/multiplier")); \
     if (size > ptr_tensor->count()) { \
         ptr_tensor->Reshape(vector<TIndex>(1, size)); \
         math::Set<T, Context>(size, dragon_cast<T, float>(1.0f), \
@@ -19,6 +19,22 @@
 
 namespace dragon {
 
+typedef int64_t TIndex;
+
+/**************************************************************************
+ *  The shapes and types of the outputs are inferred statically,
+    from the ones of the inputs and the arguments of OperatorDef.
+ *  Each result is a TensorProto filled with the dims and data_type.
+ *  The unknown inputs are given as the empty TensorProto (no data_type),
+    only the first "num_required" inputs are required to be known,
+    e.g. the weights of InnerProduct are filled at the first running.
+ *  Return an empty vector if it can not be inferred, e.g. the arguments
+    are given by tensors ("*_desc"), or the outputs are read from files.
+ *************************************************************************/
+
+typedef std::function<vector<TensorProto>(const OperatorDef&,
+    const vector<TensorProto>&)> ShapeInferenceFunction;
+
 class OpSchema {
  public:
     OpSchema() 
@@ -40,20 +56,56 @@ class OpSchema {
     OpSchema& NumOutputs(int n);
     OpSchema& NumOutputs(int min_num, int max_num);
 
+    OpSchema& ShapeInference(ShapeInferenceFunction function,
+                             int num_required = INT_MAX);
+    //  the outputs are all like Input(idx)
+    OpSchema& IdenticalShape(int idx = 0);
+    //  the output is like Input(idx), broadcasting the other as Add
+    OpSchema& BroadcastShape(int idx = 0);
+
+    inline bool HasShapeInference() const { return (bool)shape_inference_; }
+    //  the invalid shapes of inputs are reported by the error if given,
+    //  otherwise they are fatal
+    vector<TensorProto> InferShape(const OperatorDef& def,
+                                   const vector<TensorProto>& inputs,
+                                   string* error = nullptr) const;
+
  private:
     void Init() {
         min_input_ = min_output_= 0;
         max_input_ = max_output_ = std::numeric_limits<int>::max();
         CheckInplace = [](int, int) { return false; };
         ignore_verify_ =  allow_inplace_ = false;
+        num_required_ = INT_MAX;
     }
 
     string op_type_, file_;
     int line_, min_input_, max_input_;
     int min_output_, max_output_;
     bool allow_inplace_, ignore_verify_;
+    ShapeInferenceFunction shape_inference_;
+    int num_required_;
 };
 
+//  the helpers to make the shape inference functions
+TensorProto TensorShape(const vector<TIndex>& dims,
+                        TensorProto::DataType data_type = TensorProto::FLOAT);
+vector<TIndex> TensorDims(const TensorProto& shape);
+TIndex TensorCount(const TensorProto& shape, int start = 0, int end = INT_MAX);
+int TensorAxis(const TensorProto& shape, int axis);
+
+template <typename T>
+T GetArgument(const OperatorDef& def, const string& name, const T& default_value);
+
+template <typename T>
+vector<T> GetArguments(const OperatorDef& def, const string& name);
+
+//  the arguments given by tensors can not be inferred statically
+bool HasDescArgument(const OperatorDef& def);
+
+//  the shape functions reject the invalid shapes of inputs by it
+vector<TensorProto> InvalidShape(const OperatorDef& def, const string& message);
+
 class OpSchemaRegistry {
  public:
     static OpSchema& NewSchema(const string& op_type, const string& file, const int line) {
@@ -0,0 +1,84 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// ------------------------------------------------------------
+
+#ifndef DRAGON_CORE_PROFILER_H_
+#define DRAGON_CORE_PROFILER_H_
+
+#include <atomic>
+
+#include "core/common.h"
+#include "core/operator.h"
+
+namespace dragon {
+
+/**************************************************************************
+ *  Profiler records the running of operators.
+ *  It is enabled globally by Enable(), or for a graph by the argument
+    "profile", and the events are collected from all threads.
+ *  Events can be aggregated by the type of operators,
+    or exported as the JSON of chrome://tracing.
+ *************************************************************************/
+
+class Profiler {
+ public:
+    struct Event {
+        string name, type;
+        string inputs, outputs;     //  the shapes, e.g. "(1,3,224,224)"
+        int tid;
+        int64_t start_us, dur_us;
+        int64_t bytes;              //  the host memory allocated
+    };
+
+    struct Stats {
+        string type;
+        int64_t calls = 0;
+        int64_t total_us = 0, min_us = 0, max_us = 0;
+        int64_t bytes = 0;
+    };
+
+    static Profiler* Get();
+
+    inline bool enabled() const { return enabled_; }
+    inline void Enable(bool enabled = true) { enabled_ = enabled; }
+
+    void Record(Event& event);
+    void Reset();
+
+    //  the stats sorted by the total time in descending order
+    vector<Stats> Aggregate();
+    string Summary();
+    bool ExportChromeTrace(const string& filename);
+
+    static int64_t NowUs();
+    static int ThreadId();
+
+ private:
+    Profiler() : enabled_(false) {}
+
+    std::atomic<bool> enabled_;
+    vector<Event> events_;
+    std::mutex mutex_;
+};
+
+//  record an operator from the construction to the destruction
+class ProfileScope {
+ public:
+    ProfileScope(OperatorBase* op, bool enabled);
+    ~ProfileScope();
+
+ private:
+    OperatorBase* op_;
+    Profiler::Event event_;
+};
+
+}    // namespace dragon
+
+#endif    // DRAGON_CORE_PROFILER_H_
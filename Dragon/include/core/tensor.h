@@ -208,6 +208,19 @@ class Tensor {
         own_mem_ = false;
     }
 
+    //  bind a prepared memory, e.g. a slice of the planned arena
+    inline void SetMemory(const shared_ptr<MixedMemory>& mem) {
+        CHECK(own_mem_) << "\nTensor(" << name_ << ") holds an external memory.";
+        memory_ = mem;
+        capacity_ = mem->nbytes();
+    }
+
+    //  share the owned memory, to keep it alive outside the tensor
+    inline const shared_ptr<MixedMemory>& shared_memory() const { return memory_; }
+
+    inline bool own_mem() const { return own_mem_; }
+    inline TIndex capacity() const { return capacity_; }
+
     inline void Reset() {
         size_ = capacity_ = 0;
         meta_ = TypeMeta();
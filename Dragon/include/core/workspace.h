@@ -12,7 +12,11 @@
 #ifndef DRAGON_CORE_WORKSPACE_H_
 #define DRAGON_CORE_WORKSPACE_H_
 
+#include <atomic>
+#include <functional>
+
 #include "core/common.h"
+#include "core/allocator.h"
 #include "core/graph.h"
 #include "utils/string.h"
 
@@ -32,6 +36,8 @@ class Workspace {
     typedef Map<string, TensorFiller> FillerMap;
     typedef Map<string, string> RenameMap;
     typedef Map<string, string> AvatarMap;
+    typedef std::function<void(const string&, bool)> TensorHook;
+    typedef Map<string, TensorHook> HookMap;
 
     Workspace(const string& name) : name_(name) { Init(); }
     ~Workspace();
@@ -54,6 +60,7 @@ class Workspace {
     }
 
     inline void ClearWorkspace() {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
         //  clear the relationship of avatars
         avatar_map_.clear();
         //  clear the buffers
@@ -66,12 +73,14 @@ class Workspace {
     /******************** Tensor ********************/
 
     inline string GetTensorName(const string& name) {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
         if (rename_map_.count(name) > 0) {
             return rename_map_[name];
         } else { return name; }
     }
 
     bool HasTensor(const string& name, bool use_remote=true) {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
         //  search local workspace
         string query = GetTensorName(name);
         bool result = tensor_map_.count(query) > 0;
@@ -84,6 +93,7 @@ class Workspace {
     }
 
     inline Tensor* CreateTensor(const string& name) {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
         string query = GetTensorName(name);
         if (!HasTensor(query))
             tensor_map_[query] = unique_ptr<Tensor>(new Tensor(query));
@@ -91,6 +101,7 @@ class Workspace {
     }
 
     Tensor* GetTensor(const string& name, bool use_remote=true) {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
         string query = GetTensorName(name);
         //  search local workspace
         if (tensor_map_.count(query) > 0) 
@@ -108,20 +119,31 @@ class Workspace {
     }
 
     inline void LockTensor(const string& name) {
-        string query = GetTensorName(name);
-        if (!lock_map_.count(query))
-            lock_map_[query] = unique_ptr<mutex>(new mutex);
-        lock_map_[query]->lock();
+        mutex* tensor_mutex;
+        {
+            std::lock_guard<std::recursive_mutex> guard(mutex_);
+            string query = GetTensorName(name);
+            if (!lock_map_.count(query))
+                lock_map_[query] = unique_ptr<mutex>(new mutex);
+            tensor_mutex = lock_map_[query].get();
+        }
+        tensor_mutex->lock();
     }
 
     inline void UnlockTensor(const string& name) {
-        string query = GetTensorName(name);
-        if (!lock_map_.count(query))
-            lock_map_[query] = unique_ptr<mutex>(new mutex);
-        lock_map_[query]->unlock();
+        mutex* tensor_mutex;
+        {
+            std::lock_guard<std::recursive_mutex> guard(mutex_);
+            string query = GetTensorName(name);
+            if (!lock_map_.count(query))
+                lock_map_[query] = unique_ptr<mutex>(new mutex);
+            tensor_mutex = lock_map_[query].get();
+        }
+        tensor_mutex->unlock();
     }
 
     inline void ReleaseTensor(const string& name) {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
         CHECK(HasTensor(name, false)) 
             << "\nTensor(" << name << ") does not "
             << "belong to current workspace, could not release it.";
@@ -130,6 +152,7 @@ class Workspace {
     }
 
     vector<string> GetTensors() {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
         vector<string> names;
         //  search local workspace
         for (auto& it : tensor_map_) 
@@ -163,6 +186,7 @@ class Workspace {
     }
 
     inline const TensorFiller* GetFiller(const string& name) {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
         //  search local workspace
         if (filler_map_.count(name) > 0) 
             return &filler_map_[name];
@@ -178,6 +202,7 @@ class Workspace {
     /******************** Avatar ********************/
 
     inline void CreateAvatar(Tensor* orig, Tensor* avatar) {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
         CHECK(tensor_map_.count(orig->name()) > 0)
             << "\nFailed to create avatar for Tensor(" << orig->name() << ")."
             << "\nAs it has not been registered in the current workspace.";
@@ -185,6 +210,7 @@ class Workspace {
     }
 
     inline Tensor* SearchAvatar(Tensor* orig) {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
         if (avatar_map_.count(orig->name()) > 0)
             return GetTensor(avatar_map_[orig->name()]);
         return orig;
@@ -193,43 +219,47 @@ class Workspace {
     /******************** Buffer ********************/
 
     void CreateBuffer(string category, int num) {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
         if (!buffer_map_.count(category))
             buffer_map_[category] = stack<string>();
         for (int i = 1; i <= num; i++) {
-            string name = "/share/buffer/" + category + "_" + dragon_cast<string, int>(i);
+            int idx = ++buffer_limits_[category];
+            string name = "/share/buffer/" + category + "_" + dragon_cast<string, int>(idx);
             buffer_map_[category].push(name);
             CreateTensor(name);
         }
     }
 
     inline Tensor* GetBuffer(string category = "Common") {
-        if (!buffer_map_[category].empty()) {
-            string name = buffer_map_[category].top();
-            buffer_map_[category].pop();
-            return tensor_map_[name].get();
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        if (buffer_map_[category].empty()) {
+            //  operators running concurrently may exhaust the preset buffers,
+            //  grow the category instead of failing
+            LOG(DEBUG) << "Buffers of [" << category << "] are not enough, "
+                       << "grow to " << buffer_limits_[category] + 1 << ".";
+            CreateBuffer(category, 1);
         }
-        LOG(FATAL) << "Buffers of [" << category << "] "
-                   << "are not enough, add more if necessary.";
-        return nullptr;
+        string name = buffer_map_[category].top();
+        buffer_map_[category].pop();
+        return tensor_map_[name].get();
     }
 
     void ResetBuffer(string category, int num) {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
         while (!buffer_map_[category].empty()) {
             string name = buffer_map_[category].top();
             buffer_map_[category].pop();
             tensor_map_[name]->Reset();
         }
+        buffer_limits_[category] = 0;
         CreateBuffer(category, num);
     }
 
     void ReleaseBuffer(Tensor* tensor, 
                        string category = "Common",
                        bool enforce = false) {
-        static Map<string, int> limits = {
-                { "Common", WORKSPACE_COMMON_BUFFER_SIZE },
-                { "Grad", WORKSPACE_GRAD_BUFFER_SIZE }
-        };
-        if (buffer_map_[category].size() >= limits[category] || enforce) {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        if (buffer_map_[category].size() >= buffer_limits_[category] || enforce) {
             ReleaseTensor(tensor->name());
             if (buffer_map_[category].empty())
                 buffer_map_[category].push(tensor->name());
@@ -238,6 +268,23 @@ class Workspace {
         }
     }
 
+    /******************** Memory ********************/
+
+    //  drop the idle buffers and return the cached host memory to the system
+    void TrimMemory() {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        for (auto& kv : buffer_map_) {
+            stack<string> idle = kv.second;
+            while (!idle.empty()) {
+                tensor_map_[idle.top()]->Reset();
+                idle.pop();
+            }
+        }
+        CPUAllocator::Trim();
+    }
+
+    inline CPUAllocator::Stats GetMemoryStats() { return CPUAllocator::GetStats(); }
+
     /******************** Graph ********************/
 
     GraphBase* CreateGraph(const GraphDef& meta_graph);
@@ -258,10 +305,47 @@ class Workspace {
         return names;
     }
 
+    /******************** Hook ********************/
+
+    //  the graphs call the hook of a tensor with (name, false)
+    //  before any of its writers, and with (name, true) after the last one,
+    //  e.g. the collectives start as soon as the gradients are produced,
+    //  the hooks are keyed by the name of tensor, i.e. Tensor::name()
+    inline void SetTensorHook(const string& name, const TensorHook& hook) {
+        std::lock_guard<std::mutex> guard(hook_mutex_);
+        hook_map_[name] = hook;
+        hook_version_++;
+    }
+
+    inline void ClearTensorHook(const string& name) {
+        std::lock_guard<std::mutex> guard(hook_mutex_);
+        hook_map_.erase(name);
+        hook_version_++;
+    }
+
+    inline bool HasTensorHook(const string& name) {
+        std::lock_guard<std::mutex> guard(hook_mutex_);
+        return hook_map_.count(name) > 0;
+    }
+
+    inline void RunTensorHook(const string& name, bool ready) {
+        TensorHook hook;
+        {
+            std::lock_guard<std::mutex> guard(hook_mutex_);
+            auto it = hook_map_.find(name);
+            if (it == hook_map_.end()) return;
+            hook = it->second;
+        }
+        hook(name, ready);
+    }
+
+    inline int hook_version() const { return hook_version_; }
+
     /******************** Utility ********************/
 
     inline void CreateRename(const string& old_tensor,
                              const string& new_tensor) {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
         rename_map_[old_tensor] = new_tensor;
     }
 
@@ -271,10 +355,16 @@ class Workspace {
     TensorMap tensor_map_;
     BufferMap buffer_map_;
     LockMap lock_map_;
+    //  declared before the graphs, whose operators clear their hooks
+    HookMap hook_map_;
+    std::mutex hook_mutex_;
+    std::atomic<int> hook_version_{0};
     GraphMap graph_map_;
     FillerMap filler_map_;
     RenameMap rename_map_;
     AvatarMap avatar_map_;
+    Map<string, int> buffer_limits_;
+    std::recursive_mutex mutex_;
 };
 
 }    // namespace dragon
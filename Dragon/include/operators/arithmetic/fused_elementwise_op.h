@@ -0,0 +1,84 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// ------------------------------------------------------------
+
+#ifndef DRAGON_OPERATORS_ARITHMETIC_FUSED_ELEMENTWISE_OP_H_
+#define DRAGON_OPERATORS_ARITHMETIC_FUSED_ELEMENTWISE_OP_H_
+
+#include "core/operator.h"
+#include "utils/op_kernel.h"
+
+namespace dragon {
+
+/**************************************************************************
+ *  FusedElementwise evaluates an expression of elementwise operators
+    in one pass over the output, instead of writing each intermediate.
+ *  "ops"      : the types of operators, e.g. Mul, Add, Sigmoid.
+ *  "operands" : the (a, b) of each operator, b is -1 for the unary ones.
+                 index < num_inputs refers to Input(index), otherwise
+                 the result of the (index - num_inputs)-th operator.
+ *  "params"   : the 3 float arguments of each operator,
+                 i.e. slope | alpha | (power, scale, shift) | (low, high).
+ *  The output is the result of the last operator.
+ *  The broadcasting follows Add, Sub, Mul and Div, i.e. the shape is
+    given by the first operand. It is inserted by the elementwise fusion
+    of Graph.
+ *************************************************************************/
+
+template <class Context>
+class FusedElementwiseOpBase : public Operator<Context> {
+ public:
+    FusedElementwiseOpBase(const OperatorDef& op_def, Workspace* ws)
+        : Operator<Context>(op_def, ws),
+          ops(OperatorBase::GetRepeatedArg<string>("ops")),
+          operands(OperatorBase::GetRepeatedArg<int>("operands")),
+          params(OperatorBase::GetRepeatedArg<float>("params")) {}
+    USE_OPERATOR_FUNCTIONS(Context);
+
+    //  make the program by the shapes of the first "num_inputs" inputs
+    void Compile(const int num_inputs);
+
+ protected:
+    vector<string> ops;
+    vector<int> operands;
+    vector<float> params;
+    kernel::FusedProgram program;
+    vector<TIndex> output_dims;
+};
+
+template <class Context>
+class FusedElementwiseOp final : public FusedElementwiseOpBase<Context> {
+ public:
+    FusedElementwiseOp(const OperatorDef& op_def, Workspace* ws)
+        : FusedElementwiseOpBase<Context>(op_def, ws) {}
+    USE_OPERATOR_FUNCTIONS(Context);
+
+    void RunOnDevice() override;
+    template <typename T> void RunWithType();
+};
+
+template <class Context>
+class FusedElementwiseGradientOp final : public FusedElementwiseOpBase<Context> {
+ public:
+    FusedElementwiseGradientOp(const OperatorDef& op_def, Workspace* ws)
+        : FusedElementwiseOpBase<Context>(op_def, ws) {}
+    USE_OPERATOR_FUNCTIONS(Context);
+
+    void RunOnDevice() override;
+    void ShareGradient() override;
+    template <typename T> void RunWithType();
+
+ protected:
+    Tensor* bcast_multiplier;
+};
+
+}    // namespace dragon
+
+#endif    // DRAGON_OPERATORS_ARITHMETIC_FUSED_ELEMENTWISE_OP_H_
@@ -23,7 +23,9 @@ class InnerProductOp: public Operator<Context> {
         : Operator<Context>(op_def, ws),
           axis(OperatorBase::GetSingleArg<int>("axis", 1)),
           num_output(OperatorBase::GetSingleArg<int>("num_output", 0)),
-          transW(OperatorBase::GetSingleArg<bool>("TransW", true)) {}
+          transW(OperatorBase::GetSingleArg<bool>("TransW", true)),
+          activation(OperatorBase::GetSingleArg<string>("activation", "")),
+          slope(OperatorBase::GetSingleArg<float>("slope", 0.0)) {}
     USE_OPERATOR_FUNCTIONS(Context);
 
     void RunOnDevice();
@@ -33,6 +35,9 @@ class InnerProductOp: public Operator<Context> {
  protected:
     TIndex axis, num_output, M, K;
     bool transW;
+    //  the activation fused by the inference optimization
+    string activation;
+    float slope;
     Tensor* bias_multiplier;
 };
 
@@ -0,0 +1,61 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// -------------------------------------------------------------
+
+#ifndef DRAGON_OPERATORS_MISC_DATA_LOADER_OP_H_
+#define DRAGON_OPERATORS_MISC_DATA_LOADER_OP_H_
+
+#include "core/operator.h"
+#include "utils/data_loader.h"
+
+namespace dragon {
+
+template <class Context>
+class DataLoaderOp final : public Operator<Context> {
+ public:
+    DataLoaderOp(const OperatorDef& op_def, Workspace* ws)
+        : Operator<Context>(op_def, ws) {
+        param.source = OperatorBase::GetSingleArg<string>("source", "");
+        param.shuffle = OperatorBase::GetSingleArg<bool>("shuffle", false);
+        param.node_step = OperatorBase::GetSingleArg<bool>("node_step", false);
+        param.num_chunks = OperatorBase::GetSingleArg<int>("num_chunks", 2048);
+        param.chunk_size = OperatorBase::GetSingleArg<int>("chunk_size", -1);
+        param.node_rank = OperatorBase::GetSingleArg<int>("node_rank", 0);
+        param.node_size = OperatorBase::GetSingleArg<int>("node_size", 1);
+        param.mean_values = OperatorBase::GetRepeatedArg<float>("mean_values");
+        param.scale = OperatorBase::GetSingleArg<float>("scale", 1.f);
+        param.padding = OperatorBase::GetSingleArg<int>("padding", 0);
+        param.fill_value = OperatorBase::GetSingleArg<int>("fill_value", 127);
+        param.crop_size = OperatorBase::GetSingleArg<int>("crop_size", 0);
+        param.mirror = OperatorBase::GetSingleArg<bool>("mirror", false);
+        param.force_color = OperatorBase::GetSingleArg<bool>("force_color", false);
+        param.is_train = OperatorBase::GetSingleArg<string>("phase", "TRAIN") == "TRAIN";
+        param.num_readers = OperatorBase::GetSingleArg<int>("num_readers", 1);
+        param.num_transformers = OperatorBase::GetSingleArg<int>("num_transformers", 2);
+        param.batch_size = OperatorBase::GetSingleArg<int>("batch_size", 100);
+        param.prefetch = OperatorBase::GetSingleArg<int>("prefetch", 5);
+        param.random_seed = op_def.device_option().random_seed();
+        CHECK(!param.source.empty()) << "\nThe source of database should be given.";
+        CHECK_GT(param.batch_size, 0);
+        CHECK_GT(param.num_readers, 0);
+        CHECK_GT(param.num_transformers, 0);
+    }
+    USE_OPERATOR_FUNCTIONS(Context);
+
+    void RunOnDevice() override;
+
+ protected:
+    DataLoaderParam param;
+    unique_ptr<DataLoader> loader;
+};
+
+}    // namespace dragon
+
+#endif    // DRAGON_OPERATORS_MISC_DATA_LOADER_OP_H_
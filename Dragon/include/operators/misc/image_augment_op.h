@@ -0,0 +1,69 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// -------------------------------------------------------------
+
+#ifndef DRAGON_OPERATORS_MISC_IMAGE_AUGMENT_OP_H_
+#define DRAGON_OPERATORS_MISC_IMAGE_AUGMENT_OP_H_
+
+#include <random>
+
+#include "core/operator.h"
+
+namespace dragon {
+
+/**************************************************************************
+ *  Augment a batch of NHWC images in one pass on the host:
+ *  random resize (bilinear) -> crop -> mirror -> pad -> (x - mean) / std,
+    written into NCHW or NHWC floats.
+ *  The TEST phase of the graph takes the center crop,
+    without resizing or mirroring.
+ *************************************************************************/
+
+template <class Context>
+class ImageAugmentOp final : public Operator<Context> {
+ public:
+    ImageAugmentOp(const OperatorDef& op_def, Workspace* ws)
+        : Operator<Context>(op_def, ws),
+          crop_size(OperatorBase::GetSingleArg<int>("crop_size", 0)),
+          padding(OperatorBase::GetSingleArg<int>("padding", 0)),
+          fill_value(OperatorBase::GetSingleArg<float>("fill_value", 127.f)),
+          mirror(OperatorBase::GetSingleArg<bool>("mirror", false)),
+          min_scale(OperatorBase::GetSingleArg<float>("min_random_scale", 1.f)),
+          max_scale(OperatorBase::GetSingleArg<float>("max_random_scale", 1.f)),
+          mean_values(OperatorBase::GetRepeatedArg<float>("mean_values")),
+          std_values(OperatorBase::GetRepeatedArg<float>("std_values")),
+          data_format(OperatorBase::GetSingleArg<string>("data_format", "NCHW")),
+          rng(op_def.device_option().random_seed()) {
+        CHECK(min_scale > 0 && min_scale <= max_scale)
+            << "\nInvalid random scale: [" << min_scale << ", " << max_scale << "].";
+        if (min_scale != 1.f || max_scale != 1.f)
+            CHECK_GT(crop_size, 0) << "\nThe crop size is required for the random scale.";
+        for (auto v : std_values) CHECK_NE(v, 0.f) << "\nThe std values should be non-zero.";
+    }
+    USE_OPERATOR_FUNCTIONS(Context);
+
+    void RunOnDevice() override;
+    template <typename Tx> void RunWithType();
+
+ protected:
+    int crop_size, padding;
+    float fill_value;
+    bool mirror;
+    float min_scale, max_scale;
+    vector<float> mean_values, std_values;
+    string data_format;
+    TIndex n, c, h, w, crop_h, crop_w;
+    vector<int> params;
+    std::mt19937 rng;
+};
+
+}    // namespace dragon
+
+#endif    // DRAGON_OPERATORS_MISC_IMAGE_AUGMENT_OP_H_
@@ -20,6 +20,16 @@
 
 namespace dragon {
 
+//  hold the GIL in a scope, the graphs may run without it
+class ScopedGILAcquire {
+ public:
+    ScopedGILAcquire() : state(PyGILState_Ensure()) {}
+    ~ScopedGILAcquire() { PyGILState_Release(state); }
+
+ private:
+    PyGILState_STATE state;
+};
+
 template <class Context>
 class RunOp : public Operator<Context> {
  public:
@@ -0,0 +1,56 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// -------------------------------------------------------------
+
+#ifndef DRAGON_OPERATORS_NORM_FOLD_AFFINE_OP_H_
+#define DRAGON_OPERATORS_NORM_FOLD_AFFINE_OP_H_
+
+#include "core/operator.h"
+
+namespace dragon {
+
+/**************************************************************************
+ *  FoldAffine computes the weights and bias of a layer (Conv2d, etc.),
+    which has absorbed the following per-channel affine stages:
+ *  "norm"       : (x - mean) / sqrt(var + eps)          inputs: mean, var
+ *  "norm_caffe" : as "norm", the stats are divided by the factor
+                                                 inputs: mean, var, factor
+ *  "scale"      : x * gamma                             inputs: gamma
+ *  "scale_bias" : x * gamma + beta                      inputs: gamma, beta
+ *  Inputs: W, [B], the inputs of each stage in order.
+ *  Outputs: W', B', where "axis" is the output channel axis of W.
+ *  It is inserted by the inference optimization of Graph.
+ *************************************************************************/
+
+template <class Context>
+class FoldAffineOp final : public Operator<Context> {
+ public:
+    FoldAffineOp(const OperatorDef& op_def, Workspace* ws)
+        : Operator<Context>(op_def, ws),
+          axis(OperatorBase::GetSingleArg<int>("axis", 0)),
+          has_bias(OperatorBase::GetSingleArg<bool>("has_bias", false)),
+          stages(OperatorBase::GetRepeatedArg<string>("stages")),
+          eps(OperatorBase::GetRepeatedArg<float>("eps")) {}
+    USE_OPERATOR_FUNCTIONS(Context);
+
+    void RunOnDevice() override;
+    template <typename T> void RunWithType();
+
+ protected:
+    TIndex axis, C;
+    bool has_bias;
+    vector<string> stages;
+    vector<float> eps;
+    Tensor alpha;
+};
+
+}    // namespace dragon
+
+#endif    // DRAGON_OPERATORS_NORM_FOLD_AFFINE_OP_H_
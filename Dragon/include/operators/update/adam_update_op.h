@@ -28,12 +28,13 @@ class AdamUpdateOp final : public UpdateOpBase<Context> {
     USE_OPERATOR_FUNCTIONS(Context);
     USE_UPDATER_FUNCTIONS(Context);
 
-    void ComputeRunWithFloat() override;
+    void SetupRunWithFloat() override;
+    void ComputeRunWithFloat(const int idx) override;
 
  protected:
     float lr, beta1, beta2, eps, coeff;
     int t;
-    Tensor* m, *v, *tmp;
+    Tensor* m, *v;
 };
 
 }    // namespace dragon
@@ -12,32 +12,103 @@
 #ifndef DRAGON_OPERATORS_UPDATE_COLLECTIVE_UPDATE_OP_H_
 #define DRAGON_OPERATORS_UPDATE_COLLECTIVE_UPDATE_OP_H_
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "core/operator.h"
 
 namespace dragon {
 
 #ifdef WITH_MPI
 
+/**************************************************************************
+ *  The gradients of MPI_ALLREDUCE are packed into the buckets of at most
+    "bucket_size" bytes, in the reversed order of inputs, which is roughly
+    the order of backward. Each bucket is reduced by one ring allreduce.
+ *  With "overlap", a bucket is reduced by a communication thread as soon
+    as all of its gradients are produced, the graphs computing them fire
+    the tensor hooks of workspace. This operator waits for the buckets,
+    and reduces the ones not fired, e.g. the first iteration.
+ *  A gradient written again before the update (i.e. the accumulation)
+    waits for its bucket, and fires it again. The average is linear,
+    thus reducing the partial sums is still exact.
+ *************************************************************************/
+
+/**************************************************************************
+ *  MIXED_ALLREDUCE is hierarchical: the gradients are reduced to the
+    leader of each node, the leaders run the ring allreduce, and then
+    broadcast the sums back in their nodes.
+ *  The nodes are split from "comm" by the shared memory, thus the
+    traffic across the nodes is divided by the ranks per node.
+ *************************************************************************/
+
+/**************************************************************************
+ *  The "compression" of the ring allreduce:
+ *  FP16 sends the halves, which are decoded and accumulated in fp32.
+    The gradients are averaged before casting, thus the sums of the
+    loss-scaled gradients will not overflow.
+ *  TOPK sends the "topk_ratio" of gradients with the largest magnitudes
+    as the (index, value) pairs, the others are accumulated into a local
+    residual, and sent in the later iterations (i.e. error feedback).
+ *************************************************************************/
+
 template <class Context>
 class CollectiveUpdateOp : public Operator<Context> {
  public:
     CollectiveUpdateOp(const OperatorDef& op_def, Workspace* ws)
         : Operator<Context>(op_def, ws),
-          mode(OperatorBase::GetSingleArg<string>("mode", "UNKNOWN")) {
+          mode(OperatorBase::GetSingleArg<string>("mode", "UNKNOWN")),
+          bucket_size(OperatorBase::GetSingleArg<int>("bucket_size", 0)),
+          overlap(OperatorBase::GetSingleArg<bool>("overlap", false)),
+          compression(OperatorBase::GetSingleArg<string>("compression", "NONE")),
+          topk_ratio(OperatorBase::GetSingleArg<float>("topk_ratio", 0.01f)),
+          comm_stop(false) {
          InitMPI();
          if (mode.find("NCCL") != string::npos) InitNCCL();
+         CHECK(compression == "NONE" || compression == "FP16" || compression == "TOPK")
+             << "\nUnknown compression: " << compression;
+#ifdef WITH_MPI_CUDA
+         CHECK(compression == "NONE" ||
+               TypeMeta::Id<Context>() == TypeMeta::Id<CPUContext>())
+             << "\nThe compression requires the gradients on the host.";
+#endif
+         //  the buckets are packed on the host
+         //  and the top-k is selected from each gradient
+         use_buckets = (mode == "MPI_ALLREDUCE" || mode == "MIXED_ALLREDUCE") &&
+             bucket_size > 0 && compression != "TOPK" &&
+             TypeMeta::Id<Context>() == TypeMeta::Id<CPUContext>();
+         if (use_buckets) InitBuckets();
+         else if (mode == "MIXED_ALLREDUCE") InitMixed(comm);
     }
+    ~CollectiveUpdateOp();
     USE_OPERATOR_FUNCTIONS(Context);
 
     void InitMPI();
     void InitNCCL();
+    void InitBuckets();
+    void InitMixed(MPI_Comm base_comm);
 
     void RunOnDevice() override;
+    void AllReduce(const TIndex count, MPI_Comm comm, float* x, float* buffer);
+    void RingAllReduce(const TIndex count, MPI_Comm comm, float* x, float* buffer);
+    void MPIAllReduce(const TIndex count, MPI_Comm comm, float* x, float* buffer);
+    void MPIAllReduceHalf(const TIndex count, MPI_Comm comm, float* x);
+    void TopKAllReduce(const int idx, float* buffer);
+    void MixedAllReduce(const TIndex count, float* x, float* buffer);
     void MPIAllReduceWithFloat();
     void NCCLAllReduceWithFloat();
     void MPIBcastWithFloat();
     void NCCLBcastWithFloat();
 
+    void MakeBuckets();
+    void BucketAllReduceWithFloat();
+    void ReduceBucket(const int idx);
+    void GradientHook(const int idx, bool ready);
+    void EnqueueBucket(const int idx);
+    void CommunicationLoop();
+
  protected:
     int comm_size, comm_rank, comm_root;
     int world_size, world_rank;
@@ -47,6 +118,32 @@ class CollectiveUpdateOp : public Operator<Context> {
     MPI_Comm comm;
     MPI_Group group;
 
+    //  mixed: the ranks of a node, and the leaders of nodes
+    MPI_Comm local_comm, cross_comm;
+    int local_rank, local_size, ring_size;
+
+    //  compression
+    string compression;
+    float topk_ratio;
+    Tensor* half_buffer;
+    vector<float> topk_scratch;
+
+    //  buckets: the inputs, the packed buffers and the states,
+    //  which are guarded by comm_mutex
+    int bucket_size;
+    bool use_buckets, overlap;
+    MPI_Comm bucket_comm;
+    vector<vector<int> > buckets;
+    vector<int> bucket_of, num_ready, num_pending;
+    vector<bool> input_ready, reduced;
+    vector<Tensor*> bucket_buffers;
+    vector<string> hooked_tensors;
+    std::deque<int> comm_queue;
+    std::mutex comm_mutex;
+    std::condition_variable comm_cond;
+    std::thread comm_thread;
+    bool comm_stop;
+
 #ifdef WITH_MPI_NCCL
     ncclComm_t nccl_comm;
     cudaStream_t stream;
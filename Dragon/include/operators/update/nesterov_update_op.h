@@ -25,11 +25,12 @@ class NesterovUpdateOp final : public UpdateOpBase<Context> {
     USE_OPERATOR_FUNCTIONS(Context);
     USE_UPDATER_FUNCTIONS(Context);
 
-    void ComputeRunWithFloat() override;
+    void SetupRunWithFloat() override;
+    void ComputeRunWithFloat(const int idx) override;
 
  protected:
     float lr, momentum;
-    Tensor* h, *tmp;
+    Tensor* h;
 };
 
 }    // namespace dragon
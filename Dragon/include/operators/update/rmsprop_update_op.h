@@ -26,11 +26,12 @@ class RMSPropUpdateOp final : public UpdateOpBase<Context> {
     USE_OPERATOR_FUNCTIONS(Context);
     USE_UPDATER_FUNCTIONS(Context);
 
-    void ComputeRunWithFloat() override;
+    void SetupRunWithFloat() override;
+    void ComputeRunWithFloat(const int idx) override;
 
  protected:
     float lr, decay, eps;
-    Tensor* h, *tmp;
+    Tensor* h;
 };
 
 }    // namespace dragon
@@ -25,7 +25,8 @@ class SGDUpdateOp final : public UpdateOpBase<Context> {
     USE_OPERATOR_FUNCTIONS(Context);
     USE_UPDATER_FUNCTIONS(Context);
 
-    void ComputeRunWithFloat() override;
+    void SetupRunWithFloat() override;
+    void ComputeRunWithFloat(const int idx) override;
 
  protected:    
     float lr, momentum;
@@ -0,0 +1,52 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// -------------------------------------------------------------
+
+#ifndef DRAGON_OPERATORS_UPDATE_SHM_COLLECTIVE_UPDATE_OP_H_
+#define DRAGON_OPERATORS_UPDATE_SHM_COLLECTIVE_UPDATE_OP_H_
+
+#include "core/operator.h"
+#include "utils/shm_comm.h"
+
+namespace dragon {
+
+#ifdef WITH_SHM
+
+//  the slots are sized by the gradients, up to 16MB per rank
+#define SHM_MAX_SLOT_COUNT (4 * 1024 * 1024)
+
+template <class Context>
+class SHMCollectiveUpdateOp : public Operator<Context> {
+ public:
+    SHMCollectiveUpdateOp(const OperatorDef& op_def, Workspace* ws)
+        : Operator<Context>(op_def, ws),
+          mode(OperatorBase::GetSingleArg<string>("mode", "UNKNOWN")),
+          key(OperatorBase::GetSingleArg<string>("shm_key", "")),
+          comm_rank(OperatorBase::GetSingleArg<int>("shm_rank", 0)),
+          comm_size(OperatorBase::GetSingleArg<int>("shm_size", 1)),
+          comm_root(OperatorBase::GetSingleArg<int>("root", 0)) {
+        CHECK(!key.empty()) << "\nSHM was not initialized.";
+    }
+    USE_OPERATOR_FUNCTIONS(Context);
+
+    void RunOnDevice() override;
+    void InitSHM();
+
+ protected:
+    string mode, key;
+    int comm_rank, comm_size, comm_root;
+    unique_ptr<SHMComm> comm;
+};
+
+#endif    // WITH_SHM
+
+}    // namespace dragon
+
+#endif    // DRAGON_OPERATORS_UPDATE_SHM_COLLECTIVE_UPDATE_OP_H_
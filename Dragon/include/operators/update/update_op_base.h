@@ -21,28 +21,41 @@ class UpdateOpBase : public Operator<Context> {
  public:
     UpdateOpBase(const OperatorDef& op_def, Workspace* ws) 
         : Operator<Context>(op_def, ws),
-          lr_mult(OperatorBase::GetSingleArg<float>("lr_mult", 1.0)),
-          decay_mult(OperatorBase::GetSingleArg<float>("decay_mult", 1.0)),
-          domain(OperatorBase::GetSingleArg<string>("domain", "_")) {}
+          lr_mults(OperatorBase::GetRepeatedArg<float>("lr_mults")),
+          decay_mults(OperatorBase::GetRepeatedArg<float>("decay_mults")),
+          slots(OperatorBase::GetRepeatedArg<string>("slots")),
+          domain(OperatorBase::GetSingleArg<string>("domain", "_")) {
+        //  a single tensor takes the scalar arguments,
+        //  the multi-tensor apply gives one for each tensor
+        lr_mults.resize(InputSize(), OperatorBase::GetSingleArg<float>("lr_mult", 1.0));
+        decay_mults.resize(InputSize(), OperatorBase::GetSingleArg<float>("decay_mult", 1.0));
+        slots.resize(InputSize(), OperatorBase::GetSingleArg<string>("slot", ""));
+    }
     USE_OPERATOR_FUNCTIONS(Context);
 
     float Param(const string& name) const;
-    string Slot();
+    string Slot(const int idx);
 
     void RunOnDevice() override;
-    template <typename T> void PreprocessRunWithType();
-    virtual void ComputeRunWithFloat() = 0;
-    template <typename T> void UpdateRunWithType();
+    template <typename T> void PreprocessRunWithType(const int idx);
+    virtual void SetupRunWithFloat() {}
+    virtual void ComputeRunWithFloat(const int idx) = 0;
 
  protected:
-    float lr_mult, decay_mult;
+    vector<float> lr_mults, decay_mults;
+    vector<string> slots;
     float l2_decay, clip_thresh, scale_factor;
+    //  g = grad_scale * dx + grad_decay * x, folded into the kernels
+    float grad_scale, grad_decay;
     string domain;
 };
 
 #define USE_UPDATER_FUNCTIONS(context) \
     using UpdateOpBase<context>::Param; \
-    using UpdateOpBase<context>::Slot
+    using UpdateOpBase<context>::Slot; \
+    using UpdateOpBase<context>::lr_mults; \
+    using UpdateOpBase<context>::grad_scale; \
+    using UpdateOpBase<context>::grad_decay
 
 }    // namespace dragon 
 
@@ -20,7 +20,9 @@ template <class Context>
 class Conv2dOp : public ConvOpBase<Context> {
  public:
     Conv2dOp(const OperatorDef& def, Workspace* ws)
-        : ConvOpBase<Context>(def, ws) { 
+        : ConvOpBase<Context>(def, ws),
+          activation(OperatorBase::GetSingleArg<string>("activation", "")),
+          slope(OperatorBase::GetSingleArg<float>("slope", 0.0)) {
         this->num_spatial_axes = 2;
         Setup();
     }
@@ -32,6 +34,11 @@ class Conv2dOp : public ConvOpBase<Context> {
 
     void RunOnDevice() override;
     template <typename T> void RunWithType();
+
+ protected:
+    //  the activation fused by the inference optimization
+    string activation;
+    float slope;
 };
 
 template <class Context>
@@ -97,6 +97,12 @@ class ConvOpBase : public Operator<Context> {
 
 DEFINE_ARGUMENTS_WITH_DESC(int, ConvOpBase, output_dims);
 
+//  infer the output shape of Conv2d and Conv2dTranspose from the input,
+//  the weights and bias are not required
+vector<TensorProto> ConvShapeInference(const OperatorDef& def,
+                                       const vector<TensorProto>& inputs,
+                                       bool transposed);
+
 #define USE_CONVOLUTION_FUNCTIONS(context) \
     using ConvOpBase<context>::Setup; \
     using ConvOpBase<context>::Reshape; \
@@ -46,7 +46,11 @@ inline bool ReadProtoFromBinaryFile(const char* filename, Message* proto) {
 #endif
     ZeroCopyInputStream *raw_input = new FileInputStream(fd);
     CodedInputStream *coded_input = new CodedInputStream(raw_input);
+#if GOOGLE_PROTOBUF_VERSION >= 3006000
+    coded_input->SetTotalBytesLimit(INT_MAX);
+#else
     coded_input->SetTotalBytesLimit(INT_MAX, -1);
+#endif
     bool success = proto->ParseFromCodedStream(coded_input);
     delete raw_input;
     delete coded_input;
@@ -0,0 +1,83 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// ------------------------------------------------------------
+
+#ifndef DRAGON_UTILS_CHECKPOINT_H_
+#define DRAGON_UTILS_CHECKPOINT_H_
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include "core/workspace.h"
+
+namespace dragon {
+
+/**************************************************************************
+ *  The binary checkpoint, which is mapped into memory to load:
+ *  "DRAGONCK" | uint32 version | uint32 count | uint64 header bytes
+ *  { uint32 len | name | uint32 len | dtype | uint32 ndim | int64 dims
+ *    | uint64 offset | uint64 nbytes } x count
+ *  | the raw payloads (little-endian), at the 64-byte aligned offsets.
+ *  The loaded CPU tensors borrow the private mapping of the file,
+    so the pages are read lazily, and copied by the kernel if written.
+ *************************************************************************/
+
+#define CHECKPOINT_MAGIC "DRAGONCK"
+#define CHECKPOINT_VERSION 1
+#define CHECKPOINT_ALIGNMENT 64
+
+//  whether the file starts with the magic of checkpoint
+bool IsCheckpoint(const string& file);
+
+void SaveCheckpoint(const string& file, const vector<Tensor*>& tensors);
+
+//  the tensors missing in the workspace are created if "create_missing",
+//  otherwise they are skipped with a warning
+void LoadCheckpoint(const string& file, Workspace* ws, bool create_missing);
+
+//  flush the written "tmp_file" to the disk, then rename it as "file"
+void CommitFile(const string& tmp_file, const string& file);
+
+/**************************************************************************
+ *  The snapshot in background:
+ *  The tensors are copied on the host at once, then encoded and written
+    by a thread into "file.tmp", which is flushed and renamed as "file".
+ *  A crash during the writing never leaves a partial checkpoint,
+    and the training can continue after the copies.
+ *************************************************************************/
+
+class AsyncCheckpoint {
+ public:
+    typedef std::function<void(const string&,
+        const vector<Tensor*>&)> SaveFunction;
+
+    AsyncCheckpoint(const string& file,
+                    const vector<Tensor*>& tensors,
+                    SaveFunction save_func);
+    ~AsyncCheckpoint() { Wait(); }
+
+    //  block until the file is committed
+    void Wait();
+    bool done() const { return done_; }
+
+ private:
+    void Run();
+
+    string file_;
+    vector<unique_ptr<Tensor> > copies_;
+    SaveFunction save_func_;
+    std::atomic<bool> done_;
+    std::thread thread_;
+};
+
+}    // namespace dragon
+
+#endif    // DRAGON_UTILS_CHECKPOINT_H_
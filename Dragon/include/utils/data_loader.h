@@ -0,0 +1,161 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// ------------------------------------------------------------
+
+#ifndef DRAGON_UTILS_DATA_LOADER_H_
+#define DRAGON_UTILS_DATA_LOADER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <random>
+#include <thread>
+
+#include "core/common.h"
+#include "utils/db.h"
+
+namespace dragon {
+
+template <typename T>
+class BlockingQueue {
+ public:
+    explicit BlockingQueue(size_t capacity)
+        : capacity(std::max(capacity, (size_t)1)), closed(false) {}
+
+    //  return false if the queue was closed
+    bool Push(T&& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [this] { return closed || items.size() < capacity; });
+        if (closed) return false;
+        items.push_back(std::move(item));
+        not_empty.notify_one();
+        return true;
+    }
+
+    bool Pop(T* item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock, [this] { return closed || !items.empty(); });
+        if (closed) return false;
+        *item = std::move(items.front());
+        items.pop_front();
+        not_full.notify_one();
+        return true;
+    }
+
+    void Close() {
+        std::unique_lock<std::mutex> lock(mutex);
+        closed = true;
+        not_full.notify_all();
+        not_empty.notify_all();
+    }
+
+ private:
+    std::deque<T> items;
+    size_t capacity;
+    bool closed;
+    std::mutex mutex;
+    std::condition_variable not_full, not_empty;
+};
+
+struct DataLoaderParam {
+    //  the reader
+    string source;
+    bool shuffle = false, node_step = false;
+    int num_chunks = 2048, chunk_size = -1;
+    //  the partition of the parallel nodes
+    int node_rank = 0, node_size = 1;
+    //  the transformer
+    vector<float> mean_values;
+    float scale = 1.f;
+    int padding = 0, fill_value = 127, crop_size = 0;
+    bool mirror = false, force_color = false, is_train = true;
+    //  the pipeline
+    int num_readers = 1, num_transformers = 2;
+    int batch_size = 100, prefetch = 5;
+    unsigned int random_seed = 3;
+};
+
+//  a transformed image in CHW, with its labels
+struct DataSample {
+    vector<float> data;
+    vector<float> labels;
+    int channels = 0, height = 0, width = 0;
+};
+
+/**************************************************************************
+ *  The native pipeline of "dragon.io.DataBatch", in threads:
+ *  readers    --- serialized Datum ---> transformers --- DataSample ---> op
+ *  The readers partition and shuffle the chunks of records exactly as
+    "dragon.io.DataReader", and the transformers decode, crop, mirror,
+    pad and normalize the images as "dragon.io.DataTransformer".
+ *  The operator assembles the batches into its outputs directly,
+    without any pickling or copies through Python.
+ *************************************************************************/
+
+class DataReader {
+ public:
+    DataReader(const DataLoaderParam& param, int num_parts, int part_idx,
+               BlockingQueue<string>* Q_out);
+
+    void Run();
+
+ private:
+    void Redirect(TIndex target_idx);
+    void Reset();
+    void NextChunk();
+
+    const DataLoaderParam& param;
+    int num_parts, part_idx;
+    BlockingQueue<string>* Q_out;
+    unique_ptr<DB> db;
+    std::mt19937 rng;
+    TIndex db_size, chunk_size, num_shuffle_parts;
+    TIndex cur_idx, cur_chunk_idx, start_idx, end_idx;
+    vector<TIndex> perm;
+};
+
+class DataTransformer {
+ public:
+    DataTransformer(const DataLoaderParam& param, unsigned int seed,
+                    BlockingQueue<string>* Q_in,
+                    BlockingQueue<DataSample>* Q_out);
+
+    void Run();
+    void Transform(const string& serialized, DataSample* sample);
+
+ private:
+    template <typename T>
+    void TransformImage(const T* im, int h, int w, int c, DataSample* sample);
+
+    const DataLoaderParam& param;
+    BlockingQueue<string>* Q_in;
+    BlockingQueue<DataSample>* Q_out;
+    std::mt19937 rng;
+};
+
+class DataLoader {
+ public:
+    explicit DataLoader(const DataLoaderParam& param);
+    ~DataLoader();
+
+    //  block until the next transformed sample
+    void Next(DataSample* sample);
+
+ private:
+    DataLoaderParam param;
+    BlockingQueue<string> Q_level_1;
+    BlockingQueue<DataSample> Q_level_2;
+    vector<unique_ptr<DataReader> > readers;
+    vector<unique_ptr<DataTransformer> > transformers;
+    vector<std::thread> threads;
+};
+
+}    // namespace dragon
+
+#endif    // DRAGON_UTILS_DATA_LOADER_H_
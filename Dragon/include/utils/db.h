@@ -0,0 +1,103 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// ------------------------------------------------------------
+
+#ifndef DRAGON_UTILS_DB_H_
+#define DRAGON_UTILS_DB_H_
+
+#include <fstream>
+
+#include "core/common.h"
+
+#ifdef WITH_LMDB
+#include <lmdb.h>
+#endif
+
+namespace dragon {
+
+typedef int64_t TIndex;
+
+/**************************************************************************
+ *  The sequential databases of the records.
+ *  The records are addressed by the index, which is the zero-filled key
+    of LMDB (with the "size" and "zfill" keys written by "dragon.tools"),
+    or the position in a record file.
+ *  A record file is laid out as:
+    "DRAGONRC" | { uint64 length | bytes } x N | uint64 offset x N
+               | uint64 N | "DRAGONRC"
+ *************************************************************************/
+
+class DB {
+ public:
+    virtual ~DB() {}
+
+    virtual void Open(const string& source) = 0;
+    virtual void Close() = 0;
+
+    //  set the cursor to the index-th record
+    virtual void Seek(TIndex index) = 0;
+    //  step the cursor, and wrap to the first at the end
+    virtual void Next() = 0;
+    virtual void Value(string* value) = 0;
+
+    inline TIndex size() const { return size_; }
+    inline TIndex total_bytes() const { return total_bytes_; }
+
+ protected:
+    TIndex size_ = 0, total_bytes_ = 0;
+};
+
+class RecordDB final : public DB {
+ public:
+    ~RecordDB() { Close(); }
+
+    void Open(const string& source) override;
+    void Close() override;
+    void Seek(TIndex index) override;
+    void Next() override;
+    void Value(string* value) override;
+
+ private:
+    std::ifstream file;
+    vector<uint64_t> offsets;
+    TIndex cursor = 0;
+};
+
+#ifdef WITH_LMDB
+
+class LMDB final : public DB {
+ public:
+    ~LMDB() { Close(); }
+
+    void Open(const string& source) override;
+    void Close() override;
+    void Seek(TIndex index) override;
+    void Next() override;
+    void Value(string* value) override;
+
+ private:
+    bool Get(const string& key, string* value);
+
+    MDB_env* env = nullptr;
+    MDB_txn* txn = nullptr;
+    MDB_dbi dbi;
+    MDB_cursor* cursor = nullptr;
+    MDB_val mdb_key, mdb_value;
+    int zfill = 8;
+};
+
+#endif    // WITH_LMDB
+
+//  LMDB for a directory, or the record file
+DB* CreateDB(const string& source);
+
+}    // namespace dragon
+
+#endif    // DRAGON_UTILS_DB_H_
@@ -17,13 +17,17 @@
 #include <algorithm>
 #include <omp.h>
 
+#include "utils/thread_pool.h"
+
 namespace dragon {
 
 #define OMP_MIN_ITERATORS_PER_CORE 200000
 
 inline int GET_OMP_THREADS(const int N) { 
    int threads = std::max(N / OMP_MIN_ITERATORS_PER_CORE, 1); 
-   return std::min(threads, omp_get_num_procs());
+   //  the workers of a thread pool share the cores
+   int cores = ThreadPool::NumCoresPerWorker();
+   return std::min(threads, cores > 0 ? cores : omp_get_num_procs());
 }
 
 }
@@ -162,6 +162,15 @@ void BiasAdd(const int count,
              const T* bias_multiplier, 
              T* y);
 
+//  y = relu(y + bias) in one pass, y is viewed as (outer_dim, dim, inner_dim)
+template <typename T, class Context>
+void BiasRelu(const int outer_dim,
+              const int dim,
+              const int inner_dim,
+              const T* bias,
+              const float slope,
+              T* y);
+
 /******************** arithmetic.clip ********************/
 
 template <typename T, class Context>
@@ -172,6 +181,47 @@ void Clip(const int count,
           T* mask, 
           T* y);
 
+/******************** arithmetic.fused_elementwise ********************/
+
+#define FUSED_MAX_VALUES 32
+
+enum FusedOpcode {
+    FUSED_ADD, FUSED_SUB, FUSED_MUL, FUSED_DIV,
+    FUSED_RELU, FUSED_ELU, FUSED_SIGMOID, FUSED_TANH,
+    FUSED_EXP, FUSED_LOG, FUSED_SQUARE, FUSED_POW, FUSED_CLIP,
+};
+
+//  the values are the inputs followed by the results of instructions,
+//  the k-th instruction computes value(num_inputs + k) = opcode(a, [b]),
+//  and the last value is the output.
+//  the value v is read at (i / div[v]) % mod[v] for the i-th output,
+//  which broadcasts the smaller ones. the program is passed by value.
+struct FusedProgram {
+    int num_inputs, num_insts;
+    int opcode[FUSED_MAX_VALUES], a[FUSED_MAX_VALUES], b[FUSED_MAX_VALUES];
+    float params[FUSED_MAX_VALUES][3];
+    int div[FUSED_MAX_VALUES], mod[FUSED_MAX_VALUES];
+};
+
+template <typename T>
+struct FusedData {
+    const T* x[FUSED_MAX_VALUES];
+    //  the gradients of each output element, skipped if nullptr
+    T* dx[FUSED_MAX_VALUES];
+};
+
+template <typename T, class Context>
+void FusedElementwise(const int count,
+                      const FusedProgram& program,
+                      const FusedData<T>& data,
+                      T* y);
+
+template <typename T, class Context>
+void FusedElementwiseGrad(const int count,
+                          const FusedProgram& program,
+                          const FusedData<T>& data,
+                          const T* dy);
+
 /******************** arithmetic.scale ********************/
 
 template <typename T, class Context>
@@ -300,6 +350,26 @@ void ImageData(const int count,
                const Tx* x,
                Ty* y);
 
+/******************** misc.image_augment ********************/
+
+//  params holds (resized_h, resized_w, h_off, w_off, mirror) of each image,
+//  the crop of the resized image is padded by "pad" on each side
+template <typename Tx, class Context>
+void ImageAugment(const int N,
+                  const int C,
+                  const int H,
+                  const int W,
+                  const int crop_h,
+                  const int crop_w,
+                  const int pad,
+                  const float fill_value,
+                  const int* params,
+                  const float* mean_values,
+                  const float* std_values,
+                  const string& data_format,
+                  const Tx* x,
+                  float* y);
+
 /******************** ndarray.arange ********************/
 
 template <typename T, class Context>
@@ -602,37 +672,58 @@ void LSTMUnitGrad(const int count,
 
 /******************** update.adam_update ********************/
 
+//  the update kernels take g = alpha * dx + l2_decay * x,
+//  then update x in place and reset dx to zero in a single pass
+
 template <typename T, class Context>
-void AdamUpdate(Tensor* x, 
-                Tensor* m, 
-                Tensor* v, 
-                Tensor* t,
-                const float beta1, 
-                const float beta2, 
-                const float eps, 
-                const float lr);
+void AdamUpdate(const int count,
+                const float lr,
+                const float beta1,
+                const float beta2,
+                const float eps,
+                const float alpha,
+                const float l2_decay,
+                T* x,
+                T* dx,
+                T* m,
+                T* v);
 
 /******************** update.nesterov_update ********************/
 
 template <typename T, class Context>
 void NesterovUpdate(const int count,
-                    T* x,
-                    T* h,
-                    Tensor* t,
-                    const float momentum,
                     const float lr,
-                    Context* ctx);
+                    const float momentum,
+                    const float alpha,
+                    const float l2_decay,
+                    T* x,
+                    T* dx,
+                    T* h);
 
 /******************** update.rmsprop_update ********************/
 
 template <typename T, class Context>
 void RMSPropUpdate(const int count,
-                   T* x,
-                   T* h,
-                   Tensor* t,
+                   const float lr,
                    const float decay,
                    const float eps,
-                   const float lr);
+                   const float alpha,
+                   const float l2_decay,
+                   T* x,
+                   T* dx,
+                   T* h);
+
+/******************** update.sgd_update ********************/
+
+template <typename T, class Context>
+void SGDUpdate(const int count,
+               const float lr,
+               const float momentum,
+               const float alpha,
+               const float l2_decay,
+               T* x,
+               T* dx,
+               T* h);
 
 /******************** vision.bilinear_resize ********************/
 
@@ -0,0 +1,80 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// ------------------------------------------------------------
+
+#ifndef DRAGON_UTILS_PHILOX_H_
+#define DRAGON_UTILS_PHILOX_H_
+
+#include <cstdint>
+#include <string>
+
+namespace dragon {
+
+/**************************************************************************
+ *  Philox4x32-10, the counter-based generator of Salmon et al. (SC'11).
+ *  A 128-bit counter is encrypted with a 64-bit key into 4 random words,
+    the same (seed, offset, block) always gives the same words.
+ *  The offset selects a disjoint stream for each call, and the block
+    indexes the elements inside it, so the threads can generate their
+    own slices without sharing any state.
+ *************************************************************************/
+
+class Philox4x32 {
+ public:
+    Philox4x32(uint64_t seed, uint64_t offset)
+        : key0_((uint32_t)seed), key1_((uint32_t)(seed >> 32)),
+          offset0_((uint32_t)offset), offset1_((uint32_t)(offset >> 32)) {}
+
+    //  generate 4 words for the block,
+    //  the substream distinguishes the retries of rejection sampling
+    inline void Generate(uint32_t block, uint32_t substream, uint32_t* out) const {
+        uint32_t ctr[4] = { block, substream, offset0_, offset1_ };
+        uint32_t key[2] = { key0_, key1_ };
+        for (int round = 0; round < 10; round++) {
+            if (round > 0) { key[0] += kW0; key[1] += kW1; }
+            uint64_t prod0 = (uint64_t)kM0 * ctr[0];
+            uint64_t prod1 = (uint64_t)kM1 * ctr[2];
+            uint32_t hi0 = (uint32_t)(prod0 >> 32), lo0 = (uint32_t)prod0;
+            uint32_t hi1 = (uint32_t)(prod1 >> 32), lo1 = (uint32_t)prod1;
+            ctr[0] = hi1 ^ ctr[1] ^ key[0];
+            ctr[1] = lo1;
+            ctr[2] = hi0 ^ ctr[3] ^ key[1];
+            ctr[3] = lo0;
+        }
+        out[0] = ctr[0]; out[1] = ctr[1]; out[2] = ctr[2]; out[3] = ctr[3];
+    }
+
+    //  hash a name (FNV-1a) into a stream, which is stable across the runs
+    static inline uint32_t StreamOf(const std::string& name) {
+        uint32_t hash = 2166136261u;
+        for (unsigned char c : name) { hash ^= c; hash *= 16777619u; }
+        return hash;
+    }
+
+    //  map a word into [0, 1) with 24 bits of precision
+    static inline float ToUniform(uint32_t x) {
+        return (x >> 8) * (1.f / 16777216.f);
+    }
+
+    //  map a word into (0, 1], which is safe for log()
+    static inline float ToUniformNonZero(uint32_t x) {
+        return ((x >> 8) + 1) * (1.f / 16777216.f);
+    }
+
+ private:
+    static const uint32_t kM0 = 0xD2511F53, kM1 = 0xCD9E8D57;
+    static const uint32_t kW0 = 0x9E3779B9, kW1 = 0xBB67AE85;
+
+    uint32_t key0_, key1_, offset0_, offset1_;
+};
+
+}    // namespace dragon
+
+#endif    // DRAGON_UTILS_PHILOX_H_
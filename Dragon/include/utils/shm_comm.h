@@ -0,0 +1,91 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// -------------------------------------------------------------
+
+#ifndef DRAGON_UTILS_SHM_COMM_H_
+#define DRAGON_UTILS_SHM_COMM_H_
+
+#ifdef WITH_SHM
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "core/common.h"
+
+namespace dragon {
+
+typedef int64_t TIndex;
+
+/**************************************************************************
+ *  The collectives of the local processes over a POSIX shared memory.
+ *  Each rank owns a slot of "slot_count" floats in the segment. A chunk
+    of the gradients is copied into the slots, then each rank reduces its
+    own segment over all slots (reduce-scatter), and copies the reduced
+    segments of the others back (allgather). The ranks only wait on the
+    atomic barrier of the segment, there are no locks.
+ *  The segment is created by the rank 0, and unlinked once all ranks have
+    attached, the "key" should be unique among the jobs on the host.
+ *  A segment left by a crashed job is marked as stale by the rank 0 before
+    replacing it, and the others only attach the ready segment whose
+    creator is alive.
+ *************************************************************************/
+
+class SHMComm {
+ public:
+    SHMComm(const string& key, int rank, int size, TIndex slot_count);
+    ~SHMComm();
+
+    //  x = scale * sum(x) over the ranks, in place
+    void AllReduce(const vector<float*>& x,
+                   const vector<TIndex>& counts,
+                   const float scale);
+
+    //  x = x of the root
+    void Bcast(const vector<float*>& x,
+               const vector<TIndex>& counts,
+               const int root);
+
+    void Barrier();
+
+    inline int rank() const { return rank_; }
+    inline int size() const { return size_; }
+    inline TIndex slot_count() const { return slot_count_; }
+
+ private:
+    struct Header {
+        std::atomic<int> count;
+        char pad0[64 - sizeof(std::atomic<int>)];
+        std::atomic<int> generation;
+        char pad1[64 - sizeof(std::atomic<int>)];
+        std::atomic<int> state;
+        int creator;
+        char pad2[64 - sizeof(std::atomic<int>) - sizeof(int)];
+    };
+
+    enum State { kCreating = 0, kReady = 1, kStale = 2 };
+
+    inline float* slot(int rank) {
+        return (float*)(base_ + sizeof(Header)) + rank * slot_count_;
+    }
+
+    string name_;
+    int rank_, size_;
+    TIndex slot_count_;
+    size_t nbytes_;
+    char* base_;
+    Header* header_;
+};
+
+}    // namespace dragon
+
+#endif    // WITH_SHM
+
+#endif    // DRAGON_UTILS_SHM_COMM_H_
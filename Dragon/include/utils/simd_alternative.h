@@ -0,0 +1,187 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// ------------------------------------------------------------
+
+#ifndef DRAGON_UTILS_SIMD_ALTERNATIVE_H_
+#define DRAGON_UTILS_SIMD_ALTERNATIVE_H_
+
+#ifdef WITH_SSE
+
+#include <string>
+
+namespace dragon {
+
+namespace simd {
+
+/**************************************************************************
+ *  The vector kernels are compiled for SSE4.1, AVX2+FMA and AVX-512,
+    and the widest one supported by the cpu is selected at startup.
+ *  Exp/Log are the polynomials of Cephes (about 1 ulp), Pow is exp(a*log(x))
+    whose error grows with |a*log(x)|, up to about 64 ulp near the overflow.
+ *  Sigmoid/Tanh/Elu are built on the same exp, measured against <cmath>:
+    Sigmoid 3 ulp, Tanh 1 ulp, Elu 7 ulp for |x| > 0.1, which comes from
+    the cancellation of exp(x) - 1 as in the scalar form.
+ *  The lanes out of their ranges (e.g. inf, NaN) fall back to <cmath>.
+ *************************************************************************/
+
+//  the name of the selected instruction set
+const char* ISA();
+
+//  select "SSE4.1", "AVX2" or "AVX-512" manually,
+//  return false if it is not supported by the cpu
+bool SetISA(const std::string& name);
+
+/******************** Level-0 ********************/
+
+template <typename T>
+void Set(const int n, const T alpha, T* x);
+
+/******************** Level-1 ********************/
+
+template <typename T>
+void Add(const int n, const T* a, const T* b, T* y);
+
+template <typename T>
+void Sub(const int n, const T* a, const T* b, T* y);
+
+template <typename T>
+void Mul(const int n, const T* a, const T* b, T* y);
+
+template <typename T>
+void Div(const int n, const T* a, const T* b, T* y);
+
+template <typename T>
+void Clip(const int n, const float low, const float high, T* x);
+
+template <typename T>
+void Exp(const int n, const T* x, T* y);
+
+template <typename T>
+void Log(const int n, const T* x, T* y);
+
+template <typename T>
+void Square(const int n, const T* x, T* y);
+
+template <typename T>
+void Sqrt(const int n, const T* x, T* y);
+
+template <typename T>
+void Pow(const int n, const float alpha, const T* x, T* y);
+
+template <typename T>
+void Inv(const int n, const float numerator, const T* x, T* y);
+
+/******************** Level-2 ********************/
+
+template <typename T>
+void Scal(const int n, const T alpha, T* y);
+
+template <typename T>
+void Scale(const int n, const T alpha, const T* x, T* y);
+
+template <typename T>
+T Dot(const int n, const T* a, const T* b);
+
+template<typename T>
+T ASum(const int n, const T *x);
+
+template<typename T>
+void AddScalar(const int n, const T alpha, T* y);
+
+template<typename T>
+void MulScalar(const int n, const T alpha, T* y);
+
+template<typename T>
+void Axpy(const int n, const T alpha, const T* x, T *y);
+
+template<typename T>
+void Axpby(const int n, const T alpha, const T* x, const T beta, T *y);
+
+/******************** Activation ********************/
+
+template <typename T>
+void Sigmoid(const int n, const T* x, T* y);
+
+template <typename T>
+void Tanh(const int n, const T* x, T* y);
+
+//  y = scale * max(x, 0) + alpha * (exp(min(x, 0)) - 1)
+template <typename T>
+void Elu(const int n, const float alpha, const float scale, const T* x, T* y);
+
+//  the softmax over the axis of classes, x is (outer_dim, classes, inner_dim)
+template <typename T>
+void Softmax(const int outer_dim, const int classes, const int inner_dim, const T* x, T* y);
+
+//  dx = (dy - sum(dy * y)) * y over the axis of classes
+template <typename T>
+void SoftmaxGrad(const int outer_dim,
+                 const int classes,
+                 const int inner_dim,
+                 const T* dy,
+                 const T* y,
+                 T* dx);
+
+/******************** Update ********************/
+
+//  the updates take g = alpha * dx + l2_decay * x in the same pass,
+//  where alpha folds the scale and clip of the gradient,
+//  x is updated in place and dx is reset to zero
+template <typename T>
+void SGDUpdate(const int n,
+               const float lr,
+               const float momentum,
+               const float alpha,
+               const float l2_decay,
+               T* x,
+               T* dx,
+               T* h);
+
+template <typename T>
+void NesterovUpdate(const int n,
+                    const float lr,
+                    const float momentum,
+                    const float alpha,
+                    const float l2_decay,
+                    T* x,
+                    T* dx,
+                    T* h);
+
+template <typename T>
+void RMSPropUpdate(const int n,
+                   const float lr,
+                   const float decay,
+                   const float eps,
+                   const float alpha,
+                   const float l2_decay,
+                   T* x,
+                   T* dx,
+                   T* h);
+
+template <typename T>
+void AdamUpdate(const int n,
+                const float lr,
+                const float beta1,
+                const float beta2,
+                const float eps,
+                const float alpha,
+                const float l2_decay,
+                T* x,
+                T* dx,
+                T* m,
+                T* v);
+
+}    // namespace simd
+
+}    // namespace dragon
+
+#endif // WITH_SSE
+
+#endif // DRAGON_UTILS_SIMD_ALTERNATIVE_H_
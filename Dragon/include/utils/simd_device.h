@@ -0,0 +1,608 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// ------------------------------------------------------------
+
+#ifndef DRAGON_UTILS_SIMD_DEVICE_H_
+#define DRAGON_UTILS_SIMD_DEVICE_H_
+
+#ifdef WITH_SSE
+
+#include <cmath>
+#include <cfloat>
+#include <cstring>
+#include <algorithm>
+
+namespace dragon {
+
+namespace simd {
+
+/**************************************************************************
+ *  The kernels of an instruction set, filled by InitKernels<V>().
+ *
+ *  V wraps the registers of an instruction set with W float lanes:
+ *    load/store/set1/zero, add/sub/mul/div/min/max/sqrt/abs,
+ *    fmadd(a, b, c) = a * b + c, round, reduce (sum of the lanes),
+ *    pow2n (2^n of an integral n), frexp (the mantissa in [0.5, 1)
+      and the exponent), select (m ? a : b), lt (a < b),
+ *    in_range (the bits of lanes in [lo, hi], NaN is out of range).
+ *
+ *  Each instruction set is compiled in its own translation unit,
+    which includes this header after enabling the target, so the
+    templates here are instantiated with the right instructions.
+ *************************************************************************/
+
+struct Kernels {
+    const char* name;
+    void (*Set)(const int n, const float alpha, float* x);
+    void (*Add)(const int n, const float* a, const float* b, float* y);
+    void (*Sub)(const int n, const float* a, const float* b, float* y);
+    void (*Mul)(const int n, const float* a, const float* b, float* y);
+    void (*Div)(const int n, const float* a, const float* b, float* y);
+    void (*Clip)(const int n, const float low, const float high, float* x);
+    void (*Exp)(const int n, const float* x, float* y);
+    void (*Log)(const int n, const float* x, float* y);
+    void (*Square)(const int n, const float* x, float* y);
+    void (*Sqrt)(const int n, const float* x, float* y);
+    void (*Pow)(const int n, const float alpha, const float* x, float* y);
+    void (*Inv)(const int n, const float numerator, const float* x, float* y);
+    void (*Scale)(const int n, const float alpha, const float* x, float* y);
+    void (*AddScalar)(const int n, const float alpha, float* y);
+    float (*Dot)(const int n, const float* a, const float* b);
+    float (*ASum)(const int n, const float* x);
+    void (*Axpy)(const int n, const float alpha, const float* x, float* y);
+    void (*Axpby)(const int n, const float alpha, const float* x,
+                  const float beta, float* y);
+    void (*Sigmoid)(const int n, const float* x, float* y);
+    void (*Tanh)(const int n, const float* x, float* y);
+    void (*Elu)(const int n, const float alpha, const float scale,
+                const float* x, float* y);
+    //  the softmax of a slice, the classes are strided by inner_dim,
+    //  and only the first inner_count positions are computed
+    void (*Softmax)(const int classes, const int inner_dim, const int inner_count,
+                    const float* x, float* y);
+    void (*SoftmaxGrad)(const int classes, const int inner_dim, const int inner_count,
+                        const float* dy, const float* y, float* dx);
+    //  the updates take g = alpha * dx + l2_decay * x,
+    //  x is updated in place and dx is reset to zero
+    void (*SGDUpdate)(const int n, const float lr, const float momentum,
+                      const float alpha, const float l2_decay,
+                      float* x, float* dx, float* h);
+    void (*NesterovUpdate)(const int n, const float lr, const float momentum,
+                           const float alpha, const float l2_decay,
+                           float* x, float* dx, float* h);
+    void (*RMSPropUpdate)(const int n, const float lr, const float decay, const float eps,
+                          const float alpha, const float l2_decay,
+                          float* x, float* dx, float* h);
+    void (*AdamUpdate)(const int n, const float lr, const float beta1, const float beta2,
+                       const float eps, const float alpha, const float l2_decay,
+                       float* x, float* dx, float* m, float* v);
+};
+
+//  the range where the vector exp is valid,
+//  the others (overflow, denormal, NaN) fall back to std::exp
+#define SIMD_EXP_LOW -87.f
+#define SIMD_EXP_HIGH 88.f
+
+#define SIMD_LOOP1(i, n, W) \
+    for (i = 0; i + W <= n; i += W)
+
+#define SIMD_LOOP2(i, n) \
+    for (; i < n; ++i)
+
+template <class V>
+struct Generic {
+    typedef typename V::reg reg;
+
+    /*  exp(x) = 2^k * exp(r), r = x - k * ln2, |r| <= ln2 / 2,
+        the polynomial of exp(r) is from Cephes, about 1 ulp.  */
+    static inline reg exp(reg x) {
+        reg k = V::round(V::mul(x, V::set1(1.44269504088896341f)));
+        reg r = V::fmadd(k, V::set1(-0.693359375f), x);
+        r = V::fmadd(k, V::set1(2.12194440e-4f), r);
+        reg p = V::set1(1.9875691500e-4f);
+        p = V::fmadd(p, r, V::set1(1.3981999507e-3f));
+        p = V::fmadd(p, r, V::set1(8.3334519073e-3f));
+        p = V::fmadd(p, r, V::set1(4.1665795894e-2f));
+        p = V::fmadd(p, r, V::set1(1.6666665459e-1f));
+        p = V::fmadd(p, r, V::set1(5.0000001201e-1f));
+        p = V::fmadd(p, V::mul(r, r), V::add(r, V::set1(1.f)));
+        return V::mul(p, V::pow2n(k));
+    }
+
+    /*  log(x) = e * ln2 + log(m), m in [sqrt(0.5), sqrt(2)),
+        the polynomial of log(1 + f) is from Cephes, about 1 ulp.  */
+    static inline reg log(reg x) {
+        reg e, m = V::frexp(x, &e);
+        //  m < sqrt(0.5): m = 2m, e = e - 1
+        reg small = V::lt(m, V::set1(0.707106781186547524f));
+        e = V::sub(e, V::select(small, V::set1(1.f), V::zero()));
+        reg f = V::sub(V::add(m, V::select(small, m, V::zero())), V::set1(1.f));
+        reg z = V::mul(f, f);
+        reg p = V::set1(7.0376836292e-2f);
+        p = V::fmadd(p, f, V::set1(-1.1514610310e-1f));
+        p = V::fmadd(p, f, V::set1(1.1676998740e-1f));
+        p = V::fmadd(p, f, V::set1(-1.2420140846e-1f));
+        p = V::fmadd(p, f, V::set1(1.4249322787e-1f));
+        p = V::fmadd(p, f, V::set1(-1.6668057665e-1f));
+        p = V::fmadd(p, f, V::set1(2.0000714765e-1f));
+        p = V::fmadd(p, f, V::set1(-2.4999993993e-1f));
+        p = V::fmadd(p, f, V::set1(3.3333331174e-1f));
+        reg y = V::mul(V::mul(p, f), z);
+        y = V::fmadd(e, V::set1(-2.12194440e-4f), y);
+        y = V::fmadd(z, V::set1(-0.5f), y);
+        return V::fmadd(e, V::set1(0.693359375f), V::add(f, y));
+    }
+
+    static void Set(const int n, const float alpha, float* x) {
+        reg a = V::set1(alpha);
+        int i;
+        SIMD_LOOP1(i, n, V::W) V::store(x + i, a);
+        SIMD_LOOP2(i, n) x[i] = alpha;
+    }
+
+#define DEFINE_BINARY_KERNEL(name, op, expr) \
+    static void name(const int n, const float* a, const float* b, float* y) { \
+        int i; \
+        SIMD_LOOP1(i, n, V::W) \
+            V::store(y + i, V::op(V::load(a + i), V::load(b + i))); \
+        SIMD_LOOP2(i, n) y[i] = expr; \
+    }
+
+    DEFINE_BINARY_KERNEL(Add, add, a[i] + b[i]);
+    DEFINE_BINARY_KERNEL(Sub, sub, a[i] - b[i]);
+    DEFINE_BINARY_KERNEL(Mul, mul, a[i] * b[i]);
+    DEFINE_BINARY_KERNEL(Div, div, a[i] / b[i]);
+#undef DEFINE_BINARY_KERNEL
+
+    static void Clip(const int n, const float low, const float high, float* x) {
+        reg lo = V::set1(low), hi = V::set1(high);
+        int i;
+        SIMD_LOOP1(i, n, V::W)
+            V::store(x + i, V::max(lo, V::min(V::load(x + i), hi)));
+        SIMD_LOOP2(i, n) x[i] = std::max(low, std::min(x[i], high));
+    }
+
+    //  recompute the lanes out of range with <cmath>
+    template <typename Func>
+    static inline void Patch(const int mask, Func func, const float* x, float* y) {
+        if (mask == (1 << V::W) - 1) return;
+        for (int j = 0; j < V::W; ++j)
+            if (!((mask >> j) & 1)) y[j] = func(x[j]);
+    }
+
+    static void Exp(const int n, const float* x, float* y) {
+        reg lo = V::set1(SIMD_EXP_LOW), hi = V::set1(SIMD_EXP_HIGH);
+        auto func = [](float v) { return std::exp(v); };
+        int i;
+        SIMD_LOOP1(i, n, V::W) {
+            reg x1 = V::load(x + i);
+            int mask = V::in_range(x1, SIMD_EXP_LOW, SIMD_EXP_HIGH);
+            V::store(y + i, exp(V::max(lo, V::min(x1, hi))));
+            Patch(mask, func, x + i, y + i);
+        }
+        SIMD_LOOP2(i, n) y[i] = std::exp(x[i]);
+    }
+
+    static void Log(const int n, const float* x, float* y) {
+        reg lo = V::set1(FLT_MIN), hi = V::set1(FLT_MAX);
+        auto func = [](float v) { return std::log(v); };
+        int i;
+        SIMD_LOOP1(i, n, V::W) {
+            reg x1 = V::load(x + i);
+            //  zero, negative, denormal, inf and NaN
+            int mask = V::in_range(x1, FLT_MIN, FLT_MAX);
+            V::store(y + i, log(V::max(lo, V::min(x1, hi))));
+            Patch(mask, func, x + i, y + i);
+        }
+        SIMD_LOOP2(i, n) y[i] = std::log(x[i]);
+    }
+
+    static void Square(const int n, const float* x, float* y) {
+        int i;
+        SIMD_LOOP1(i, n, V::W) {
+            reg x1 = V::load(x + i);
+            V::store(y + i, V::mul(x1, x1));
+        }
+        SIMD_LOOP2(i, n) y[i] = x[i] * x[i];
+    }
+
+    static void Sqrt(const int n, const float* x, float* y) {
+        int i;
+        SIMD_LOOP1(i, n, V::W) V::store(y + i, V::sqrt(V::load(x + i)));
+        SIMD_LOOP2(i, n) y[i] = std::sqrt(x[i]);
+    }
+
+    static void Pow(const int n, const float alpha, const float* x, float* y) {
+        if (alpha == 1.f) { if (x != y) memcpy(y, x, sizeof(float) * n); return; }
+        if (alpha == 2.f) { Square(n, x, y); return; }
+        if (alpha == 0.5f) { Sqrt(n, x, y); return; }
+        //  x^a = exp(a * log(x)) for the positive x, the error grows
+        //  with |a * log(x)|, and is about 64 ulp near the overflow.
+        //  the others follow the special cases of std::pow
+        reg a = V::set1(alpha);
+        reg lo = V::set1(FLT_MIN), hi = V::set1(FLT_MAX);
+        reg exp_lo = V::set1(SIMD_EXP_LOW), exp_hi = V::set1(SIMD_EXP_HIGH);
+        auto func = [alpha](float v) { return std::pow(v, alpha); };
+        int i;
+        SIMD_LOOP1(i, n, V::W) {
+            reg x1 = V::load(x + i);
+            int mask = V::in_range(x1, FLT_MIN, FLT_MAX);
+            reg t = V::mul(a, log(V::max(lo, V::min(x1, hi))));
+            mask &= V::in_range(t, SIMD_EXP_LOW, SIMD_EXP_HIGH);
+            V::store(y + i, exp(V::max(exp_lo, V::min(t, exp_hi))));
+            Patch(mask, func, x + i, y + i);
+        }
+        SIMD_LOOP2(i, n) y[i] = std::pow(x[i], alpha);
+    }
+
+    static void Inv(const int n, const float numerator, const float* x, float* y) {
+        reg a = V::set1(numerator);
+        int i;
+        SIMD_LOOP1(i, n, V::W) V::store(y + i, V::div(a, V::load(x + i)));
+        SIMD_LOOP2(i, n) y[i] = numerator / x[i];
+    }
+
+    static void Scale(const int n, const float alpha, const float* x, float* y) {
+        reg a = V::set1(alpha);
+        int i;
+        SIMD_LOOP1(i, n, V::W) V::store(y + i, V::mul(V::load(x + i), a));
+        SIMD_LOOP2(i, n) y[i] = x[i] * alpha;
+    }
+
+    static void AddScalar(const int n, const float alpha, float* y) {
+        reg a = V::set1(alpha);
+        int i;
+        SIMD_LOOP1(i, n, V::W) V::store(y + i, V::add(V::load(y + i), a));
+        SIMD_LOOP2(i, n) y[i] += alpha;
+    }
+
+    static float Dot(const int n, const float* a, const float* b) {
+        reg sum = V::zero();
+        int i;
+        SIMD_LOOP1(i, n, V::W)
+            sum = V::fmadd(V::load(a + i), V::load(b + i), sum);
+        float ret = V::reduce(sum);
+        SIMD_LOOP2(i, n) ret += a[i] * b[i];
+        return ret;
+    }
+
+    static float ASum(const int n, const float* x) {
+        reg sum = V::zero();
+        int i;
+        SIMD_LOOP1(i, n, V::W) sum = V::add(sum, V::abs(V::load(x + i)));
+        float ret = V::reduce(sum);
+        SIMD_LOOP2(i, n) ret += std::abs(x[i]);
+        return ret;
+    }
+
+    static void Axpy(const int n, const float alpha, const float* x, float* y) {
+        reg a = V::set1(alpha);
+        int i;
+        SIMD_LOOP1(i, n, V::W)
+            V::store(y + i, V::fmadd(a, V::load(x + i), V::load(y + i)));
+        SIMD_LOOP2(i, n) y[i] = alpha * x[i] + y[i];
+    }
+
+    static void Axpby(const int n, const float alpha, const float* x,
+                      const float beta, float* y) {
+        reg a = V::set1(alpha), b = V::set1(beta);
+        int i;
+        SIMD_LOOP1(i, n, V::W)
+            V::store(y + i, V::fmadd(a, V::load(x + i),
+                                     V::mul(b, V::load(y + i))));
+        SIMD_LOOP2(i, n) y[i] = alpha * x[i] + beta * y[i];
+    }
+
+    //  sigmoid(x) = 1 / (1 + exp(-x)), or exp(x) / (1 + exp(x)) for x < 0,
+    //  which keeps the relative error for the negative x
+    static inline float sigmoid(float x) {
+        return x < 0 ? std::exp(x) / (1.f + std::exp(x)) : 1.f / (1.f + std::exp(-x));
+    }
+
+    static void Sigmoid(const int n, const float* x, float* y) {
+        reg zero = V::zero(), one = V::set1(1.f);
+        int i;
+        SIMD_LOOP1(i, n, V::W) {
+            reg x1 = V::load(x + i);
+            //  the underflow and NaN
+            int mask = V::in_range(x1, SIMD_EXP_LOW, INFINITY);
+            reg t = exp(V::max(V::sub(zero, V::abs(x1)), V::set1(SIMD_EXP_LOW)));
+            reg s = V::div(one, V::add(one, t));
+            V::store(y + i, V::select(V::lt(x1, zero), V::mul(t, s), s));
+            Patch(mask, sigmoid, x + i, y + i);
+        }
+        SIMD_LOOP2(i, n) y[i] = sigmoid(x[i]);
+    }
+
+    /*  tanh(x) = x + x^3 * P(x^2) for |x| < 0.625 (Cephes),
+        or sign(x) * (1 - 2 / (exp(2|x|) + 1)), saturated at |x| = 9.  */
+    static void Tanh(const int n, const float* x, float* y) {
+        reg zero = V::zero(), one = V::set1(1.f), two = V::set1(2.f);
+        auto func = [](float v) { return std::tanh(v); };
+        int i;
+        SIMD_LOOP1(i, n, V::W) {
+            reg x1 = V::load(x + i), a = V::abs(x1);
+            int mask = V::in_range(x1, -INFINITY, INFINITY);
+            reg e = exp(V::mul(two, V::min(a, V::set1(9.f))));
+            reg r = V::sub(one, V::div(two, V::add(e, one)));
+            r = V::select(V::lt(a, V::set1(9.f)), r, one);
+            r = V::select(V::lt(x1, zero), V::sub(zero, r), r);
+            reg z = V::mul(x1, x1);
+            reg p = V::set1(-5.70498872745e-3f);
+            p = V::fmadd(p, z, V::set1(2.06390887954e-2f));
+            p = V::fmadd(p, z, V::set1(-5.37397155531e-2f));
+            p = V::fmadd(p, z, V::set1(1.33314422036e-1f));
+            p = V::fmadd(p, z, V::set1(-3.33332819422e-1f));
+            reg q = V::fmadd(V::mul(p, z), x1, x1);
+            V::store(y + i, V::select(V::lt(a, V::set1(0.625f)), q, r));
+            Patch(mask, func, x + i, y + i);
+        }
+        SIMD_LOOP2(i, n) y[i] = std::tanh(x[i]);
+    }
+
+    //  y = scale * max(x, 0) + alpha * (exp(min(x, 0)) - 1)
+    static void Elu(const int n, const float alpha, const float scale,
+                    const float* x, float* y) {
+        reg zero = V::zero(), one = V::set1(1.f);
+        reg a = V::set1(alpha), b = V::set1(scale);
+        auto func = [alpha, scale](float v) {
+            return scale * std::max(v, 0.f) + alpha * (std::exp(std::min(v, 0.f)) - 1.f);
+        };
+        int i;
+        SIMD_LOOP1(i, n, V::W) {
+            reg x1 = V::load(x + i);
+            int mask = V::in_range(x1, -INFINITY, INFINITY);
+            reg e = exp(V::max(V::min(x1, zero), V::set1(SIMD_EXP_LOW)));
+            V::store(y + i, V::fmadd(b, V::max(x1, zero), V::mul(a, V::sub(e, one))));
+            Patch(mask, func, x + i, y + i);
+        }
+        SIMD_LOOP2(i, n) y[i] = func(x[i]);
+    }
+
+    static inline float reduce_max(reg x) {
+        float buf[V::W];
+        V::store(buf, x);
+        float ret = buf[0];
+        for (int j = 1; j < V::W; ++j) ret = std::max(ret, buf[j]);
+        return ret;
+    }
+
+    //  exp(x - max) >= exp(-87) is enough for the sum >= 1
+    static inline reg softmax_exp(reg x, reg max) {
+        return exp(V::max(V::sub(x, max), V::set1(SIMD_EXP_LOW)));
+    }
+
+    /*  the contiguous classes: max, exp with the sum, and the scaling.
+        the strided classes: the lanes are the inner positions,
+        each of them keeps its max and sum in the registers.  */
+    static void Softmax(const int classes, const int inner_dim, const int inner_count,
+                        const float* x, float* y) {
+        if (inner_dim == 1) {
+            reg m = V::set1(-FLT_MAX);
+            int j;
+            SIMD_LOOP1(j, classes, V::W) m = V::max(m, V::load(x + j));
+            float max = reduce_max(m);
+            SIMD_LOOP2(j, classes) max = std::max(max, x[j]);
+            reg sum = V::zero(); m = V::set1(max);
+            SIMD_LOOP1(j, classes, V::W) {
+                reg e = softmax_exp(V::load(x + j), m);
+                V::store(y + j, e);
+                sum = V::add(sum, e);
+            }
+            float s = V::reduce(sum);
+            SIMD_LOOP2(j, classes) { y[j] = std::exp(x[j] - max); s += y[j]; }
+            Scale(classes, 1.f / s, y, y);
+            return;
+        }
+        int k;
+        SIMD_LOOP1(k, inner_count, V::W) {
+            reg m = V::load(x + k);
+            for (int j = 1; j < classes; ++j)
+                m = V::max(m, V::load(x + j * inner_dim + k));
+            reg sum = V::zero();
+            for (int j = 0; j < classes; ++j) {
+                reg e = softmax_exp(V::load(x + j * inner_dim + k), m);
+                V::store(y + j * inner_dim + k, e);
+                sum = V::add(sum, e);
+            }
+            reg inv = V::div(V::set1(1.f), sum);
+            for (int j = 0; j < classes; ++j)
+                V::store(y + j * inner_dim + k, V::mul(V::load(y + j * inner_dim + k), inv));
+        }
+        SIMD_LOOP2(k, inner_count) {
+            float max = x[k], s = 0.f;
+            for (int j = 1; j < classes; ++j) max = std::max(max, x[j * inner_dim + k]);
+            for (int j = 0; j < classes; ++j) {
+                y[j * inner_dim + k] = std::exp(x[j * inner_dim + k] - max);
+                s += y[j * inner_dim + k];
+            }
+            for (int j = 0; j < classes; ++j) y[j * inner_dim + k] /= s;
+        }
+    }
+
+    //  dx = (dy - sum(dy * y)) * y, dx can be dy
+    static void SoftmaxGrad(const int classes, const int inner_dim, const int inner_count,
+                            const float* dy, const float* y, float* dx) {
+        if (inner_dim == 1) {
+            const float s = Dot(classes, dy, y);
+            reg s1 = V::set1(s);
+            int j;
+            SIMD_LOOP1(j, classes, V::W)
+                V::store(dx + j, V::mul(V::sub(V::load(dy + j), s1), V::load(y + j)));
+            SIMD_LOOP2(j, classes) dx[j] = (dy[j] - s) * y[j];
+            return;
+        }
+        int k;
+        SIMD_LOOP1(k, inner_count, V::W) {
+            reg s = V::zero();
+            for (int j = 0; j < classes; ++j)
+                s = V::fmadd(V::load(dy + j * inner_dim + k), V::load(y + j * inner_dim + k), s);
+            for (int j = 0; j < classes; ++j) {
+                const int idx = j * inner_dim + k;
+                V::store(dx + idx, V::mul(V::sub(V::load(dy + idx), s), V::load(y + idx)));
+            }
+        }
+        SIMD_LOOP2(k, inner_count) {
+            float s = 0.f;
+            for (int j = 0; j < classes; ++j) s += dy[j * inner_dim + k] * y[j * inner_dim + k];
+            for (int j = 0; j < classes; ++j) {
+                const int idx = j * inner_dim + k;
+                dx[idx] = (dy[idx] - s) * y[idx];
+            }
+        }
+    }
+
+    //  h = momentum * h + lr * g, x = x - h
+    static void SGDUpdate(const int n, const float lr, const float momentum,
+                          const float alpha, const float l2_decay,
+                          float* x, float* dx, float* h) {
+        reg a = V::set1(alpha), d = V::set1(l2_decay);
+        reg r = V::set1(lr), mu = V::set1(momentum), zero = V::zero();
+        int i;
+        SIMD_LOOP1(i, n, V::W) {
+            reg x1 = V::load(x + i);
+            reg g = V::fmadd(d, x1, V::mul(a, V::load(dx + i)));
+            reg h1 = V::fmadd(mu, V::load(h + i), V::mul(r, g));
+            V::store(h + i, h1);
+            V::store(x + i, V::sub(x1, h1));
+            V::store(dx + i, zero);
+        }
+        SIMD_LOOP2(i, n) {
+            const float g = alpha * dx[i] + l2_decay * x[i];
+            h[i] = momentum * h[i] + lr * g;
+            x[i] -= h[i];
+            dx[i] = 0.f;
+        }
+    }
+
+    //  h' = momentum * h + lr * g, x = x - ((1 + momentum) * h' - momentum * h)
+    static void NesterovUpdate(const int n, const float lr, const float momentum,
+                               const float alpha, const float l2_decay,
+                               float* x, float* dx, float* h) {
+        reg a = V::set1(alpha), d = V::set1(l2_decay);
+        reg r = V::set1(lr), mu = V::set1(momentum), zero = V::zero();
+        reg mu1 = V::set1(1.f + momentum);
+        int i;
+        SIMD_LOOP1(i, n, V::W) {
+            reg x1 = V::load(x + i), h0 = V::load(h + i);
+            reg g = V::fmadd(d, x1, V::mul(a, V::load(dx + i)));
+            reg h1 = V::fmadd(mu, h0, V::mul(r, g));
+            V::store(h + i, h1);
+            V::store(x + i, V::sub(x1, V::sub(V::mul(mu1, h1), V::mul(mu, h0))));
+            V::store(dx + i, zero);
+        }
+        SIMD_LOOP2(i, n) {
+            const float g = alpha * dx[i] + l2_decay * x[i];
+            const float h0 = h[i];
+            h[i] = momentum * h0 + lr * g;
+            x[i] -= (1.f + momentum) * h[i] - momentum * h0;
+            dx[i] = 0.f;
+        }
+    }
+
+    //  h = decay * h + (1 - decay) * g^2, x = x - lr * g / (sqrt(h) + eps)
+    static void RMSPropUpdate(const int n, const float lr, const float decay, const float eps,
+                              const float alpha, const float l2_decay,
+                              float* x, float* dx, float* h) {
+        reg a = V::set1(alpha), d = V::set1(l2_decay), r = V::set1(lr);
+        reg b = V::set1(decay), b1 = V::set1(1.f - decay), e = V::set1(eps);
+        reg zero = V::zero();
+        int i;
+        SIMD_LOOP1(i, n, V::W) {
+            reg x1 = V::load(x + i);
+            reg g = V::fmadd(d, x1, V::mul(a, V::load(dx + i)));
+            reg h1 = V::fmadd(b, V::load(h + i), V::mul(b1, V::mul(g, g)));
+            V::store(h + i, h1);
+            reg step = V::div(V::mul(r, g), V::add(V::sqrt(h1), e));
+            V::store(x + i, V::sub(x1, step));
+            V::store(dx + i, zero);
+        }
+        SIMD_LOOP2(i, n) {
+            const float g = alpha * dx[i] + l2_decay * x[i];
+            h[i] = decay * h[i] + (1.f - decay) * g * g;
+            x[i] -= lr * g / (std::sqrt(h[i]) + eps);
+            dx[i] = 0.f;
+        }
+    }
+
+    //  m = beta1 * m + (1 - beta1) * g, v = beta2 * v + (1 - beta2) * g^2,
+    //  x = x - lr * m / (sqrt(v) + eps), lr has the bias correction
+    static void AdamUpdate(const int n, const float lr, const float beta1, const float beta2,
+                           const float eps, const float alpha, const float l2_decay,
+                           float* x, float* dx, float* m, float* v) {
+        reg a = V::set1(alpha), d = V::set1(l2_decay), r = V::set1(lr);
+        reg b1 = V::set1(beta1), c1 = V::set1(1.f - beta1);
+        reg b2 = V::set1(beta2), c2 = V::set1(1.f - beta2);
+        reg e = V::set1(eps), zero = V::zero();
+        int i;
+        SIMD_LOOP1(i, n, V::W) {
+            reg x1 = V::load(x + i);
+            reg g = V::fmadd(d, x1, V::mul(a, V::load(dx + i)));
+            reg m1 = V::fmadd(b1, V::load(m + i), V::mul(c1, g));
+            reg v1 = V::fmadd(b2, V::load(v + i), V::mul(c2, V::mul(g, g)));
+            V::store(m + i, m1);
+            V::store(v + i, v1);
+            reg step = V::div(V::mul(r, m1), V::add(V::sqrt(v1), e));
+            V::store(x + i, V::sub(x1, step));
+            V::store(dx + i, zero);
+        }
+        SIMD_LOOP2(i, n) {
+            const float g = alpha * dx[i] + l2_decay * x[i];
+            m[i] = beta1 * m[i] + (1.f - beta1) * g;
+            v[i] = beta2 * v[i] + (1.f - beta2) * g * g;
+            x[i] -= lr * m[i] / (std::sqrt(v[i]) + eps);
+            dx[i] = 0.f;
+        }
+    }
+};
+
+template <class V>
+void InitKernels(const char* name, Kernels* kernels) {
+    kernels->name = name;
+    kernels->Set = Generic<V>::Set;
+    kernels->Add = Generic<V>::Add;
+    kernels->Sub = Generic<V>::Sub;
+    kernels->Mul = Generic<V>::Mul;
+    kernels->Div = Generic<V>::Div;
+    kernels->Clip = Generic<V>::Clip;
+    kernels->Exp = Generic<V>::Exp;
+    kernels->Log = Generic<V>::Log;
+    kernels->Square = Generic<V>::Square;
+    kernels->Sqrt = Generic<V>::Sqrt;
+    kernels->Pow = Generic<V>::Pow;
+    kernels->Inv = Generic<V>::Inv;
+    kernels->Scale = Generic<V>::Scale;
+    kernels->AddScalar = Generic<V>::AddScalar;
+    kernels->Dot = Generic<V>::Dot;
+    kernels->ASum = Generic<V>::ASum;
+    kernels->Axpy = Generic<V>::Axpy;
+    kernels->Axpby = Generic<V>::Axpby;
+    kernels->Sigmoid = Generic<V>::Sigmoid;
+    kernels->Tanh = Generic<V>::Tanh;
+    kernels->Elu = Generic<V>::Elu;
+    kernels->Softmax = Generic<V>::Softmax;
+    kernels->SoftmaxGrad = Generic<V>::SoftmaxGrad;
+    kernels->SGDUpdate = Generic<V>::SGDUpdate;
+    kernels->NesterovUpdate = Generic<V>::NesterovUpdate;
+    kernels->RMSPropUpdate = Generic<V>::RMSPropUpdate;
+    kernels->AdamUpdate = Generic<V>::AdamUpdate;
+}
+
+void InitSSEKernels(Kernels* kernels);
+void InitAVX2Kernels(Kernels* kernels);
+void InitAVX512Kernels(Kernels* kernels);
+
+}    // namespace simd
+
+}    // namespace dragon
+
+#endif    // WITH_SSE
+
+#endif    // DRAGON_UTILS_SIMD_DEVICE_H_
@@ -0,0 +1,78 @@
+// ------------------------------------------------------------
+// Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+//
+// Licensed under the BSD 2-Clause License.
+// You should have received a copy of the BSD 2-Clause License
+// along with the software. If not, See,
+//
+//      <https://opensource.org/licenses/BSD-2-Clause>
+//
+// ------------------------------------------------------------
+
+#ifndef DRAGON_UTILS_THREAD_POOL_H_
+#define DRAGON_UTILS_THREAD_POOL_H_
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+namespace dragon {
+
+/**************************************************************************
+ *  A work-stealing pool of CPU threads.
+ *  Each worker owns a deque: it pushes and pops tasks at the back (LIFO,
+    which keeps the successors of a finished task hot in cache),
+    while the idle workers steal from the front of others (FIFO).
+ *  Tasks scheduled from outside of the pool are dealt round-robin.
+ *************************************************************************/
+
+class ThreadPool {
+ public:
+    typedef std::function<void()> Task;
+
+    explicit ThreadPool(int num_threads);
+    ~ThreadPool();
+
+    void Schedule(Task task);
+
+    inline int size() const { return (int)workers_.size(); }
+
+    //  the id of the calling worker, unique among the running workers
+    //  of all pools, or -1 if it is not a worker
+    static int ThreadId();
+
+    //  the cores shared by each worker of the calling pool,
+    //  or 0 if it is not a worker
+    static int NumCoresPerWorker();
+
+ private:
+    struct Worker {
+        std::deque<Task> tasks;
+        std::mutex mutex;
+    };
+
+    bool Pop(int idx, Task* task);
+    bool Steal(int idx, Task* task);
+    void WorkerLoop(int idx);
+
+    static int AcquireThreadId();
+    static void ReleaseThreadId(int id);
+
+    std::vector<std::unique_ptr<Worker> > workers_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::atomic<int> pending_;
+    std::atomic<unsigned int> next_;
+    int cores_per_worker_;
+    bool stop_;
+};
+
+}    // namespace dragon
+
+#endif    // DRAGON_UTILS_THREAD_POOL_H_
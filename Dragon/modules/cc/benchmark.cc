@@ -0,0 +1,165 @@
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+
+#include "dragon.h"
+
+/**************************************************************************
+ *  dragon_benchmark: run a graph with random inputs and report latency.
+ *
+ *  Usage:
+ *    dragon_benchmark --graph=net.pbtxt --input=data:1,3,224,224
+ *                     [--input=...] [--model=net.dragonmodel]
+ *                     [--caffemodel=net.caffemodel] [--device=CPU|CUDA:0]
+ *                     [--warmup=10] [--iters=100] [--log_level=ERROR]
+ *
+ *  The first dimension of the first input is taken as the batch size.
+ *************************************************************************/
+
+namespace {
+
+struct Input {
+    std::string name;
+    std::vector<dragon::TIndex> shape;
+};
+
+bool ParseFlag(const char* arg, const char* name, std::string* value) {
+    size_t len = strlen(name);
+    if (strncmp(arg, name, len) != 0 || arg[len] != '=') return false;
+    *value = std::string(arg + len + 1);
+    return true;
+}
+
+bool ParseInput(const std::string& str, Input* input) {
+    size_t pos = str.rfind(':');
+    if (pos == std::string::npos || pos == 0) return false;
+    input->name = str.substr(0, pos);
+    std::stringstream ss(str.substr(pos + 1));
+    std::string dim;
+    while (std::getline(ss, dim, ',')) {
+        dragon::TIndex d = atoll(dim.c_str());
+        if (d <= 0) return false;
+        input->shape.push_back(d);
+    }
+    return !input->shape.empty();
+}
+
+double Percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t idx = (size_t)(p / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+void Usage() {
+    fprintf(stderr,
+        "Usage: dragon_benchmark --graph=<file> --input=<name>:<d0,d1,...>\n"
+        "       [--input=...] [--model=<file>] [--caffemodel=<file>]\n"
+        "       [--device=CPU|CUDA:<id>] [--warmup=10] [--iters=100]\n"
+        "       [--log_level=ERROR]\n");
+}
+
+}    // namespace
+
+int main(int argc, char** argv) {
+    std::string graph_file, model_file, caffemodel_file;
+    std::string device_str = "CPU", log_level = "ERROR", value;
+    std::vector<Input> inputs;
+    int warmup = 10, iters = 100;
+
+    for (int i = 1; i < argc; i++) {
+        if (ParseFlag(argv[i], "--graph", &value)) graph_file = value;
+        else if (ParseFlag(argv[i], "--model", &value)) model_file = value;
+        else if (ParseFlag(argv[i], "--caffemodel", &value)) caffemodel_file = value;
+        else if (ParseFlag(argv[i], "--device", &value)) device_str = value;
+        else if (ParseFlag(argv[i], "--warmup", &value)) warmup = atoi(value.c_str());
+        else if (ParseFlag(argv[i], "--iters", &value)) iters = atoi(value.c_str());
+        else if (ParseFlag(argv[i], "--log_level", &value)) log_level = value;
+        else if (ParseFlag(argv[i], "--input", &value)) {
+            Input input;
+            if (!ParseInput(value, &input)) {
+                fprintf(stderr, "Invalid input: %s\n", value.c_str());
+                return 1;
+            }
+            inputs.push_back(input);
+        } else {
+            fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            Usage();
+            return 1;
+        }
+    }
+    if (graph_file.empty() || iters <= 0 || warmup < 0) {
+        Usage();
+        return 1;
+    }
+
+    dragon::SetLogLevel(log_level);
+    dragon::Device device;
+    if (device_str.compare(0, 4, "CUDA") == 0) {
+        int device_id = device_str.size() > 5 ? atoi(device_str.c_str() + 5) : 0;
+        device = dragon::Device("CUDA", device_id);
+    } else {
+        device = dragon::Device("CPU");
+    }
+
+    dragon::Workspace* ws = dragon::CreateWorkspace("benchmark");
+    if (!model_file.empty()) dragon::LoadDragonmodel(model_file, ws);
+    if (!caffemodel_file.empty()) dragon::LoadCaffemodel(caffemodel_file, ws);
+
+    //  feed the random inputs before creating,
+    //  the graph checks the existence of inputs
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> uniform(-1.f, 1.f);
+    for (auto& input : inputs) {
+        dragon::TIndex count = 1;
+        for (auto d : input.shape) count *= d;
+        std::vector<float> data(count);
+        for (auto& x : data) x = uniform(rng);
+        dragon::FeedTensor(input.name, input.shape, data.data(), device, ws);
+    }
+
+    std::string graph_name = device_str == "CPU" ?
+        dragon::CreateGraph(graph_file, ws) :
+            dragon::CreateGraph(graph_file, device, ws);
+
+    for (int i = 0; i < warmup; i++) dragon::RunGraph(graph_name, ws);
+
+    std::vector<double> latencies;
+    auto total_start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; i++) {
+        auto start = std::chrono::steady_clock::now();
+        dragon::RunGraph(graph_name, ws);
+        auto end = std::chrono::steady_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    double total_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - total_start).count();
+
+    std::sort(latencies.begin(), latencies.end());
+    double mean = 0.0;
+    for (auto t : latencies) mean += t;
+    mean /= latencies.size();
+    dragon::TIndex batch_size = inputs.empty() ? 1 : inputs[0].shape[0];
+
+    printf("Graph:       %s\n", graph_name.c_str());
+    printf("Device:      %s\n", device_str.c_str());
+    printf("Iterations:  %d (warmup: %d)\n", iters, warmup);
+    printf("Latency(ms): mean %.3f, min %.3f, p50 %.3f, p90 %.3f, p99 %.3f, max %.3f\n",
+        mean, latencies.front(), Percentile(latencies, 50), Percentile(latencies, 90),
+        Percentile(latencies, 99), latencies.back());
+    printf("Throughput:  %.2f iters/s, %.2f samples/s\n",
+        iters * 1e3 / total_ms, iters * batch_size * 1e3 / total_ms);
+#ifndef _WIN32
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    printf("Peak RSS:    %.2f MB\n", usage.ru_maxrss / 1024.0);
+#endif
+    return 0;
+}
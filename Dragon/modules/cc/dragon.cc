@@ -10,6 +10,7 @@
 #include "core/common.h"
 #include "core/workspace.h"
 #include "utils/caffemodel.h"
+#include "utils/checkpoint.h"
 
 namespace dragon {
 
@@ -24,7 +25,7 @@ Workspace* CreateWorkspace(const std::string& name){
     unique_ptr<Workspace> new_workspace(new Workspace(name));
     g_workspaces[name] = std::move(new_workspace);
     sub_workspaces[name] = vector<string>();
-    return new_workspace.get();
+    return g_workspaces[name].get();
 }
 
 Workspace* ResetWorkspace(const std::string& name) {
@@ -159,6 +160,11 @@ void TransplantCaffeModel(const std::string& input_model, const std::string& out
 }
 
 void LoadDragonmodel(const std::string& model_file, Workspace* ws){
+    //  map the binary checkpoint instead of parsing the protos
+    if (IsCheckpoint(model_file)) {
+        LoadCheckpoint(model_file, ws, true);
+        return;
+    }
     TensorProtos tensors;
     ReadProtoFromBinaryFile(model_file.c_str(), &tensors);
     LOG(INFO) << "Restore From Model @: " << model_file << "......";
@@ -263,6 +269,28 @@ T* FetchTensor(const std::string& name,
     return static_cast<T*>(data);
 }
 
+template EXPORT float* FetchTensor(const std::string&,
+                                   std::vector<TIndex>&,
+                                   Workspace*);
+
+template EXPORT void FeedTensor(const std::string&,
+                                const std::vector<TIndex>&,
+                                const float*,
+                                const Device&,
+                                Workspace*);
+
+template EXPORT void FeedTensor(const std::string&,
+                                const std::vector<TIndex>&,
+                                const int*,
+                                const Device&,
+                                Workspace*);
+
+template EXPORT void FeedTensor(const std::string&,
+                                const std::vector<TIndex>&,
+                                const uint8_t*,
+                                const Device&,
+                                Workspace*);
+
 void SetLogLevel(const std::string& level) {
     SetLogDestination(StrToLogSeverity(level));
 }
@@ -72,28 +72,6 @@ T* FetchTensor(const std::string& name,
                std::vector<TIndex>& shape,
                Workspace* ws);
 
-template EXPORT float* FetchTensor(const std::string&,
-                                   std::vector<TIndex>&,
-                                   Workspace*);
-
-template EXPORT void FeedTensor(const std::string&,
-                                const std::vector<TIndex>&,
-                                const float*,
-                                const Device&,
-                                Workspace*);
-
-template EXPORT void FeedTensor(const std::string&,
-                                const std::vector<TIndex>&,
-                                const int*,
-                                const Device&,
-                                Workspace*);
-
-template EXPORT void FeedTensor(const std::string&,
-                                const std::vector<TIndex>&,
-                                const uint8_t*,
-                                const Device&,
-                                Workspace*);
-
 EXPORT void LoadCaffemodel(const std::string& model_file, Workspace* ws);
 
 EXPORT void TransplantCaffeModel(const std::string& input_model, const std::string& output_model);
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include <google/protobuf/text_format.h>
+
+#include "core/graph.h"
+#include "core/graph_gradient.h"
+#include "core/workspace.h"
+
+/**************************************************************************
+ *  fused_elementwise_test: compare the FusedElementwise with the plain
+ *  elementwise operators it replaces, on both the forward and the gradient,
+ *  for the same, column, row and scalar broadcasts of the second inputs.
+ *************************************************************************/
+
+using namespace dragon;
+
+namespace {
+
+const char* kForward =
+    "op { type: 'Mul' name: 'mul' input: 'x' input: 'b' output: 't1' } "
+    "op { type: 'Tanh' name: 'tanh' input: 't1' output: 't2' } "
+    "op { type: 'Sub' name: 'sub' input: 't2' input: 'c' output: 't3' } "
+    "op { type: 'Div' name: 'div' input: 't3' input: 'd' output: 'y' } "
+    "target: 'y' ";
+
+const char* kOutputs[] = { "y", "x_grad", "b_grad", "c_grad", "d_grad" };
+
+void Fill(Workspace* ws, const string& name, const vector<TIndex>& dims,
+          float low, float high, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> uniform(low, high);
+    Tensor* tensor = ws->CreateTensor(name);
+    tensor->Reshape(dims);
+    auto* data = tensor->mutable_data<float, CPUContext>();
+    for (int i = 0; i < tensor->count(); i++) data[i] = uniform(rng);
+}
+
+//  run the forward and backward of the operators in a fresh workspace
+vector< vector<float> > Evaluate(const GraphDef& forward_def,
+                                 const vector<TIndex>& bcast_dims) {
+    Workspace ws("fused_elementwise_test");
+    Fill(&ws, "x", { 4, 5 }, -1.f, 1.f, 1);
+    Fill(&ws, "b", bcast_dims, -1.f, 1.f, 2);
+    Fill(&ws, "c", bcast_dims, -1.f, 1.f, 3);
+    Fill(&ws, "d", bcast_dims, 0.5f, 2.f, 4);
+    Fill(&ws, "y_grad", { 4, 5 }, -1.f, 1.f, 5);
+
+    GraphGradientMaker maker(forward_def, { "y" });
+    maker.SetOperatorPrefix("GradientOps(");
+    maker.SetOperatorSuffix(")");
+    maker.AddExternalGrad("y_grad");
+    GraphDef backward_def = maker.Make();
+
+    GraphDef graph_def(forward_def);
+    graph_def.set_name("fused_elementwise_test");
+    graph_def.MergeFrom(backward_def);
+    graph_def.clear_target();
+    for (auto* name : kOutputs) graph_def.add_target(name);
+    ws.CreateGraph(graph_def);
+    ws.RunGraph(graph_def.name(), "", "");
+
+    vector< vector<float> > results;
+    for (auto* name : kOutputs) {
+        Tensor* tensor = ws.GetTensor(name);
+        auto* data = tensor->data<float, CPUContext>();
+        results.emplace_back(data, data + tensor->count());
+    }
+    return results;
+}
+
+}    // namespace
+
+int main() {
+    GraphDef forward_def;
+    google::protobuf::TextFormat::ParseFromString(kForward, &forward_def);
+    GraphDef fused_def = FuseElementwise(forward_def);
+    if (fused_def.op_size() != 1 || fused_def.op(0).type() != "FusedElementwise") {
+        fprintf(stderr, "The elementwise operators are not fused.\n");
+        return 1;
+    }
+
+    const vector< pair<string, vector<TIndex> > > cases = {
+        { "same", { 4, 5 } }, { "column", { 4, 1 } },
+        { "row", { 5 } }, { "scalar", { 1 } } };
+    int num_failures = 0;
+    for (auto& bcast : cases) {
+        auto expected = Evaluate(forward_def, bcast.second);
+        auto actual = Evaluate(fused_def, bcast.second);
+        for (int i = 0; i < expected.size(); i++) {
+            float max_err = expected[i].size() == actual[i].size() ? 0.f : INFINITY;
+            for (int j = 0; j < expected[i].size() && j < actual[i].size(); j++)
+                max_err = std::max(max_err, std::fabs(expected[i][j] - actual[i][j]));
+            bool passed = max_err < 1e-5f;
+            printf("[%s] %s/%s: max error = %.2e\n", passed ? "  OK  " : "FAILED",
+                bcast.first.c_str(), kOutputs[i], max_err);
+            if (!passed) num_failures++;
+        }
+    }
+    return num_failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+#include <cstdio>
+
+#include <google/protobuf/text_format.h>
+
+#include "core/graph.h"
+#include "core/workspace.h"
+
+/**************************************************************************
+ *  infer_shapes_test: compare the shapes inferred statically by InferShapes
+ *  with those fetched after running a small graph, and check the invalid
+ *  shapes of inputs are reported instead of being fatal.
+ *************************************************************************/
+
+using namespace dragon;
+
+namespace {
+
+const char* kGraph =
+    "name: 'infer_shapes_test' "
+    "op { type: 'Relu' name: 'relu' input: 'x' output: 'a' } "
+    "op { type: 'Concat' name: 'concat' input: 'a' input: 'x' output: 'b' "
+    "     arg { name: 'axis' i: 1 } arg { name: 'num_input' i: 2 } } "
+    "op { type: 'Reshape' name: 'reshape' input: 'b' output: 'c' "
+    "     arg { name: 'shape' ints: 0 ints: -1 } } "
+    "op { type: 'Add' name: 'add' input: 'c' input: 'bias' output: 'd' } "
+    "op { type: 'Transpose' name: 'transpose' input: 'd' output: 'e' "
+    "     arg { name: 'perms' ints: 1 ints: 0 } } "
+    "op { type: 'Reduce' name: 'reduce' input: 'e' output: 'f' "
+    "     arg { name: 'axis' i: 0 } arg { name: 'operation' s: 'SUM' } } "
+    "op { type: 'Pooling2d' name: 'pool' input: 'x' output: 'g' "
+    "     arg { name: 'kernel_size' ints: 2 } arg { name: 'stride' ints: 2 } "
+    "     arg { name: 'pad' ints: 0 } } "
+    "op { type: 'Slice' name: 'slice' input: 'g' output: 'h1' output: 'h2' "
+    "     arg { name: 'axis' i: 2 } arg { name: 'num_output' i: 2 } } "
+    "target: 'f' target: 'h1' target: 'h2' "
+    "arg { name: 'phase' s: 'TEST' } ";
+
+const char* kInvalidOps[] = {
+    "op { type: 'Concat' name: 'concat' input: 'x' input: 'x' output: 'y' "
+    "     arg { name: 'axis' i: 4 } arg { name: 'num_input' i: 2 } } ",
+    "op { type: 'Concat' name: 'concat' input: 'x' input: 'bias' output: 'y' "
+    "     arg { name: 'axis' i: 0 } arg { name: 'num_input' i: 2 } } ",
+    "op { type: 'Reshape' name: 'reshape' input: 'x' output: 'y' "
+    "     arg { name: 'shape' ints: 7 ints: -1 } } ",
+    "op { type: 'Add' name: 'add' input: 'x' input: 'bias' output: 'y' } ",
+    "op { type: 'Pooling2d' name: 'pool' input: 'bias' output: 'y' "
+    "     arg { name: 'kernel_size' ints: 2 } arg { name: 'stride' ints: 2 } "
+    "     arg { name: 'pad' ints: 0 } } ",
+};
+
+void Fill(Workspace* ws, const string& name, const vector<TIndex>& dims) {
+    Tensor* tensor = ws->CreateTensor(name);
+    tensor->Reshape(dims);
+    auto* data = tensor->mutable_data<float, CPUContext>();
+    for (int i = 0; i < tensor->count(); i++) data[i] = float(i % 7) - 3.f;
+}
+
+string ShapeString(const vector<TIndex>& dims) {
+    string str = "(";
+    for (int i = 0; i < (int)dims.size(); i++)
+        str += dragon_cast<string, int>((int)dims[i]) + (i < (int)dims.size() - 1 ? "," : "");
+    return str + ")";
+}
+
+}    // namespace
+
+int main() {
+    Workspace ws("infer_shapes_test");
+    Fill(&ws, "x", { 2, 3, 4, 6 });
+    Fill(&ws, "bias", { 144 });
+    int num_failures = 0;
+
+    //  the shapes are inferred before running
+    GraphDef graph_def;
+    google::protobuf::TextFormat::ParseFromString(kGraph, &graph_def);
+    string error;
+    Map<string, TensorProto> shapes = InferShapes(graph_def, &ws, &error);
+    if (!error.empty()) {
+        printf("[FAILED] unexpected error: %s\n", error.c_str());
+        num_failures++;
+    }
+    ws.CreateGraph(graph_def);
+    ws.RunGraph(graph_def.name(), "", "");
+    for (auto& op : graph_def.op()) {
+        for (auto& output : op.output()) {
+            vector<TIndex> fetched = ws.GetTensor(output)->dims();
+            vector<TIndex> inferred;
+            if (shapes.count(output)) inferred = TensorDims(shapes[output]);
+            bool passed = shapes.count(output) && inferred == fetched;
+            printf("[%s] %s(%s): inferred %s, fetched %s\n", passed ? "  OK  " : "FAILED",
+                op.type().c_str(), output.c_str(), ShapeString(inferred).c_str(),
+                ShapeString(fetched).c_str());
+            if (!passed) num_failures++;
+        }
+    }
+
+    //  the invalid shapes are reported by the error
+    for (auto* invalid_op : kInvalidOps) {
+        GraphDef invalid_def;
+        google::protobuf::TextFormat::ParseFromString(invalid_op, &invalid_def);
+        string invalid_error;
+        InferShapes(invalid_def, &ws, &invalid_error);
+        bool passed = !invalid_error.empty();
+        printf("[%s] %s: %s\n", passed ? "  OK  " : "FAILED",
+            invalid_def.op(0).type().c_str(), invalid_error.c_str());
+        if (!passed) num_failures++;
+    }
+    return num_failures > 0 ? 1 : 0;
+}
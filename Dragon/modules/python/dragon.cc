@@ -2,6 +2,7 @@
 #include "py_mpi.h"
 
 #include "utils/caffemodel.h"
+#include "utils/checkpoint.h"
 #include "utils/logging.h"
 
 DEFINE_TYPED_REGISTRY(TensorFetcherRegistry, TypeId, TensorFetcherBase);
@@ -9,8 +10,80 @@ DEFINE_TYPED_REGISTRY(TensorFeederRegistry, TypeId, TensorFeederBase);
 
 Map<string, unique_ptr < Workspace > > g_workspaces;
 Map<string, vector<string> > sub_workspaces;
-Workspace* g_workspace;
+//  the workspaces are switched per thread, the threads which never switch
+//  follow the importing thread (all of them are guarded by the GIL)
 string g_current_workspace;
+thread_local string t_current_workspace;
+std::thread::id g_main_thread;
+
+const string& CurrentWorkspaceName() {
+    return t_current_workspace.empty() ?
+        g_current_workspace : t_current_workspace;
+}
+
+Workspace* CurrentWorkspace() {
+    return g_workspaces[CurrentWorkspaceName()].get();
+}
+
+//  the native callings using a workspace without the GIL,
+//  a reset, clear or move of the workspace waits them to finish
+struct WorkspaceUsers {
+    std::mutex mutex;
+    std::condition_variable cond;
+    int count = 0;
+};
+Map<string, WorkspaceUsers> g_workspace_users;
+
+class ScopedWorkspaceUse {
+ public:
+    //  enter with the GIL held
+    explicit ScopedWorkspaceUse(const string& name)
+        : users(&g_workspace_users[name]) {
+        std::lock_guard<std::mutex> lock(users->mutex);
+        users->count++;
+    }
+    ~ScopedWorkspaceUse() {
+        std::lock_guard<std::mutex> lock(users->mutex);
+        if (--users->count == 0) users->cond.notify_all();
+    }
+
+ private:
+    WorkspaceUsers* users;
+};
+
+//  wait without the GIL, which is held again at the return,
+//  so that no one could use the workspace before it is released
+void WaitWorkspaceUsers(const string& name) {
+    WorkspaceUsers& users = g_workspace_users[name];
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(users.mutex);
+            if (users.count == 0) return;
+        }
+        ScopedGILRelease no_gil;
+        std::unique_lock<std::mutex> lock(users.mutex);
+        users.cond.wait(lock, [&users]() { return users.count == 0; });
+    }
+}
+
+//  the workspaces moved into others are read by them also
+void WaitWorkspaceReaders(const string& name) {
+    vector<string> readers(1, name);
+    for (auto& it : sub_workspaces)
+        for (auto& sub_workspace : it.second)
+            if (sub_workspace == name) readers.push_back(it.first);
+    //  the GIL may be released by waiting, check all of them again
+    bool idle = false;
+    while (!idle) {
+        for (auto& reader : readers) WaitWorkspaceUsers(reader);
+        idle = true;
+        for (auto& reader : readers) {
+            auto& users = g_workspace_users[reader];
+            std::lock_guard<std::mutex> lock(users.mutex);
+            idle &= users.count == 0;
+        }
+    }
+}
 
 int DragonToNumpyType(const TypeMeta& meta) {
     static Map<TypeId, int> numpy_type_map{
@@ -116,21 +189,66 @@ PyObject* CreateGradientDefsCC(PyObject* self, PyObject* args) {
     return PyTuple_Pack(3, g_ops_py, g_input_py, defaults_py);
 }
 
+PyObject* FuseElementwiseCC(PyObject* self, PyObject* args) {
+    PyObject* graph_str;
+    if (!PyArg_ParseTuple(args, "S", &graph_str)) {
+        PyErr_SetString(PyExc_ValueError, "You should provide a serialized string of GraphDef.");
+        return nullptr;
+    }
+    GraphDef graph_def;
+    if (!graph_def.ParseFromString(PyBytesToStdString(graph_str))) {
+        PyErr_SetString(PyExc_RuntimeError, "Failed to parse the GraphDef.");
+        return nullptr;
+    }
+    return StdStringToPyBytes(FuseElementwise(graph_def).SerializeAsString());
+}
+
+PyObject* InferShapesCC(PyObject* self, PyObject* args) {
+    PyObject* graph_str;
+    if (!PyArg_ParseTuple(args, "S", &graph_str)) {
+        PyErr_SetString(PyExc_ValueError, "You should provide a serialized string of GraphDef.");
+        return nullptr;
+    }
+    GraphDef graph_def;
+    if (!graph_def.ParseFromString(PyBytesToStdString(graph_str))) {
+        PyErr_SetString(PyExc_RuntimeError, "Failed to parse the GraphDef.");
+        return nullptr;
+    }
+    static const Map<int, string> dtypes {
+        { TensorProto::FLOAT, "float32" }, { TensorProto::FLOAT16, "float16" },
+        { TensorProto::INT32, "int32" }, { TensorProto::BYTE, "uint8" }};
+    string error;
+    Map<string, TensorProto> shapes = InferShapes(graph_def, CurrentWorkspace(), &error);
+    if (!error.empty()) {
+        PyErr_SetString(PyExc_ValueError, error.c_str());
+        return nullptr;
+    }
+    PyObject* dict = PyDict_New();
+    for (auto& it : shapes) {
+        PyObject* dims = PyList_New(it.second.dims_size());
+        for (int i = 0; i < it.second.dims_size(); i++)
+            CHECK_EQ(PyList_SetItem(dims, i, PyLong_FromLongLong(it.second.dims(i))), 0);
+        const string dtype = dtypes.count(it.second.data_type()) ?
+            dtypes.at(it.second.data_type()) : "unknown";
+        PyObject* dtype_py = StdStringToPyUnicode(dtype);
+        PyObject* value = PyTuple_Pack(2, dims, dtype_py);
+        Py_DECREF(dims); Py_DECREF(dtype_py);
+        CHECK_EQ(PyDict_SetItemString(dict, it.first.c_str(), value), 0);
+        Py_DECREF(value);
+    }
+    return dict;
+}
+
+
 bool SwitchWorkspaceInternal(const string& name, const bool create_if_missing) {
-    if (g_workspaces.count(name)) {
-        g_current_workspace = name;
-        g_workspace = g_workspaces[name].get();
-        return true;
-    } else if (create_if_missing) {
-        unique_ptr<Workspace> new_workspace(new Workspace(name));
-        g_workspace = new_workspace.get();
-        g_workspaces[name] = std::move(new_workspace);
+    if (!g_workspaces.count(name)) {
+        if (!create_if_missing) return false;
+        g_workspaces[name].reset(new Workspace(name));
         sub_workspaces[name] = vector<string>();
-        g_current_workspace = name;
-        return true;
-    } else {
-        return false;
     }
+    if (std::this_thread::get_id() == g_main_thread) g_current_workspace = name;
+    else t_current_workspace = name;
+    return true;
 }
 
 PyObject* SwitchWorkspaceCC(PyObject* self, PyObject *args) {
@@ -160,6 +278,7 @@ PyObject* MoveWorkspaceCC(PyObject* self, PyObject *args) {
         << "\nThe source Workspace(" << src_ws << ") does not exist.";
     CHECK(g_workspaces.count(target_ws))
         << "\nThe target Workspace(" << target_ws << ") does not exist.";
+    WaitWorkspaceReaders(string(target_ws));
     g_workspaces[target_ws]->MoveWorkspace(g_workspaces[src_ws].get());
     sub_workspaces[target_ws].push_back(string(src_ws));
     LOG(INFO) << "Move the Workspace(" << src_ws << ") into the "
@@ -168,7 +287,7 @@ PyObject* MoveWorkspaceCC(PyObject* self, PyObject *args) {
 }
 
 PyObject* CurrentWorkspaceCC(PyObject* self, PyObject* args) { 
-    return StdStringToPyUnicode(g_current_workspace);
+    return StdStringToPyUnicode(CurrentWorkspaceName());
 }
 
 PyObject* WorkspacesCC(PyObject* self, PyObject* args) {
@@ -185,16 +304,16 @@ PyObject* ResetWorkspaceCC(PyObject* self, PyObject* args) {
         PyErr_SetString(PyExc_ValueError, "You should provide a name to locate the workspace.");
         return nullptr;
     }
-    string target_workspace = g_current_workspace;
+    string target_workspace = CurrentWorkspaceName();
     if (!string(cname).empty()) target_workspace = string(cname);
     CHECK(g_workspaces.count(target_workspace))
         << "\nWorkspace(" << target_workspace << ") does not exist, can not be reset.";
+    WaitWorkspaceReaders(target_workspace);
     LOG(INFO) << "Reset the Workspace(" << target_workspace << ")";
     g_workspaces[target_workspace].reset(new Workspace(target_workspace));
-    g_workspace = g_workspaces[target_workspace].get();
     for (auto& sub_workspace : sub_workspaces[target_workspace]) {
         if (g_workspaces.count(sub_workspace) > 0)
-            g_workspace->MoveWorkspace(g_workspaces[sub_workspace].get());
+            g_workspaces[target_workspace]->MoveWorkspace(g_workspaces[sub_workspace].get());
     }
     Py_RETURN_TRUE;
 }
@@ -205,17 +324,32 @@ PyObject* ClearWorkspaceCC(PyObject* self, PyObject* args) {
         PyErr_SetString(PyExc_ValueError, "You should provide a name to locate the workspace.");
         return nullptr;
     }
-    string target_workspace = g_current_workspace;
+    string target_workspace = CurrentWorkspaceName();
     if (!string(cname).empty()) target_workspace = string(cname);
     CHECK(g_workspaces.count(target_workspace))
         << "\nWorkspace(" << target_workspace << ") does not exist, can not be reset.";
+    WaitWorkspaceReaders(target_workspace);
     LOG(INFO) << "Clear the Workspace(" << target_workspace << ")";
     g_workspaces[target_workspace]->ClearWorkspace();
     Py_RETURN_TRUE;
 }
 
+PyObject* TrimMemoryCC(PyObject* self, PyObject* args) {
+    CurrentWorkspace()->TrimMemory();
+    Py_RETURN_TRUE;
+}
+
+PyObject* MemoryStatsCC(PyObject* self, PyObject* args) {
+    CPUAllocator::Stats stats = CurrentWorkspace()->GetMemoryStats();
+    return Py_BuildValue("{s:L,s:L,s:L,s:L}",
+        "hits", (long long)stats.hits,
+        "misses", (long long)stats.misses,
+        "bytes_cached", (long long)stats.bytes_cached,
+        "bytes_in_use", (long long)stats.bytes_in_use);
+}
+
 PyObject* TensorsCC(PyObject* self, PyObject* args) {
-    vector<string> tensor_strings = g_workspace->GetTensors();
+    vector<string> tensor_strings = CurrentWorkspace()->GetTensors();
     PyObject* list = PyList_New(tensor_strings.size());
     for (int i = 0; i < tensor_strings.size(); i++)
         CHECK_EQ(PyList_SetItem(list, i, StdStringToPyUnicode(tensor_strings[i])), 0);
@@ -228,7 +362,7 @@ PyObject* CreateTensorCC(PyObject* self, PyObject* args) {
         PyErr_SetString(PyExc_ValueError, "You shoule provide a tensor name.");
         return nullptr;
     }
-    g_workspace->CreateTensor(string(cname));
+    CurrentWorkspace()->CreateTensor(string(cname));
     Py_RETURN_TRUE;
 }
 
@@ -243,22 +377,22 @@ PyObject* CreateFillerCC(PyObject* self, PyObject* args) {
         PyErr_SetString(PyExc_RuntimeError, "Failed to parse the TensorFiller.");
         return nullptr;
     }
-    g_workspace->CreateFiller(filler_def);
-    g_workspace->CreateTensor(filler_def.tensor());
+    CurrentWorkspace()->CreateFiller(filler_def);
+    CurrentWorkspace()->CreateTensor(filler_def.tensor());
     Py_RETURN_TRUE;
 }
 
 PyObject* HasTensorCC(PyObject* self, PyObject* args) {
     char* cname;
     if (!PyArg_ParseTuple(args, "s", &cname)) return nullptr;
-    if (g_workspace->HasTensor(string(cname))) Py_RETURN_TRUE;
+    if (CurrentWorkspace()->HasTensor(string(cname))) Py_RETURN_TRUE;
     else Py_RETURN_FALSE;
 }
 
 PyObject* GetTensorNameCC(PyObject* self, PyObject* args) {
     char* cname;
     if (!PyArg_ParseTuple(args, "s", &cname)) return nullptr;
-    string query = g_workspace->GetTensorName(string(cname));
+    string query = CurrentWorkspace()->GetTensorName(string(cname));
     return StdStringToPyUnicode(query);
 }
 
@@ -273,7 +407,7 @@ PyObject* CreateGraphCC(PyObject* self, PyObject* args) {
         PyErr_SetString(PyExc_RuntimeError, "Failed to parse the GraphDef.");
         return nullptr;
     } 
-    if (!g_workspace->CreateGraph(graph_def)) {
+    if (!CurrentWorkspace()->CreateGraph(graph_def)) {
         PyErr_SetString(PyExc_RuntimeError, "Failed to create the Graph.");
         return nullptr;
     }
@@ -286,7 +420,13 @@ PyObject* RunGraphCC(PyObject* self, PyObject* args) {
         PyErr_SetString(PyExc_ValueError, "You should provide a graph name, include and exclude rules.");
         return nullptr;
     }
-    bool result = g_workspace->RunGraph(string(cname), string(include), string(exclude));
+    Workspace* ws = CurrentWorkspace();
+    ScopedWorkspaceUse use(CurrentWorkspaceName());
+    bool result;
+    {
+        ScopedGILRelease no_gil;
+        result = ws->RunGraph(string(cname), string(include), string(exclude));
+    }
     if (!result) {
         PyErr_SetString(PyExc_RuntimeError, "Failed to run the Graph.");
         return nullptr;
@@ -295,7 +435,7 @@ PyObject* RunGraphCC(PyObject* self, PyObject* args) {
 }
 
 PyObject* GraphsCC(PyObject* self, PyObject* args) {
-    vector<string> graph_string = g_workspace->GetGraphs();
+    vector<string> graph_string = CurrentWorkspace()->GetGraphs();
     PyObject* list = PyList_New(graph_string.size());
     for (int i = 0; i < graph_string.size(); i++)
         CHECK_EQ(PyList_SetItem(list, i, StdStringToPyUnicode(graph_string[i])), 0);
@@ -304,21 +444,23 @@ PyObject* GraphsCC(PyObject* self, PyObject* args) {
 
 PyObject* FetchTensorCC(PyObject* self, PyObject* args) {
     char* cname;
-    if (!PyArg_ParseTuple(args, "s", &cname)) {
+    int copy = 1;
+    if (!PyArg_ParseTuple(args, "s|i", &cname, &copy)) {
         PyErr_SetString(PyExc_ValueError, "You should provide a tensor name.");
         return nullptr;
     }
-    if (!g_workspace->HasTensor(string(cname))) {
+    if (!CurrentWorkspace()->HasTensor(string(cname))) {
         PyErr_SetString(PyExc_ValueError, "Tensor does not exist. Have you solved it ?");
         return nullptr;
     }
-    Tensor* tensor = g_workspace->GetTensor(string(cname));
+    Tensor* tensor = CurrentWorkspace()->GetTensor(string(cname));
+    ScopedWorkspaceUse use(CurrentWorkspaceName());
     TypeId type_id = CTypeToFetcher(tensor->meta().id());
     CHECK(type_id != 0) << "\nTensor(" << tensor->name()
                         << ") has not been computed yet.";
     unique_ptr<TensorFetcherBase> fetcher(CreateFetcher(type_id));
     if (fetcher.get()) {
-        return fetcher->Fetch(*tensor);  // copy the tensor data to a numpy object
+        return fetcher->Fetch(*tensor, copy != 0);  // copy or view the tensor data as a numpy object
     } else {
         LOG(INFO) << string(cname) << " is not a C++ native type.";
         return nullptr;
@@ -329,7 +471,8 @@ PyObject* FeedTensorCC(PyObject* self, PyObject* args) {
     char* cname;
     PyArrayObject* array = nullptr;
     PyObject *device_option = nullptr;
-    if (!PyArg_ParseTuple(args, "sO|O", &cname, &array, &device_option)) {
+    int copy = 1;
+    if (!PyArg_ParseTuple(args, "sO|Oi", &cname, &array, &device_option, &copy)) {
         PyErr_SetString(PyExc_ValueError, "You should provide a name, values and serialized DeviceOption.");
         return nullptr;
     }
@@ -340,10 +483,11 @@ PyObject* FeedTensorCC(PyObject* self, PyObject* args) {
             return nullptr;
         }
     }
-    Tensor* tensor = g_workspace->CreateTensor(string(cname));
+    Tensor* tensor = CurrentWorkspace()->CreateTensor(string(cname));
+    ScopedWorkspaceUse use(CurrentWorkspaceName());
     unique_ptr<TensorFeederBase> feeder(TensorFeederRegistry()->Create(TypeMeta::Id<NumpyFeeder>()));
     if (feeder.get()) {
-        return feeder->Feed(option, array, tensor);
+        return feeder->Feed(option, array, tensor, copy != 0);
     } else {
         PyErr_SetString(PyExc_TypeError, "Unknown device type.");
         return nullptr;
@@ -357,38 +501,93 @@ PyObject* RestoreCC(PyObject* self, PyObject* args) {
         PyErr_SetString(PyExc_ValueError, "You should provide a model path and the format.");
         return nullptr;
     }
+    Workspace* ws = CurrentWorkspace();
+    ScopedWorkspaceUse use(CurrentWorkspaceName());
+    ScopedGILRelease no_gil;
     switch (format) {
         case 0:    // cPickle
+            no_gil.Acquire();
             PyErr_SetString(PyExc_NotImplementedError, "This format depends on cPickle. Can't be used in C++.");
-            break;
+            return nullptr;
         case 1:    // caffe
-            LoadCaffeModel(string(cname), g_workspace);
+            LoadCaffeModel(string(cname), ws);
+            break;
+        case 2:    // binary
+            LoadCheckpoint(string(cname), ws, false);
             break;
         default: LOG(FATAL) << "Unknwon format, code: " << format;
     }
+    no_gil.Acquire();
     Py_RETURN_TRUE;
 }
 
+//  the pending snapshots in background, by the path
+Map<string, unique_ptr<AsyncCheckpoint> > g_snapshots;
+
 PyObject* SnapshotCC(PyObject* self, PyObject* args) {
     char* cname;
-    int format;
+    int format, async = 0;
     PyObject* names; vector<Tensor*> tensors;
-    if (!PyArg_ParseTuple(args, "sOi", &cname, &names, &format)) {
+    if (!PyArg_ParseTuple(args, "sOi|i", &cname, &names, &format, &async)) {
         PyErr_SetString(PyExc_ValueError, "You should provide a model path, tensor names, and the format.");
         return nullptr;
     }
+    AsyncCheckpoint::SaveFunction save_func;
     switch (format) {
         case 0:    //  cPickle
             PyErr_SetString(PyExc_NotImplementedError, "This format depends on cPickle. Can't be used in C++.");
-            break;
+            return nullptr;
         case 1:    //  caffe
-            for (int i = 0; i < PyList_Size(names); i++)
-                tensors.push_back(g_workspace->GetTensor(PyString_AsString(PyList_GetItem(names, i))));
-            SavaCaffeModel(string(cname), tensors);
+            save_func = SavaCaffeModel;
+            break;
+        case 2:    //  binary
+            save_func = SaveCheckpoint;
             break;
         default: LOG(FATAL) << "Unknwon format, code: " << format;
-   }
-   Py_RETURN_TRUE;
+    }
+    for (int i = 0; i < PyList_Size(names); i++)
+        tensors.push_back(CurrentWorkspace()->GetTensor(PyString_AsString(PyList_GetItem(names, i))));
+    const string file(cname);
+    ScopedWorkspaceUse use(CurrentWorkspaceName());
+    if (async) {
+        //  the former snapshot of this path should be committed first,
+        //  and the committed snapshots of other paths are released
+        vector<unique_ptr<AsyncCheckpoint> > finished;
+        for (auto it = g_snapshots.begin(); it != g_snapshots.end();) {
+            if (it->first != file && it->second->done()) {
+                finished.push_back(std::move(it->second));
+                it = g_snapshots.erase(it);
+            } else { ++it; }
+        }
+        unique_ptr<AsyncCheckpoint> former = std::move(g_snapshots[file]), current;
+        {
+            ScopedGILRelease no_gil;
+            finished.clear();
+            former.reset();
+            current.reset(new AsyncCheckpoint(file, tensors, save_func));
+        }
+        g_snapshots[file] = std::move(current);
+    } else {
+        ScopedGILRelease no_gil;
+        save_func(file, tensors);
+    }
+    Py_RETURN_TRUE;
+}
+
+PyObject* WaitSnapshotCC(PyObject* self, PyObject* args) {
+    char* cname;
+    if (!PyArg_ParseTuple(args, "s", &cname)) {
+        PyErr_SetString(PyExc_ValueError, "You should provide a model path.");
+        return nullptr;
+    }
+    unique_ptr<AsyncCheckpoint> snapshot = std::move(g_snapshots[string(cname)]);
+    g_snapshots.erase(string(cname));
+    {
+        //  the destructor joins the writing thread
+        ScopedGILRelease no_gil;
+        snapshot.reset();
+    }
+    Py_RETURN_TRUE;
 }
 
 PyObject* SetLogLevelCC(PyObject* self, PyObject* args) {
@@ -401,6 +600,38 @@ PyObject* SetLogLevelCC(PyObject* self, PyObject* args) {
     Py_RETURN_TRUE;
 }
 
+PyObject* EnableProfilerCC(PyObject* self, PyObject* args) {
+    PyObject* enabled;
+    if (!PyArg_ParseTuple(args, "O", &enabled)) {
+        PyErr_SetString(PyExc_ValueError, "You should provide a boolean value.");
+        return nullptr;
+    }
+    Profiler::Get()->Enable(PyObject_IsTrue(enabled));
+    Py_RETURN_TRUE;
+}
+
+PyObject* ResetProfilerCC(PyObject* self, PyObject* args) {
+    Profiler::Get()->Reset();
+    Py_RETURN_TRUE;
+}
+
+PyObject* ProfilerSummaryCC(PyObject* self, PyObject* args) {
+    return StdStringToPyUnicode(Profiler::Get()->Summary());
+}
+
+PyObject* ExportProfilerTraceCC(PyObject* self, PyObject* args) {
+    char* filename;
+    if (!PyArg_ParseTuple(args, "s", &filename)) {
+        PyErr_SetString(PyExc_ValueError, "You should provide the path of the trace file.");
+        return nullptr;
+    }
+    if (!Profiler::Get()->ExportChromeTrace(string(filename))) {
+        PyErr_SetString(PyExc_IOError, "Failed to export the trace file.");
+        return nullptr;
+    }
+    Py_RETURN_TRUE;
+}
+
 #define PYFUNC(name) {#name, name, METH_VARARGS, ""}
 #define PYENDFUNC {nullptr, nullptr, 0, nullptr}
 
@@ -409,12 +640,16 @@ PyMethodDef* GetAllMethods() {
         PYFUNC(RegisteredOperatorsCC),
         PYFUNC(NoGradientOperatorsCC),
         PYFUNC(CreateGradientDefsCC),
+        PYFUNC(FuseElementwiseCC),
+        PYFUNC(InferShapesCC),
         PYFUNC(SwitchWorkspaceCC),
         PYFUNC(MoveWorkspaceCC),
         PYFUNC(CurrentWorkspaceCC),
         PYFUNC(WorkspacesCC),
         PYFUNC(ResetWorkspaceCC),
         PYFUNC(ClearWorkspaceCC),
+        PYFUNC(TrimMemoryCC),
+        PYFUNC(MemoryStatsCC),
         PYFUNC(TensorsCC),
         PYFUNC(HasTensorCC),
         PYFUNC(GetTensorNameCC),
@@ -427,7 +662,12 @@ PyMethodDef* GetAllMethods() {
         PYFUNC(FeedTensorCC),
         PYFUNC(RestoreCC),
         PYFUNC(SnapshotCC),
+        PYFUNC(WaitSnapshotCC),
         PYFUNC(SetLogLevelCC),
+        PYFUNC(EnableProfilerCC),
+        PYFUNC(ResetProfilerCC),
+        PYFUNC(ProfilerSummaryCC),
+        PYFUNC(ExportProfilerTraceCC),
         PYFUNC(MPIInitCC),
         PYFUNC(MPIRankCC),
         PYFUNC(MPISizeCC),
@@ -444,6 +684,11 @@ void common_init() {
     import_array_wrapper();
     static bool initialized = false;
     if (initialized) return;
+#if PY_VERSION_HEX < 0x03070000
+    //  the GIL will be released by the native calls
+    PyEval_InitThreads();
+#endif
+    g_main_thread = std::this_thread::get_id();
     SwitchWorkspaceInternal("default", true);
     g_current_workspace = "default";
     initialized = true;
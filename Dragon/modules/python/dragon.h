@@ -13,6 +13,9 @@
 #define DRAGON_MODULES_PYTHON_DRAGON_H_
 
 #include <sstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <Python.h>
 #include <numpy/arrayobject.h>
 
@@ -23,6 +26,7 @@
 #include "core/operator.h"
 #include "core/operator_gradient.h"
 #include "core/workspace.h"
+#include "core/profiler.h"
 
 #ifdef WITH_PYTHON3
 #define PyString_AsString PyUnicode_AsUTF8
@@ -66,18 +70,37 @@ inline void PrErr_SetString(PyObject* type, const std::string& str) {
     PyErr_SetString(type, str.c_str()); 
 }
 
+//  release the GIL in the scope of a native computation
+class ScopedGILRelease {
+ public:
+    ScopedGILRelease() : state(PyEval_SaveThread()) {}
+    ~ScopedGILRelease() { Acquire(); }
+
+    //  acquire again before leaving the scope, e.g. to raise an error
+    void Acquire() {
+        if (state) PyEval_RestoreThread(state);
+        state = nullptr;
+    }
+
+ private:
+    PyThreadState* state;
+};
+
 class TensorFetcherBase {
  public:
     virtual ~TensorFetcherBase() {}
-    virtual PyObject* Fetch(const Tensor& tensor) = 0;
+    //  return a view of the host memory if not "copy"
+    virtual PyObject* Fetch(const Tensor& tensor, bool copy) = 0;
 };
 
 class TensorFeederBase {
  public:
     virtual ~TensorFeederBase() {}
+    //  adopt the host buffer of array if not "copy"
     virtual PyObject* Feed(const DeviceOption& option, 
                            PyArrayObject* array, 
-                           Tensor* tensor) = 0;
+                           Tensor* tensor,
+                           bool copy) = 0;
 };
 
 DECLARE_TYPED_REGISTRY(TensorFetcherRegistry, TypeId, TensorFetcherBase);
@@ -97,7 +120,7 @@ const TypeMeta& NumpyTypeToDragon(int numpy_type);
 
 class NumpyFetcher : public TensorFetcherBase {
  public:
-    PyObject* Fetch(const Tensor& tensor) override {
+    PyObject* Fetch(const Tensor& tensor, bool copy) override {
         CHECK_GT(tensor.count(), 0);
         vector<npy_intp> npy_dims;
         for (const auto dim : tensor.dims()) npy_dims.push_back(dim);
@@ -107,9 +130,24 @@ class NumpyFetcher : public TensorFetcherBase {
             PyErr_SetString(PyExc_RuntimeError, s.c_str());
             return nullptr;
         }
+        if (!copy && tensor.own_mem() &&
+                tensor.memory_state() != MixedMemory::STATE_AT_CUDA) {
+            //  view the host memory, which is kept alive by a capsule
+            void* data = const_cast<void*>(tensor.raw_data<CPUContext>());
+            PyObject* array = PyArray_SimpleNewFromData(tensor.ndim(), npy_dims.data(), numpy_type, data);
+            PyObject* capsule = PyCapsule_New(new shared_ptr<MixedMemory>(tensor.shared_memory()), nullptr,
+                [](PyObject* capsule) {
+                    delete (shared_ptr<MixedMemory>*)PyCapsule_GetPointer(capsule, nullptr);
+                });
+            PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(array), capsule);
+            //  writing through the view would bypass the memory state
+            PyArray_CLEARFLAGS(reinterpret_cast<PyArrayObject*>(array), NPY_ARRAY_WRITEABLE);
+            return array;
+        }
         //  create a empty array with r shape
         PyObject* array = PyArray_SimpleNew(tensor.ndim(), npy_dims.data(), numpy_type);
         //  copy the tensor data to the numpy array
+        ScopedGILRelease no_gil;
         if (tensor.memory_state() == MixedMemory::STATE_AT_CUDA) {
             CUDAContext::Memcpy<CPUContext, CUDAContext>(tensor.nbytes(),
                                                          PyArray_DATA(reinterpret_cast<PyArrayObject*>(array)), 
@@ -125,7 +163,7 @@ class NumpyFetcher : public TensorFetcherBase {
 
 class StringFetcher : public TensorFetcherBase {
  public:
-    PyObject* Fetch(const Tensor& tensor) override {
+    PyObject* Fetch(const Tensor& tensor, bool copy) override {
         CHECK_GT(tensor.count(), 0);
         return StdStringToPyBytes(*tensor.data<string, CPUContext>());
     }
@@ -135,10 +173,12 @@ class NumpyFeeder : public TensorFeederBase {
  public:
     PyObject* Feed(const DeviceOption& option, 
                    PyArrayObject* original_array, 
-                   Tensor* tensor) override {
+                   Tensor* tensor,
+                   bool copy) override {
         PyArrayObject* array = PyArray_GETCONTIGUOUS(original_array);
         const TypeMeta& meta = NumpyTypeToDragon(PyArray_TYPE(array));
         if (meta.id() == 0) {
+            Py_XDECREF(array);
             PyErr_SetString(PyExc_TypeError, "Unsupported data type.");
             return nullptr;
         }
@@ -151,6 +191,23 @@ class NumpyFeeder : public TensorFeederBase {
         vector<TIndex> dims;
         for (int i = 0; i < ndim; i++) dims.push_back(npy_dims[i]);
         tensor->Reshape(dims);
+        if (!copy && option.device_type() != CUDA &&
+                tensor->own_mem() && PyArray_ISCARRAY(array)) {
+            //  borrow the buffer, the reference of array is released
+            //  with the memory, which may happen without holding the GIL,
+            //  or after the interpreter is finalized (leaked deliberately)
+            shared_ptr<void> owner(array, [](void* array) {
+                if (!Py_IsInitialized()) return;
+                PyGILState_STATE state = PyGILState_Ensure();
+                Py_XDECREF((PyObject*)array);
+                PyGILState_Release(state);
+            });
+            shared_ptr<MixedMemory> memory(new MixedMemory(meta, tensor->nbytes()));
+            memory->set_cpu_data(PyArray_DATA(array), tensor->nbytes(), owner);
+            tensor->SetMemory(memory);
+            Py_RETURN_TRUE;
+        }
+        ScopedGILRelease no_gil;
         if (option.device_type() == CUDA) {
 #ifdef WITH_CUDA
             CUDAContext context(option);
@@ -166,6 +223,7 @@ class NumpyFeeder : public TensorFeederBase {
                                                        tensor->raw_mutable_data<CPUContext>(),
                                                        static_cast<void*>(PyArray_DATA(array)));
         }
+        no_gil.Acquire();
         Py_XDECREF(array);
         Py_RETURN_TRUE;
     }
@@ -44,6 +44,9 @@ option['debug_mode'] = False
 # Set it by the memonger
 option['share_grads'] = False
 
+# Set it by the memonger
+option['memory_plan'] = False
+
 # Whether to log the meta graphs
 option['log_meta_graph'] = False
 
@@ -54,6 +57,18 @@ option['export_meta_graph'] = ''
 # Whether to log the optimized graphs
 option['log_optimized_graph'] = False
 
+# The type of graph to create, '' for the serial graph
+option['graph_type'] = ''
+
+# Whether to fold the affine operators into the layers for TEST
+option['fold_inference'] = True
+
+# Whether to fuse the elementwise operators
+option['fuse_elementwise'] = False
+
+# Whether to fold the constants and eliminate the common operators
+option['simplify_graph'] = False
+
 
 def EnableCPU():
     """Enable CPU mode globally.
@@ -231,6 +246,95 @@ def ExportMetaGraph(prefix=''):
     option['export_meta_graph'] = prefix
 
 
+def SetGraphType(graph_type=''):
+    """Set the type of graph to create globally.
+
+    Use ``Parallel`` to run the independent operators concurrently on CPU.
+
+    Parameters
+    ----------
+    graph_type : str
+        The registered type of graph, empty for the serial graph.
+
+    Returns
+    -------
+    None
+
+    """
+    global option
+    option['graph_type'] = graph_type
+
+
+def SetInferenceFolding(enabled=True):
+    """Enable to fold the affine operators globally.
+
+    The ``BatchNorm``, ``FusedBatchNorm``, ``Scale`` and ``Relu``
+    following ``Conv2d`` or ``InnerProduct`` in a ``TEST`` graph
+    are folded into its weights, bias and activation.
+
+    Parameters
+    ----------
+    enabled : boolean
+        Whether to fold the operators.
+
+    Returns
+    -------
+    None
+
+    """
+    global option
+    option['fold_inference'] = enabled
+
+
+def SetElementwiseFusion(enabled=True):
+    """Enable to fuse the elementwise operators globally.
+
+    The trees of ``Add``, ``Sub``, ``Mul``, ``Div``, activations,
+    ``Clip``, ``Pow``, ``Exp``, ``Log`` and ``Square`` are evaluated
+    by a single ``FusedElementwise``, with a fused gradient.
+
+    The intermediate results except the outputs can not be fetched,
+    and only ``float32`` is supported.
+
+    Parameters
+    ----------
+    enabled : boolean
+        Whether to fuse the operators.
+
+    Returns
+    -------
+    None
+
+    """
+    global option
+    option['fuse_elementwise'] = enabled
+
+
+def SetGraphSimplification(enabled=True):
+    """Enable to simplify the graphs globally.
+
+    The operators computing the same outputs from the same inputs
+    are evaluated only once, and the ones depending only on the
+    constants, e.g. ``Fill`` and ``Arange``, are evaluated at the creation.
+
+    It is disabled by default.
+
+    Use ``SetLoggingLevel('DEBUG')`` to see the removed operators.
+
+    Parameters
+    ----------
+    enabled : boolean
+        Whether to simplify the graphs.
+
+    Returns
+    -------
+    None
+
+    """
+    global option
+    option['simplify_graph'] = enabled
+
+
 def SetLoggingLevel(level):
     """Set the minimum level of Logging.
 
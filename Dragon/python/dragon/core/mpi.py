@@ -20,6 +20,10 @@ _is_init = False
 _snapshot_ranks = []
 _parallel_groups = []
 _parallel_mode = 'MPI'
+_bucket_size = 25 * 1024 * 1024
+_overlap = False
+_compression = 'NONE'
+_topk_ratio = 0.01
 
 __all__ = [
     'Init',
@@ -33,6 +37,10 @@ __all__ = [
     'AllowParallel',
     'SetParallelMode',
     'GetParallelMode',
+    'SetBucketSize',
+    'SetOverlap',
+    'SetCompression',
+    'GetAllReduceOptions',
     'Finalize'
 ]
 
@@ -225,6 +233,9 @@ def SetParallelMode(mode):
     -----
     The default mode is ``MPI``.
 
+    ``MIXED`` reduces the gradients within each node first,
+    then across the nodes by their leaders.
+
     """
     assert mode == 'MPI' or \
            mode == 'NCCL' \
@@ -246,6 +257,102 @@ def GetParallelMode():
     return _parallel_mode
 
 
+def SetBucketSize(size):
+    """Set the size of fusion buckets for the ``MPI`` allreduce.
+
+    The gradients are packed into the buckets of at most ``size`` bytes,
+    and each bucket is reduced at once.
+
+    Parameters
+    ----------
+    size : int
+        The size in bytes. ``0`` reduces the gradients one by one.
+
+    Returns
+    -------
+    None
+
+    Notes
+    -----
+    The default size is ``25MB``.
+
+    """
+    global _bucket_size
+    _bucket_size = int(size)
+
+
+def SetOverlap(enabled=True):
+    """Enable or disable overlapping the ``MPI`` allreduce with the backward.
+
+    A bucket is reduced by a background thread as soon as its gradients
+    are produced, and the updater waits for all buckets.
+
+    Parameters
+    ----------
+    enabled : boolean
+        Whether to overlap the communication.
+
+    Returns
+    -------
+    None
+
+    Notes
+    -----
+    It requires the fusion buckets, see ``SetBucketSize(*args, **kwargs)``.
+
+    """
+    global _overlap
+    _overlap = enabled
+
+
+def SetCompression(mode='NONE', topk_ratio=0.01):
+    """Set the compression of gradients for the allreduce.
+
+    ``FP16`` sends the halves, and accumulates them in fp32.
+
+    ``TOPK`` sends the ``topk_ratio`` of gradients with the largest magnitudes,
+    and accumulates the others locally for the later iterations.
+
+    Parameters
+    ----------
+    mode : str
+        The mode, ``NONE``, ``FP16`` or ``TOPK``.
+    topk_ratio : float
+        The ratio of gradients to send for ``TOPK``.
+
+    Returns
+    -------
+    None
+
+    Notes
+    -----
+    The default mode is ``NONE``.
+
+    ``TOPK`` reduces the gradients one by one, i.e. without the fusion buckets.
+
+    """
+    assert mode == 'NONE' or \
+           mode == 'FP16' \
+           or mode == 'TOPK'
+    assert 0 < topk_ratio <= 1
+    global _compression, _topk_ratio
+    _compression = mode
+    _topk_ratio = float(topk_ratio)
+
+
+def GetAllReduceOptions():
+    """Get the options of the allreduce.
+
+    Returns
+    -------
+    dict
+        The ``bucket_size``, ``overlap``, ``compression`` and ``topk_ratio``.
+
+    """
+    return {'bucket_size': _bucket_size, 'overlap': _overlap,
+            'compression': _compression, 'topk_ratio': _topk_ratio}
+
+
 def Finalize():
     """Finalize the MPI env.
 
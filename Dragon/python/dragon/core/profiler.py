@@ -0,0 +1,116 @@
+# ------------------------------------------------------------
+# Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+#
+# Licensed under the BSD 2-Clause License.
+# You should have received a copy of the BSD 2-Clause License
+# along with the software. If not, See,
+#
+#      <https://opensource.org/licenses/BSD-2-Clause>
+#
+# ------------------------------------------------------------
+
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+from dragon.import_c_apis import *
+
+__all__ = [
+    'Enable',
+    'Disable',
+    'Reset',
+    'Summary',
+    'ExportChromeTrace',
+]
+
+
+def Enable(enabled=True):
+    """Enable the profiler for all graphs.
+
+    Set the graph argument ``profile`` to profile a specific graph.
+
+    Parameters
+    ----------
+    enabled : boolean
+        Whether to record the running of operators.
+
+    Returns
+    -------
+    None
+
+    References
+    ----------
+    The wrapper of ``EnableProfilerCC``.
+
+    """
+    EnableProfilerCC(enabled)
+
+
+def Disable():
+    """Disable the profiler for all graphs.
+
+    Returns
+    -------
+    None
+
+    References
+    ----------
+    The wrapper of ``EnableProfilerCC``.
+
+    """
+    EnableProfilerCC(False)
+
+
+def Reset():
+    """Clear the recorded events.
+
+    Returns
+    -------
+    None
+
+    References
+    ----------
+    The wrapper of ``ResetProfilerCC``.
+
+    """
+    ResetProfilerCC()
+
+
+def Summary():
+    """Return the time of operators aggregated by type.
+
+    The types are sorted by the total time in descending order.
+
+    Returns
+    -------
+    str
+        The summary table.
+
+    References
+    ----------
+    The wrapper of ``ProfilerSummaryCC``.
+
+    """
+    return ProfilerSummaryCC()
+
+
+def ExportChromeTrace(filename):
+    """Export the recorded events into a JSON file.
+
+    Open it with ``chrome://tracing`` to view the timeline.
+
+    Parameters
+    ----------
+    filename : str
+        The path of the trace file.
+
+    Returns
+    -------
+    None
+
+    References
+    ----------
+    The wrapper of ``ExportProfilerTraceCC``.
+
+    """
+    ExportProfilerTraceCC(filename)
@@ -0,0 +1,111 @@
+# ------------------------------------------------------------
+# Copyright (c) 2017-preseent, SeetaTech, Co.,Ltd.
+#
+# Licensed under the BSD 2-Clause License.
+# You should have received a copy of the BSD 2-Clause License
+# along with the software. If not, See,
+#
+#      <https://opensource.org/licenses/BSD-2-Clause>
+#
+# ------------------------------------------------------------
+
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import os
+
+_is_init = False
+_rank = 0
+_size = 1
+_key = ''
+
+__all__ = [
+    'Init',
+    'Is_Init',
+    'Rank',
+    'Size',
+    'GetParallelArguments',
+]
+
+def Init(rank=None, size=None, key=None):
+    """Init the SHM env of the processes on the same host.
+
+    The gradients are averaged over a POSIX shared memory, without MPI.
+
+    Parameters
+    ----------
+    rank : int or None
+        The rank of this process. Default is ``DRAGON_SHM_RANK``.
+    size : int or None
+        The number of processes. Default is ``DRAGON_SHM_SIZE``.
+    key : str or None
+        The unique key of this job. Default is ``DRAGON_SHM_KEY``,
+        or the pid of the parent process.
+
+    Returns
+    -------
+    None
+
+    Notes
+    -----
+    The processes should be spawned by the same launcher,
+    if the ``key`` is not given.
+
+    """
+    global _is_init, _rank, _size, _key
+    if rank is None: rank = os.environ.get('DRAGON_SHM_RANK', 0)
+    if size is None: size = os.environ.get('DRAGON_SHM_SIZE', 1)
+    if key is None: key = os.environ.get('DRAGON_SHM_KEY', str(os.getppid()))
+    _rank, _size, _key = int(rank), int(size), str(key)
+    if _rank < 0 or _rank >= _size:
+        raise ValueError('Invalid rank {} of {} processes.'.format(_rank, _size))
+    _is_init = True
+
+
+def Is_Init():
+    """Whether the SHM env has initialized.
+
+    Returns
+    -------
+    boolean
+
+    """
+    return _is_init
+
+
+def Rank():
+    """The rank of this process.
+
+    Returns
+    -------
+    int
+        The rank.
+
+    """
+    return _rank
+
+
+def Size():
+    """The number of processes.
+
+    Returns
+    -------
+    int
+        The size.
+
+    """
+    return _size
+
+
+def GetParallelArguments():
+    """Get the arguments of the ``SHM`` data parallelism.
+
+    Returns
+    -------
+    dict
+        The ``parallel_mode``, ``shm_key``, ``shm_rank`` and ``shm_size``.
+
+    """
+    return {'parallel_mode': 'SHM', 'shm_key': _key,
+            'shm_rank': _rank, 'shm_size': _size}
@@ -25,6 +25,7 @@ from dragon.import_c_apis import *
 
 import dragon.core.utils as utils
 import dragon.core.mpi as mpi
+import dragon.core.shm as shm
 import dragon.protos.dragon_pb2 as pb
 
 CURRENT_GRAPH_IDX = 0
@@ -34,6 +35,8 @@ __all__ = [
     'MoveWorkspace',
     'ResetWorkspace',
     'ClearWorkspace',
+    'TrimMemory',
+    'GetMemoryStats',
     'CreateGraph',
     'RunGraph',
     'HasTensor',
@@ -45,6 +48,7 @@ __all__ = [
     'Restore',
     'LogMetaGraph',
     'LogOptimizedGraph',
+    'GetMemoryPlan',
     'ExportMetaGraph'
 ]
 
@@ -81,6 +85,11 @@ def SwitchWorkspace(workspace_name, create_if_missing=True):
     -------
     None
 
+    Notes
+    -----
+    The workspace is switched for the calling thread only,
+    the threads which never switch will follow the main thread.
+
     References
     ----------
     The wrapper of ``SwitchWorkspaceCC``.
@@ -163,6 +172,40 @@ def ClearWorkspace(workspace_name=''):
     ClearWorkspaceCC(workspace_name)
 
 
+def TrimMemory():
+    """Release the idle buffers and the cached host memory.
+
+    The host memory freed by tensors is cached by size classes for reusing,
+    call it to return the memory to the system, e.g. after a large batch.
+
+    Returns
+    -------
+    None
+
+    References
+    ----------
+    The wrapper of ``TrimMemoryCC``.
+
+    """
+    TrimMemoryCC()
+
+
+def GetMemoryStats():
+    """Return the counters of the host memory allocator.
+
+    Returns
+    -------
+    dict
+        The ``hits``, ``misses``, ``bytes_cached`` and ``bytes_in_use``.
+
+    References
+    ----------
+    The wrapper of ``MemoryStatsCC``.
+
+    """
+    return MemoryStatsCC()
+
+
 def CreateGraph(meta_graph):
     """Create the graph in the VM backend.
 
@@ -186,6 +229,33 @@ def CreateGraph(meta_graph):
     LogOptimizedGraph(meta_graph)
 
 
+def InferShapes(meta_graph):
+    """Infer the shapes of outputs statically, without running the graph.
+
+    The shapes start from the non-empty tensors of current workspace,
+    and the outputs that can not be inferred are excluded.
+
+    The invalid shapes of inputs raise a ``ValueError``.
+
+    Parameters
+    ----------
+    meta_graph : dragon_pb2.GraphDef
+        The definition of meta graph.
+
+    Returns
+    -------
+    dict
+        The ``(shape, dtype)`` of outputs, keyed by the tensor name.
+
+    References
+    ----------
+    The wrapper of ``InferShapesCC``.
+
+    """
+    shapes = InferShapesCC(_stringify_proto(meta_graph))
+    return {name: (tuple(shape), dtype) for name, (shape, dtype) in shapes.items()}
+
+
 def HasTensor(tensor):
     """Query whether tensor has registered in current workspace.
 
@@ -263,19 +333,28 @@ def CreateFiller(filler_def):
     CreateFillerCC(filler_def)
 
 
-def FetchTensor(tensor):
+def FetchTensor(tensor, copy=True):
     """Fetch the values of given tensor.
 
     Parameters
     ----------
     tensor : Tensor
         The tensor to fetch.
+    copy : boolean
+        Whether to copy the values. Default is ``True``.
 
     Returns
     -------
     numpy.ndarray
         The values copied from the backend.
 
+    Notes
+    -----
+    If not ``copy``, a read-only view of the host memory will be returned,
+    which changes with the tensor in the following computations.
+
+    The CUDA tensors are always copied.
+
     References
     ----------
     The wrapper of ``FetchTensorCC``.
@@ -283,10 +362,10 @@ def FetchTensor(tensor):
     """
     tensor = str(tensor.name) if hasattr(tensor, 'name') else str(tensor)
     assert isinstance(tensor, str)
-    return FetchTensorCC(tensor)
+    return FetchTensorCC(tensor, 1 if copy else 0)
 
 
-def FeedTensor(tensor, ndarray, force_cpu=False, dtype=None):
+def FeedTensor(tensor, ndarray, force_cpu=False, dtype=None, copy=True):
     """Feed the values to the given tensor.
 
     Parameters
@@ -299,11 +378,18 @@ def FeedTensor(tensor, ndarray, force_cpu=False, dtype=None):
         Whether force to feed to cpu context.
     dtype : np.dtype or None
         The data type. If ``None``, np.float32 will be used instead.
+    copy : boolean
+        Whether to copy the values. Default is ``True``.
 
     Returns
     -------
     None
 
+    Notes
+    -----
+    If not ``copy``, the buffer of a contiguous array will be shared with the tensor
+    on the cpu context, which should not be modified while the tensor is in use.
+
     Examples
     --------
     >>> import dragon.core.workspace as ws
@@ -357,7 +443,7 @@ def FeedTensor(tensor, ndarray, force_cpu=False, dtype=None):
                                 format(preset_dtype, dtype))
         auto_dtype = preset_dtype
     ndarray = np.array(ndarray, dtype=auto_dtype, copy=False)
-    FeedTensorCC(name, ndarray, _stringify_proto(dev))
+    FeedTensorCC(name, ndarray, _stringify_proto(dev), 1 if copy else 0)
 
 
 stages = {
@@ -457,6 +543,31 @@ def GetOptimizedGraph(meta_graph):
     return opt_graph_def
 
 
+def GetMemoryPlan(meta_graph):
+    """Return the bytes of the memory plan.
+
+    The plan is made after the first running of the graph.
+
+    Parameters
+    ----------
+    meta_graph : dragon_pb2.GraphDef
+        The definition of meta graph.
+
+    Returns
+    -------
+    dict or None
+        The ``planned``, ``naive`` and ``lower`` bytes of intermediate tensors.
+
+    """
+    optimized_graph = GetOptimizedGraph(meta_graph)
+    if optimized_graph is None: return None
+    plan = {}
+    for arg in optimized_graph.arg:
+        if arg.name.startswith('memory_') and arg.name.endswith('_bytes'):
+            plan[arg.name[7:-6]] = arg.i64
+    return plan if len(plan) > 0 else None
+
+
 def LogOptimizedGraph(meta_graph):
     """Log the optimized graph.
 
@@ -505,7 +616,35 @@ def ExportMetaGraph(meta_graph):
         logger.info('Export meta graph into: {}'.format(filepath))
 
 
-def Snapshot(tensors, filename, prefix='', suffix='.bin', format='default'):
+class SnapshotHandle(object):
+    """The handle to wait for an asynchronous snapshot."""
+    def __init__(self, wait_func=None):
+        self._wait_func = wait_func
+
+    def wait(self):
+        """Block until the snapshot is committed into the file.
+
+        Returns
+        -------
+        None
+
+        """
+        if self._wait_func is not None:
+            self._wait_func()
+            self._wait_func = None
+
+
+def _write_pickle(content, filepath):
+    """Write the pickled content into a temporary file, then rename it."""
+    with open(filepath + '.tmp', 'wb') as f:
+        cPickle.dump(content, f, cPickle.HIGHEST_PROTOCOL)
+        f.flush()
+        os.fsync(f.fileno())
+    if os.name == 'nt' and os.path.exists(filepath): os.remove(filepath)
+    os.rename(filepath + '.tmp', filepath)
+
+
+def Snapshot(tensors, filename, prefix='', suffix='.bin', format='default', wait=True):
     """Snapshot tensors into a binary file.
 
     Parameters
@@ -520,23 +659,35 @@ def Snapshot(tensors, filename, prefix='', suffix='.bin', format='default'):
         The suffix of this binary file.
     format : str
         The format of this binary file.
+    wait : boolean
+        Whether to wait for the writing. Default is ``True``.
 
     Returns
     -------
-    None
+    SnapshotHandle or None
+        The handle to wait if ``wait`` is ``False``.
 
     Notes
     -----
     The full filepath will be:  ``prefix`` + ``filename`` + ``suffix``.
 
-    Available formats: ['default', 'caffe'].
+    Available formats: ['default', 'caffe', 'binary'].
+
+    The ``binary`` format writes the raw data with a small header,
+    which can be memory-mapped by ``Restore`` or the C++ deployment.
+
+    If not ``wait``, the tensors are copied at once, and written in background.
+    The file is replaced only after the whole content is flushed to the disk.
 
     """
     from dragon.config import logger
     filepath = prefix + filename + suffix
     if mpi.Is_Init():
-        if not mpi.AllowSnapshot(): return
+        if not mpi.AllowSnapshot(): return None if wait else SnapshotHandle()
         filepath = filepath + '.rank.{}'.format(mpi.Rank())
+    elif shm.Is_Init():
+        # the parameters are identical over the processes
+        if shm.Rank() != 0: return None if wait else SnapshotHandle()
 
     dir = os.path.split(filepath)[0]
     if len(dir) > 0 and not os.path.exists(dir): os.makedirs(dir)
@@ -544,15 +695,25 @@ def Snapshot(tensors, filename, prefix='', suffix='.bin', format='default'):
     if format == 'default':
         content = {}
         for tensor in tensors:
-            content[tensor.name] = FetchTensor(tensor)
-        with open(filepath, 'wb') as f:
-            cPickle.dump(content, f, cPickle.HIGHEST_PROTOCOL)
+            # the training may change the tensor before writing
+            value = FetchTensor(tensor)
+            content[tensor.name] = value if wait else np.copy(value)
         logger.info('Snapshot Model@: ' + filepath)
         logger.info('Model Format: cPickle')
+        if wait:
+            with open(filepath, 'wb') as f:
+                cPickle.dump(content, f, cPickle.HIGHEST_PROTOCOL)
+        else:
+            import threading
+            thread = threading.Thread(target=_write_pickle, args=(content, filepath))
+            thread.start()
+            return SnapshotHandle(thread.join)
 
-    elif format is 'caffe':
+    elif format == 'caffe' or format == 'binary':
         names = [tensor.name for tensor in tensors]
-        SnapshotCC(filepath, names, 1)
+        code = 1 if format == 'caffe' else 2
+        SnapshotCC(filepath, names, code, 0 if wait else 1)
+        if not wait: return SnapshotHandle(lambda: WaitSnapshotCC(filepath))
 
     else: raise TypeError('Unknown binary format: {}'.format(format))
 
@@ -573,7 +734,9 @@ def Restore(filepath, format='default'):
 
     Notes
     -----
-    Available formats: ['default', 'caffe'].
+    Available formats: ['default', 'caffe', 'binary'].
+
+    The ``binary`` format is mapped into memory, the pages are read lazily.
 
     """
     from dragon.config import logger
@@ -597,5 +760,8 @@ def Restore(filepath, format='default'):
         # TODO(PhyscalX): we simply use layer_name + @paramX
         RestoreCC(filepath, 1)
 
+    elif format == 'binary':
+        RestoreCC(filepath, 2)
+
     else:
         raise TypeError('Unknown binary format: {}'.format(format))
\ No newline at end of file
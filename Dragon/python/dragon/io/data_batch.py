@@ -14,6 +14,7 @@ import pprint
 from multiprocessing import Queue
 
 import dragon.core.mpi as mpi
+import dragon.core.shm as shm
 
 from .data_reader import DataReader
 from .data_transformer import DataTransformer
@@ -84,6 +85,9 @@ class DataBatch(object):
                 group_size = len(group)
                 for i, node in enumerate(group):
                     if global_rank == node: local_rank = i
+        elif shm.Is_Init():
+            global_rank = local_rank = shm.Rank()
+            group_size = shm.Size()
         kwargs['group_size'] = group_size
 
         # configuration
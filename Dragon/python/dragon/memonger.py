@@ -31,6 +31,33 @@ def ShareGrads(enabled=True):
     option['share_grads'] = enabled
 
 
+def PlanMemory(enabled=True):
+    """Enable the static memory planning globally.
+
+    The intermediate tensors will be placed into a single arena
+    according to their live ranges, measured from the first running.
+
+    Use ``workspace.GetMemoryPlan(meta_graph)`` to query the bytes.
+
+    Parameters
+    ----------
+    enabled : boolean
+        Whether to bind the tensors to the planned arena.
+
+    Returns
+    -------
+    None
+
+    Examples
+    --------
+    >>> import dragon.memonger as opt
+    >>> opt.PlanMemory()
+
+    """
+    from dragon.config import option
+    option['memory_plan'] = enabled
+
+
 def Drop(op_func, *args, **kwargs):
     """Drop(Share) the inputs for outputs.
 
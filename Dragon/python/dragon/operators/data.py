@@ -13,6 +13,8 @@ from __future__ import absolute_import
 from __future__ import division
 from __future__ import print_function
 
+import dragon.core.mpi as mpi
+import dragon.core.shm as shm
 from dragon.operators.misc import Run
 
 from . import *
@@ -83,6 +85,87 @@ def LMDBData(**kwargs):
     return Run([], param_str=str(kwargs), nout=2, **arguments)
 
 
+def DataLoader(source, batch_size=100, shuffle=False, node_step=False,
+               num_chunks=2048, chunk_size=-1, mean_values=None, scale=1.0,
+               padding=0, fill_value=127, crop_size=0, mirror=False,
+               force_color=False, phase='TRAIN', partition=False,
+               prefetch=5, num_readers=1, num_transformers=2, **kwargs):
+    """Prefetch Image data with the native threads of C++.
+
+    The database could be a `LMDB`_ (requires ``WITH_LMDB``),
+
+    or a record file written by `dragon.tools.db.RecordWriter`_.
+
+    Parameters
+    ----------
+    source : str
+        The path of database.
+    batch_size : int
+        The size of a mini-batch.
+    shuffle : boolean
+        Whether to shuffle the data.
+    node_step: boolean
+        Whether to split data for multiple parallel nodes.
+    num_chunks : int
+        The number of chunks to split. Default is ``2048``.
+    chunk_size : int
+        The size(MB) of each chunk. Default is -1 (Refer ``num_chunks``).
+    mean_values : list of float or None
+        The mean value of each image channel.
+    scale : float
+        The scale performed after mean subtraction. Default is ``1.0``.
+    padding : int
+        The padding size. Default is ``0``.
+    fill_value : int
+        The value to fill when padding is valid. Default is ``127``.
+    crop_size : int
+        The crop size. Default is ``0`` (Disabled).
+    mirror : boolean
+        Whether to mirror(flip horizontally) images. Default is ``False``.
+    force_color : boolean
+        Set to duplicate channels for gray. Default is ``False``.
+    phase : str
+        The phase of this operator, ``TRAIN`` or ``TEST``.
+    partition : boolean
+        Whether to partition batch for parallelism. Default is ``False``.
+    prefetch : int
+        The prefetch count. Default is ``5``.
+    num_readers : int
+        The number of reader threads. Default is ``1``.
+    num_transformers : int
+        The number of transformer threads. Default is ``2``.
+
+    Returns
+    -------
+    list of Tensor.
+        Two tensors, representing data and labels respectively.
+
+    Notes
+    -----
+    The encoded images are decoded only if ``WITH_OPENCV`` is set.
+
+    """
+    arguments = ParseArguments(locals())
+    node_rank, node_size = 0, 1
+    if mpi.Is_Init():
+        idx, group = mpi.AllowParallel()
+        if idx != -1:  # data parallel
+            node_size = len(group)
+            node_rank = group.index(mpi.Rank())
+    elif shm.Is_Init():
+        node_rank, node_size = shm.Rank(), shm.Size()
+    if partition:
+        arguments['batch_size'] = int(batch_size / node_size)
+    del arguments['partition']
+    arguments['node_rank'] = node_rank
+    arguments['node_size'] = node_size
+    arguments['scale'] = float(scale)
+    if mean_values is not None:
+        arguments['mean_values'] = [float(v) for v in mean_values]
+
+    return Tensor.CreateOperator([], nout=2, op_type='DataLoader', **arguments)
+
+
 def ImageData(inputs, mean_values=None, std_values=None,
               dtype='FLOAT32', data_format='NCHW', **kwargs):
     """Process the images from 4D raw data.
@@ -118,4 +201,58 @@ def ImageData(inputs, mean_values=None, std_values=None,
             raise ValueError('The length of std values should be 3.')
         arguments['std_values'] = [float(v) for v in std_values]
 
-    return Tensor.CreateOperator(nout=1, op_type='ImageData', **arguments)
\ No newline at end of file
+    return Tensor.CreateOperator(nout=1, op_type='ImageData', **arguments)
+
+
+def ImageAugment(inputs, crop_size=0, padding=0, fill_value=127, mirror=False,
+                 min_random_scale=1.0, max_random_scale=1.0, mean_values=None,
+                 std_values=None, data_format='NCHW', **kwargs):
+    """Augment the images from 4D raw data in one pass.
+
+    The images are resized randomly (bilinear), cropped, mirrored and padded,
+
+    then normalized as `ImageData`_. The raw data format is assumed as **NHWC**.
+
+    Parameters
+    ----------
+    inputs : Tensor
+        The input tensor, with type of **uint8** or **float32**.
+    crop_size : int
+        The crop size. Default is ``0`` (Disabled).
+    padding : int
+        The padding size. Default is ``0``.
+    fill_value : int or float
+        The value to fill when padding is valid. Default is ``127``.
+    mirror : boolean
+        Whether to mirror(flip horizontally) images randomly. Default is ``False``.
+    min_random_scale : float
+        The min scale of the input images. Default is ``1.0``.
+    max_random_scale : float
+        The max scale of the input images. Default is ``1.0``.
+    mean_values : list of float or None
+        The optional mean values to subtract.
+    std_values : list of float or None
+        The optional std values to divide.
+    data_format : str
+        The data format of output. ``NCHW`` or ``NHWC``.
+
+    Returns
+    -------
+    Tensor
+        The output tensor, with type of **float32**.
+
+    Notes
+    -----
+    The ``TEST`` phase of graph takes the center crop, without resizing or mirroring.
+
+    """
+    arguments = ParseArguments(locals())
+    arguments['fill_value'] = float(fill_value)
+    arguments['min_random_scale'] = float(min_random_scale)
+    arguments['max_random_scale'] = float(max_random_scale)
+    if mean_values is not None:
+        arguments['mean_values'] = [float(v) for v in mean_values]
+    if std_values is not None:
+        arguments['std_values'] = [float(v) for v in std_values]
+
+    return Tensor.CreateOperator(nout=1, op_type='ImageAugment', **arguments)
@@ -30,7 +30,9 @@ from .operators import contrib
 
 # data
 LMDBData = data.LMDBData
+DataLoader = data.DataLoader
 ImageData = data.ImageData
+ImageAugment = data.ImageAugment
 
 # init
 Fill = init.Fill
@@ -11,6 +11,7 @@
 
 import os
 import sys
+import struct
 import lmdb
 
 
@@ -217,4 +218,68 @@ class LMDB(object):
         None
 
         """
-        self.env.close()
\ No newline at end of file
+        self.env.close()
+
+class RecordWriter(object):
+    """Write the records into a file for the native ``DataLoader``.
+
+    The records are indexed by the order of putting,
+
+    which is identical to the zero-filled keys of ``LMDB``.
+
+    Examples
+    --------
+    >>> writer = RecordWriter('/xxx/yyy.rec')
+    >>> writer.put(datum.SerializeToString())
+    >>> writer.close()
+
+    """
+    _MAGIC = b'DRAGONRC'
+
+    def __init__(self, path):
+        """Construct a ``RecordWriter``.
+
+        Parameters
+        ----------
+        path : str
+            The path of the record file.
+
+        Returns
+        -------
+        RecordWriter
+            The writer instance.
+
+        """
+        self._file = open(path, 'wb')
+        self._file.write(self._MAGIC)
+        self._offsets = []
+
+    def put(self, value):
+        """Append a record.
+
+        Parameters
+        ----------
+        value : str
+            The serialized str.
+
+        Returns
+        -------
+        None
+
+        """
+        self._offsets.append(self._file.tell())
+        self._file.write(struct.pack('<Q', len(value)))
+        self._file.write(value)
+
+    def close(self):
+        """Write the index and close the file.
+
+        Returns
+        -------
+        None
+
+        """
+        self._file.write(struct.pack('<%dQ' % len(self._offsets), *self._offsets))
+        self._file.write(struct.pack('<Q', len(self._offsets)))
+        self._file.write(self._MAGIC)
+        self._file.close()
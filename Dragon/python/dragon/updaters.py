@@ -25,7 +25,7 @@ class BaseUpdater(object):
     BaseUpdater is designed to preprocess the gradients.
     """
     def __init__(self, scale_gradient = 1.0, clip_gradient = -1.0,
-                 l2_decay = -1.0, slot='', verbose=True):
+                 l2_decay = -1.0, slot='', multi_tensor=0, verbose=True):
         """Construct a Updater to optimize the objectives.
 
         Parameters
@@ -38,12 +38,16 @@ class BaseUpdater(object):
             The l2 decay factor. Default is ``-1.0`` (Disabled).
         slot : str
             The slot name of advanced updater.
+        multi_tensor : int
+            Update the parameters with at most ``multi_tensor`` elements in one op.
+            Default is ``0`` (Disabled).
 
         """
         self._hyper_params = {'scale_gradient': scale_gradient,
                               'clip_gradient': clip_gradient,
                               'l2_decay': l2_decay}
         self._extra_kwargs = {'slot': slot}
+        self._multi_tensor = multi_tensor
         self._tuples = []
         self._type = None
         self._prefix = ''
@@ -13,6 +13,7 @@ import time
 
 import dragon.core.workspace as ws
 import dragon.core.mpi as mpi
+import dragon.core.shm as shm
 import dragon.updaters as updaters
 import dragon.tools.summary_writer as sw
 import dragon.vm.theano as theano
@@ -97,6 +98,7 @@ class Solver(object):
             idx, group = mpi.AllowParallel()
             # only the root in a parallel group can test
             if idx != -1 and mpi.Rank() != group[0]: return
+        elif shm.Is_Init() and shm.Rank() != 0: return
 
         num_test_net = len(self._param.test_iter)
         if num_test_net > 0:
@@ -15,8 +15,10 @@ import numpy as np
 from collections import OrderedDict
 
 import dragon.core.mpi as mpi
+import dragon.core.shm as shm
 import dragon.core.workspace as ws
 import dragon.protos.dragon_pb2 as pb
+from dragon.import_c_apis import FuseElementwiseCC
 from dragon.core.utils import MakeArgument
 from dragon.core.gradient_maker import GraphGradientMaker
 from dragon.core.scope import GetOperatorName, GetTensorName
@@ -119,8 +121,16 @@ def GraphDef_Update(meta_graph, updater):
             parallel_arguments['comm'], parallel_arguments['group'] \
                 = mpi.CreateGroup(root=group[0], incl=group)
             parallel_arguments['root'] = group[0]
-        for k, v in parallel_arguments.items():
-            meta_graph.arg.add().CopyFrom(MakeArgument(k, v))
+            parallel_arguments.update(mpi.GetAllReduceOptions())
+    elif shm.Is_Init() and shm.Size() > 1:
+        parallel_arguments.update(shm.GetParallelArguments())
+    for k, v in parallel_arguments.items():
+        meta_graph.arg.add().CopyFrom(MakeArgument(k, v))
+
+    # merge the small parameters if necessary
+    if updater._multi_tensor > 0:
+        meta_graph.arg.add().CopyFrom(MakeArgument(
+            'multi_tensor_update', updater._multi_tensor))
 
     for tuple in updater._tuples:
         tensors = tuple[0]
@@ -154,10 +164,56 @@ def GraphDef_Opt(meta_graph):
 
     `memonger.share_grads(*args, **kwargs)`_ - How the enable gradients sharing.
 
+    `memonger.PlanMemory(*args, **kwargs)`_ - How to enable the memory planning.
+
+    `config.SetGraphType(*args, **kwargs)`_ - How to run the operators in parallel.
+
+    `config.SetInferenceFolding(*args, **kwargs)`_ - How to disable the inference folding.
+
+    `config.SetGraphSimplification(*args, **kwargs)`_ - How to enable the graph simplification.
+
     """
     from dragon.config import option
     meta_graph.debug_mode = option['debug_mode']
     meta_graph.share_grads = option['share_grads']
+    if option['graph_type'] != '':
+        meta_graph.graph_type = option['graph_type']
+    if option['memory_plan']:
+        meta_graph.arg.add().CopyFrom(MakeArgument('memory_plan', 1))
+    if not option['fold_inference']:
+        meta_graph.arg.add().CopyFrom(MakeArgument('fold_inference', 0))
+    if option['simplify_graph']:
+        meta_graph.arg.add().CopyFrom(MakeArgument('eliminate_common', 1))
+        meta_graph.arg.add().CopyFrom(MakeArgument('fold_constant', 1))
+
+
+def GraphDef_Fuse(forward_ops, targets):
+    """Fuse the elementwise operators before making the gradients.
+
+    Parameters
+    ----------
+    forward_ops : list of dragon_pb2.OperatorDef
+        The operators of ``ForwardOp``.
+    targets : list of str
+        The tensors to keep.
+
+    Returns
+    -------
+    list of dragon_pb2.OperatorDef
+        The fused operators.
+
+    References
+    ----------
+    The wrapper of ``FuseElementwiseCC``.
+
+    `config.SetElementwiseFusion(*args, **kwargs)`_ - How to enable the elementwise fusion.
+
+    """
+    graph_def = pb.GraphDef()
+    graph_def.op.extend(forward_ops)
+    graph_def.target.extend(targets)
+    graph_def.ParseFromString(FuseElementwiseCC(graph_def.SerializeToString()))
+    return list(graph_def.op)
 
 
 def GraphDef_Device(meta_graph):
@@ -295,6 +351,14 @@ def function(inputs=None, outputs=None, givens=None, updater=None):
 
         forward_ops = external_input_ops + forward_ops
 
+    # fuse the elementwise operators, which also fuses their gradients
+    from dragon.config import option
+    if option['fuse_elementwise']:
+        targets = [output.name for output in outputs]
+        targets.extend(all_extra_targets)
+        for output in outputs: targets.extend(output.grad_wrts)
+        forward_ops = GraphDef_Fuse(forward_ops, targets)
+
     # handle grads
     if existing_grads:
         targets = [output.name for output in outputs]
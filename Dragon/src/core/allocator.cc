@@ -0,0 +1,240 @@
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+
+#include "core/allocator.h"
+#include "utils/logging.h"
+
+namespace dragon {
+
+//  64B, 80B, 96B, 112B, 128B, 160B, ..., 256MB
+#define CPU_ALLOCATOR_MIN_SHIFT 6
+#define CPU_ALLOCATOR_MAX_SHIFT 28
+#define CPU_ALLOCATOR_NUM_CLASSES \
+    ((CPU_ALLOCATOR_MAX_SHIFT - CPU_ALLOCATOR_MIN_SHIFT) * 4 + 1)
+
+//  blocks up to 1MB are cached by each thread before going to the arena
+#define CPU_ALLOCATOR_MAX_THREAD_CLASS 56
+#define CPU_ALLOCATOR_THREAD_CACHE_BYTES (8 << 20)
+
+//  the header is stored in front of each block,
+//  keep it one cache line to preserve the alignment of the user memory
+struct BlockHeader {
+    int cls;
+    size_t nbytes;
+    BlockHeader* next;
+};
+
+static_assert(sizeof(BlockHeader) <= CPU_ALLOCATOR_ALIGNMENT,
+    "The block header should be smaller than the alignment.");
+
+static std::atomic<int64_t> g_hits(0);
+static std::atomic<int64_t> g_misses(0);
+static std::atomic<int64_t> g_bytes_cached(0);
+static std::atomic<int64_t> g_bytes_in_use(0);
+static std::atomic<int64_t> g_cache_limit(int64_t(2) << 30);
+
+static thread_local int64_t tls_allocated_bytes = 0;
+
+static inline int SizeToClass(size_t nbytes) {
+    if (nbytes <= (1 << CPU_ALLOCATOR_MIN_SHIFT)) return 0;
+    int shift = 63 - __builtin_clzll((unsigned long long)(nbytes - 1));
+    if (shift >= CPU_ALLOCATOR_MAX_SHIFT) return -1;
+    size_t base = size_t(1) << shift, step = base >> 2;
+    int k = (int)((nbytes - base + step - 1) / step);
+    return (shift - CPU_ALLOCATOR_MIN_SHIFT) * 4 + k;
+}
+
+static inline size_t ClassToSize(int cls) {
+    if (cls == 0) return size_t(1) << CPU_ALLOCATOR_MIN_SHIFT;
+    int shift = CPU_ALLOCATOR_MIN_SHIFT + (cls - 1) / 4;
+    size_t base = size_t(1) << shift;
+    return base + ((cls - 1) % 4 + 1) * (base >> 2);
+}
+
+static inline BlockHeader* HeaderOf(void* ptr) {
+    return (BlockHeader*)((char*)ptr - CPU_ALLOCATOR_ALIGNMENT);
+}
+
+static inline void* DataOf(BlockHeader* block) {
+    return (char*)block + CPU_ALLOCATOR_ALIGNMENT;
+}
+
+static BlockHeader* SystemNew(int cls, size_t nbytes) {
+    void* raw = nullptr;
+    if (posix_memalign(&raw, CPU_ALLOCATOR_ALIGNMENT,
+            nbytes + CPU_ALLOCATOR_ALIGNMENT) != 0) return nullptr;
+    BlockHeader* block = (BlockHeader*)raw;
+    block->cls = cls;
+    block->nbytes = nbytes;
+    block->next = nullptr;
+    return block;
+}
+
+static void SystemDelete(BlockHeader* block) { free(block); }
+
+/******************** Global Arena ********************/
+
+class CPUArena {
+ public:
+    CPUArena() { for (int i = 0; i < CPU_ALLOCATOR_NUM_CLASSES; i++) heads_[i] = nullptr; }
+
+    BlockHeader* Pop(int cls) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        BlockHeader* block = heads_[cls];
+        if (block) heads_[cls] = block->next;
+        return block;
+    }
+
+    void Push(BlockHeader* block) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        block->next = heads_[block->cls];
+        heads_[block->cls] = block;
+    }
+
+    void Trim() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        for (int i = 0; i < CPU_ALLOCATOR_NUM_CLASSES; i++) {
+            while (heads_[i]) {
+                BlockHeader* block = heads_[i];
+                heads_[i] = block->next;
+                g_bytes_cached -= block->nbytes;
+                SystemDelete(block);
+            }
+        }
+    }
+
+ private:
+    BlockHeader* heads_[CPU_ALLOCATOR_NUM_CLASSES];
+    std::mutex mutex_;
+};
+
+//  never destroyed, the static tensors may be released after the exit
+static CPUArena* arena() {
+    static CPUArena* arena = new CPUArena();
+    return arena;
+}
+
+/******************** Thread Cache ********************/
+
+class CPUThreadCache {
+ public:
+    CPUThreadCache() : nbytes_(0) {
+        for (int i = 0; i <= CPU_ALLOCATOR_MAX_THREAD_CLASS; i++) heads_[i] = nullptr;
+    }
+
+    //  hand the cached blocks over to the arena when the thread exits
+    ~CPUThreadCache() { Flush(false); dead = true; }
+
+    BlockHeader* Pop(int cls) {
+        BlockHeader* block = heads_[cls];
+        if (block) { heads_[cls] = block->next; nbytes_ -= block->nbytes; }
+        return block;
+    }
+
+    bool Push(BlockHeader* block) {
+        if (nbytes_ + block->nbytes > CPU_ALLOCATOR_THREAD_CACHE_BYTES) return false;
+        block->next = heads_[block->cls];
+        heads_[block->cls] = block;
+        nbytes_ += block->nbytes;
+        return true;
+    }
+
+    void Flush(bool release) {
+        for (int i = 0; i <= CPU_ALLOCATOR_MAX_THREAD_CLASS; i++) {
+            while (heads_[i]) {
+                BlockHeader* block = heads_[i];
+                heads_[i] = block->next;
+                if (release) {
+                    g_bytes_cached -= block->nbytes;
+                    SystemDelete(block);
+                } else { arena()->Push(block); }
+            }
+        }
+        nbytes_ = 0;
+    }
+
+    static thread_local bool dead;
+
+ private:
+    BlockHeader* heads_[CPU_ALLOCATOR_MAX_THREAD_CLASS + 1];
+    size_t nbytes_;
+};
+
+thread_local bool CPUThreadCache::dead = false;
+
+static CPUThreadCache* thread_cache() {
+    if (CPUThreadCache::dead) return nullptr;
+    static thread_local CPUThreadCache cache;
+    return &cache;
+}
+
+/******************** Allocator ********************/
+
+void* CPUAllocator::New(size_t nbytes) {
+    int cls = SizeToClass(nbytes);
+    BlockHeader* block = nullptr;
+    if (cls >= 0) {
+        if (cls <= CPU_ALLOCATOR_MAX_THREAD_CLASS) {
+            CPUThreadCache* cache = thread_cache();
+            if (cache) block = cache->Pop(cls);
+        }
+        if (!block) block = arena()->Pop(cls);
+    }
+    if (block) {
+        g_hits++;
+        g_bytes_cached -= block->nbytes;
+    } else {
+        g_misses++;
+        block = SystemNew(cls, cls >= 0 ? ClassToSize(cls) : nbytes);
+        if (!block) {
+            //  the cache may hold the memory we need
+            Trim();
+            block = SystemNew(cls, cls >= 0 ? ClassToSize(cls) : nbytes);
+        }
+        CHECK(block) << "Malloc mem: " << nbytes << " bytes failed.";
+    }
+    g_bytes_in_use += block->nbytes;
+    tls_allocated_bytes += block->nbytes;
+    return DataOf(block);
+}
+
+void CPUAllocator::Delete(void* ptr) {
+    if (ptr == nullptr) return;
+    BlockHeader* block = HeaderOf(ptr);
+    g_bytes_in_use -= block->nbytes;
+    if (block->cls < 0 || g_bytes_cached + (int64_t)block->nbytes > g_cache_limit) {
+        SystemDelete(block);
+        return;
+    }
+    g_bytes_cached += block->nbytes;
+    if (block->cls <= CPU_ALLOCATOR_MAX_THREAD_CLASS) {
+        CPUThreadCache* cache = thread_cache();
+        if (cache && cache->Push(block)) return;
+    }
+    arena()->Push(block);
+}
+
+void CPUAllocator::Trim() {
+    CPUThreadCache* cache = thread_cache();
+    if (cache) cache->Flush(true);
+    arena()->Trim();
+}
+
+void CPUAllocator::SetCacheLimit(size_t nbytes) {
+    g_cache_limit = (int64_t)nbytes;
+    if (g_bytes_cached > g_cache_limit) Trim();
+}
+
+CPUAllocator::Stats CPUAllocator::GetStats() {
+    Stats stats;
+    stats.hits = g_hits;
+    stats.misses = g_misses;
+    stats.bytes_cached = g_bytes_cached;
+    stats.bytes_in_use = g_bytes_in_use;
+    return stats;
+}
+
+int64_t CPUAllocator::ThreadAllocatedBytes() { return tls_allocated_bytes; }
+
+}    // namespace dragon
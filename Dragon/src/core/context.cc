@@ -4,6 +4,7 @@
 namespace dragon {
 
 CPUObject CPUContext::cpu_object_;
+thread_local CPUContext* CPUContext::current_ = nullptr;
 #ifdef WITH_CUDA
 CUDAObject CUDAContext::cuda_object_;
 #endif // WITH_CUDA
@@ -1,6 +1,10 @@
+#include <cfloat>
+#include <functional>
+
 #include "core/operator_schema.h"
 #include "core/graph.h"
 #include "core/workspace.h"
+#include "utils/op_kernel.h"
 
 namespace dragon {
 
@@ -11,6 +15,7 @@ GraphBase::GraphBase(const GraphDef& meta_graph, Workspace* ws)
         CHECK_EQ(args_.count(arg.name()), 0);
         args_[arg.name()] = arg;
     }
+    if (args_.count("phase")) phase_ = args_["phase"].s();
     Set<string> known_tensors;
 
     //  topo-check for a graph
@@ -173,14 +178,54 @@ GraphDef Graph::Prune(const GraphDef& meta_graph) {
     return pruned_graph;
 }
 
+//  the operators computing the outputs only from the inputs and arguments
+static bool IsPure(const OperatorDef& op) {
+    static const Set<string> types({
+        "Add", "Sub", "Mul", "Div", "RAdd", "RSub", "RMul", "RDiv",
+        "Dot", "Matmul", "Eltwise", "GramMatrix", "InnerProduct",
+        "Scale", "Clip", "Exp", "Log", "Pow", "Square", "Relu", "PRelu",
+        "Elu", "SElu", "Sigmoid", "Tanh", "Softmax", "Arange", "Argmax",
+        "Argmin", "Concat", "Crop", "ExpandDims", "Fill", "Flatten",
+        "Gather", "OneHot", "Pad", "Reduce", "Repeat", "Reshape", "Shape",
+        "Slice", "Stack", "Tile", "Transpose", "Compare", "Copy",
+        "FloatToHalf", "Conv2d", "Conv2dTranspose", "Pooling2d", "LRN",
+        "L2Norm", "BilinearResize", "NNResize", "FusedElementwise",
+        "FoldAffine" });
+    if (!types.count(op.type()) || op.output_size() == 0) return false;
+    for (auto& output : op.output()) {
+        if (output == "ignore") return false;
+        for (auto& input : op.input())
+            if (input == output) return false;
+    }
+    return true;
+}
+
+//  the operators may share the memory of inputs with the outputs
+static bool IsView(const OperatorDef& op) {
+    static const Set<string> types({
+        "Reshape", "Flatten", "ExpandDims", "Concat", "Stack", "Slice",
+        "Crop", "Pad", "BiasAdd", "FloatToHalf" });
+    return types.count(op.type()) > 0;
+}
+
 GraphDef Graph::Share(const GraphDef& optimized_graph) {
     renamed_.clear();
 
+    //  the constants and the views of them should not be overwritten
+    Set<string> constants(constants_);
+    for (auto& op : optimized_graph.op())
+        if (IsView(op))
+            for (auto& input : op.input())
+                if (constants.count(input))
+                    for (auto& output : op.output()) constants.insert(output);
+
     //  forward dyeing to search available tensors that be shared
     for (int i = 0; i < optimized_graph.op_size(); i++) {
         const OperatorDef& op = optimized_graph.op(i);
-        for (auto& u : op.input()) ForwardShareDyeing(u, u);
-        for (auto& v : op.output()) ForwardShareDyeing(v, v);
+        for (auto& u : op.input())
+            if (!constants.count(u)) ForwardShareDyeing(u, u);
+        for (auto& v : op.output())
+            if (!constants.count(v)) ForwardShareDyeing(v, v);
     }
 
     GraphDef shared_graph;
@@ -205,9 +250,505 @@ GraphDef Graph::Share(const GraphDef& optimized_graph) {
     return shared_graph;
 }
 
+static const Argument* FindArgument(const OperatorDef& op, const string& name) {
+    for (auto& arg : op.arg())
+        if (arg.name() == name) return &arg;
+    return nullptr;
+}
+
+//  the tensors read through the arguments, e.g. "shape_like" or "dims_desc"
+static vector<string> ArgumentTensors(const OperatorDef& op,
+                                      const Map<string, int>& outputs,
+                                      Workspace* ws) {
+    vector<string> tensors;
+    auto is_tensor = [&](const string& name) {
+        return outputs.count(name) > 0 || ws->HasTensor(name);
+    };
+    for (auto& arg : op.arg()) {
+        if (arg.name() == "anchor") continue;
+        if (arg.has_s() && is_tensor(arg.s())) tensors.push_back(arg.s());
+        for (auto& s : arg.strings())
+            if (is_tensor(s)) tensors.push_back(s);
+    }
+    return tensors;
+}
+
+GraphDef Graph::FoldInference(const GraphDef& meta_graph) {
+    Set<string> targets;
+    for (auto& target : meta_graph.target()) targets.insert(target);
+
+    //  the first operator reading the tensor after op(i)
+    auto next_reader = [&](const string& name, int i) {
+        for (int k = i + 1; k < meta_graph.op_size(); k++)
+            for (auto& input : meta_graph.op(k).input())
+                if (input == name) return k;
+        return -1;
+    };
+
+    //  whether the tensor written by op(i) is read by op(j) only once,
+    //  i.e. it can be dropped if op(j) is folded into op(i)
+    auto private_to = [&](const string& name, int i, int j) {
+        bool found = false;
+        for (int k = i + 1; k < meta_graph.op_size(); k++) {
+            const OperatorDef& op = meta_graph.op(k);
+            for (auto& input : op.input()) {
+                if (input != name) continue;
+                if (k != j || found) return false;
+                found = true;
+            }
+            for (auto& output : op.output())
+                if (output == name) return found;
+        }
+        return found && !targets.count(name);
+    };
+
+    vector<bool> removed(meta_graph.op_size(), false);
+    Map<int, vector<OperatorDef> > folded;
+    for (int i = 0; i < meta_graph.op_size(); i++) {
+        const OperatorDef& op = meta_graph.op(i);
+        if (removed[i] || op.output_size() != 1 || op.input_size() < 2) continue;
+        if (op.type() != "Conv2d" && op.type() != "InnerProduct") continue;
+
+        //  the channel axis of the output and the weights
+        int ndim, axis, weight_axis;
+        if (op.type() == "Conv2d") {
+            const Argument* arg = FindArgument(op, "data_format");
+            bool nhwc = arg && arg->s() == "NHWC";
+            ndim = 4; axis = nhwc ? 3 : 1; weight_axis = nhwc ? 3 : 0;
+        } else {
+            const Argument* arg = FindArgument(op, "TransW");
+            ndim = 2; axis = 1; weight_axis = (!arg || arg->b()) ? 0 : 1;
+        }
+
+        //  match: layer -> [BatchNorm | FusedBatchNorm] -> [Scale] -> [Relu]
+        vector<int> chain;
+        vector<string> stages, params;
+        vector<float> eps;
+        const Argument* slope = nullptr;
+        bool relu = false;
+        string y = op.output(0);
+        int last = i, j = next_reader(y, i);
+        auto accept = [&](const string& type) {
+            if (j < 0 || meta_graph.op(j).type() != type) return false;
+            const OperatorDef& next = meta_graph.op(j);
+            if (next.input(0) != y || next.output_size() != 1) return false;
+            return private_to(y, last, j);
+        };
+        auto advance = [&]() {
+            chain.push_back(j);
+            last = j;
+            y = meta_graph.op(j).output(0);
+            j = next_reader(y, j);
+        };
+        if (accept("BatchNorm") || accept("FusedBatchNorm")) {
+            const OperatorDef& bn = meta_graph.op(j);
+            const Argument* bn_axis = FindArgument(bn, "axis");
+            const Argument* use_stats = FindArgument(bn, "use_stats");
+            const Argument* bn_eps = FindArgument(bn, "eps");
+            const Argument* mode = FindArgument(bn, "mode");
+            bool caffe = mode && mode->s() == "CAFFE";
+            int channel_axis = (!bn_axis || bn_axis->i() == -1) ? ndim - 1 : 1;
+            bool fused = bn.type() == "FusedBatchNorm";
+            //  mean, var, [factor | scale, bias]
+            int num_params = fused ? 4 : (caffe ? 3 : 2);
+            if (channel_axis == axis && (!use_stats || use_stats->i() != 0) &&
+                    bn.input_size() > num_params) {
+                stages.push_back(caffe && !fused ? "norm_caffe" : "norm");
+                eps.push_back(bn_eps ? bn_eps->f() : 1e-3f);
+                if (fused) stages.push_back("scale_bias");
+                for (int k = 1; k <= num_params; k++) params.push_back(bn.input(k));
+                advance();
+            }
+        }
+        if (accept("Scale")) {
+            const OperatorDef& scale = meta_graph.op(j);
+            const Argument* scale_axis = FindArgument(scale, "axis");
+            const Argument* num_axes = FindArgument(scale, "num_axes");
+            int start_axis = scale_axis ? scale_axis->i() : 1;
+            if (start_axis < 0) start_axis += ndim;
+            int n = num_axes ? num_axes->i() : 1;
+            if (n == -1) n = ndim - start_axis;
+            else if (n == 0) n = 1;
+            if (start_axis == axis && n == 1) {
+                stages.push_back(scale.input_size() > 2 ? "scale_bias" : "scale");
+                for (int k = 1; k < scale.input_size(); k++) params.push_back(scale.input(k));
+                advance();
+            }
+        }
+        if (accept("Relu")) {
+            slope = FindArgument(meta_graph.op(j), "slope");
+            relu = true;
+            advance();
+        }
+        if (chain.empty()) continue;
+
+        //  the operators between the chain should not touch the fused result
+        //  the weights may be restored after creating, only require them to exist
+        bool valid = stages.empty() || ws()->HasTensor(op.input(1));
+        Set<string> chain_tensors(params.begin(), params.end());
+        chain_tensors.insert(y);
+        for (auto& param : params) valid &= ws()->HasTensor(param);
+        for (int k = i + 1, c = 0; k < last && valid; k++) {
+            if (c < chain.size() && chain[c] == k) { c++; continue; }
+            for (auto& input : meta_graph.op(k).input())
+                valid &= (input != y);
+            for (auto& output : meta_graph.op(k).output())
+                valid &= !chain_tensors.count(output);
+        }
+        if (!valid) continue;
+
+        OperatorDef layer(op);
+        *layer.mutable_output(0) = y;
+        if (!stages.empty()) {
+            string weights = "/mnt/fold/" + y + "/weights";
+            string bias = "/mnt/fold/" + y + "/bias";
+            vector<string> inputs({ op.input(1) });
+            if (op.input_size() > 2) inputs.push_back(op.input(2));
+            inputs.insert(inputs.end(), params.begin(), params.end());
+            vector<Argument> args(4);
+            args[0].set_name("axis"); args[0].set_i(weight_axis);
+            args[1].set_name("has_bias"); args[1].set_b(op.input_size() > 2);
+            args[2].set_name("stages");
+            for (auto& stage : stages) args[2].add_strings(stage);
+            args[3].set_name("eps");
+            for (auto e : eps) args[3].add_floats(e);
+            OperatorDef fold_op = MakeOperatorDef("FoldAffine", op.name() + "_fold",
+                inputs, vector<string>({ weights, bias }), args);
+            if (op.has_device_option())
+                fold_op.mutable_device_option()->CopyFrom(op.device_option());
+            folded[i].push_back(fold_op);
+            *layer.mutable_input(1) = weights;
+            if (op.input_size() > 2) *layer.mutable_input(2) = bias;
+            else layer.add_input(bias);
+        }
+        if (relu) {
+            Argument* arg = layer.add_arg();
+            arg->set_name("activation"); arg->set_s("Relu");
+            arg = layer.add_arg();
+            arg->set_name("slope"); arg->set_f(slope ? slope->f() : 0.f);
+        }
+        folded[i].push_back(layer);
+        for (auto k : chain) removed[k] = true;
+        LOG(DEBUG) << "Fold " << chain.size() << " operators into "
+                   << op.type() << "(" << op.name() << ")";
+    }
+
+    GraphDef folded_graph;
+    folded_graph.CopyFrom(meta_graph);
+    folded_graph.clear_op();
+    for (int i = 0; i < meta_graph.op_size(); i++) {
+        if (removed[i]) continue;
+        if (!folded.count(i)) folded_graph.add_op()->CopyFrom(meta_graph.op(i));
+        else for (auto& op : folded[i]) folded_graph.add_op()->CopyFrom(op);
+    }
+    return folded_graph;
+}
+
+GraphDef Graph::EliminateCommon(const GraphDef& meta_graph) {
+    //  the tensors named by users or the gradients can not be renamed
+    Set<string> targets, anchors, arg_tensors;
+    for (auto& target : meta_graph.target()) targets.insert(target);
+    for (auto& g_target : meta_graph.g_target()) {
+        targets.insert(g_target.cost());
+        targets.insert(g_target.wrt());
+        targets.insert(g_target.external());
+    }
+    Map<string, int> num_writes;
+    for (auto& op : meta_graph.op()) {
+        for (auto& output : op.output()) num_writes[output]++;
+        const Argument* anchor = FindArgument(op, "anchor");
+        if (anchor) anchors.insert(anchor->s());
+    }
+    for (auto& op : meta_graph.op())
+        for (auto& tensor : ArgumentTensors(op, num_writes, ws()))
+            arg_tensors.insert(tensor);
+
+    //  an expression is the operator without the name and outputs,
+    //  with the times that each input has been written
+    Map<string, int> versions, exprs;
+    Map<string, string> renamed;
+    GraphDef eliminated_graph;
+    eliminated_graph.CopyFrom(meta_graph);
+    eliminated_graph.clear_op();
+    for (int i = 0; i < meta_graph.op_size(); i++) {
+        OperatorDef op(meta_graph.op(i));
+        for (auto& input : *op.mutable_input())
+            if (renamed.count(input)) input = renamed[input];
+        string expr;
+        bool candidate = IsPure(op) && !anchors.count(op.name());
+        for (auto& output : op.output()) candidate &= num_writes[output] == 1;
+        if (candidate) {
+            OperatorDef expr_def(op);
+            expr_def.clear_name();
+            expr_def.clear_output();
+            expr = expr_def.SerializeAsString();
+            for (auto& input : op.input())
+                expr += "/" + dragon_cast<string, int>(versions[input]);
+            for (auto& tensor : ArgumentTensors(op, num_writes, ws()))
+                expr += "/" + tensor + ":" + dragon_cast<string, int>(versions[tensor]);
+        }
+        if (candidate && exprs.count(expr)) {
+            const OperatorDef& origin = eliminated_graph.op(exprs[expr]);
+            bool replaceable = true;
+            for (auto& output : op.output())
+                replaceable &= !targets.count(output) && !arg_tensors.count(output);
+            if (replaceable) {
+                for (int j = 0; j < op.output_size(); j++)
+                    renamed[op.output(j)] = origin.output(j);
+                LOG(DEBUG) << "Eliminate " << op.type() << "(" << op.name() << "), "
+                           << "which is computed by " << origin.name();
+                continue;
+            }
+        }
+        for (auto& output : op.output()) versions[output]++;
+        if (candidate && !exprs.count(expr)) exprs[expr] = eliminated_graph.op_size();
+        eliminated_graph.add_op()->CopyFrom(op);
+    }
+    LOG(DEBUG) << "Eliminate " << meta_graph.op_size() - eliminated_graph.op_size()
+               << " common operators of Graph(" << name() << ")";
+    return eliminated_graph;
+}
+
+GraphDef Graph::FoldConstant(const GraphDef& meta_graph,
+                             vector<OperatorDef>* constant_ops) {
+    Set<string> anchors;
+    Map<string, int> num_writes;
+    for (auto& op : meta_graph.op()) {
+        for (auto& output : op.output()) num_writes[output]++;
+        const Argument* anchor = FindArgument(op, "anchor");
+        if (anchor) anchors.insert(anchor->s());
+    }
+
+    //  the inputs of BiasAdd are written in-place, so as their views
+    Set<string> mutated;
+    for (int i = meta_graph.op_size() - 1; i >= 0; i--) {
+        const OperatorDef& op = meta_graph.op(i);
+        if (op.type() == "BiasAdd" && op.input_size() > 0) mutated.insert(op.input(0));
+        if (!IsView(op)) continue;
+        bool view_mutated = false;
+        for (auto& output : op.output()) view_mutated |= mutated.count(output) > 0;
+        if (view_mutated) for (auto& input : op.input()) mutated.insert(input);
+    }
+
+    //  the pure operators reading only the constants are constant,
+    //  e.g. Fill and Arange, or the Reshape of them.
+    //  the weights are not constants, which may be updated by other graphs
+    constants_.clear();
+    GraphDef folded_graph;
+    folded_graph.CopyFrom(meta_graph);
+    folded_graph.clear_op();
+    for (auto& op : meta_graph.op()) {
+        bool constant = IsPure(op) && !anchors.count(op.name());
+        for (auto& input : op.input()) constant &= constants_.count(input) > 0;
+        for (auto& tensor : ArgumentTensors(op, num_writes, ws()))
+            constant &= constants_.count(tensor) > 0;
+        for (auto& output : op.output())
+            constant &= num_writes[output] == 1 && !mutated.count(output);
+        if (!constant) {
+            folded_graph.add_op()->CopyFrom(op);
+            continue;
+        }
+        constant_ops->push_back(op);
+        if (!op.has_device_option() && meta_graph.has_device_option())
+            constant_ops->back().mutable_device_option()
+                ->CopyFrom(meta_graph.device_option());
+        //  the outputs are evaluated after the creation
+        for (auto& output : op.output()) {
+            constants_.insert(output);
+            ws()->CreateTensor(output);
+        }
+        LOG(DEBUG) << "Fold the constant " << op.type() << "(" << op.name() << ")";
+    }
+    return folded_graph;
+}
+
+GraphDef FuseElementwise(const GraphDef& meta_graph) {
+    static const Set<string> binary_types({ "Add", "Sub", "Mul", "Div" });
+    static const Set<string> unary_types({ "Relu", "Elu", "Sigmoid",
+        "Tanh", "Exp", "Log", "Square", "Pow", "Clip" });
+    Set<string> targets;
+    for (auto& target : meta_graph.target()) targets.insert(target);
+    for (auto& g_target : meta_graph.g_target()) {
+        targets.insert(g_target.cost());
+        targets.insert(g_target.wrt());
+    }
+    Map<string, int> num_reads, num_writes, producer;
+    for (auto& op : meta_graph.op()) {
+        for (auto& input : op.input()) num_reads[input]++;
+        for (auto& output : op.output()) num_writes[output]++;
+    }
+
+    //  the elementwise operators writing a new tensor
+    const int num_ops = meta_graph.op_size();
+    vector<bool> fusible(num_ops, false);
+    for (int i = 0; i < num_ops; i++) {
+        const OperatorDef& op = meta_graph.op(i);
+        int num_inputs = binary_types.count(op.type()) ? 2 :
+            (unary_types.count(op.type()) ? 1 : 0);
+        if (num_inputs == 0 || op.input_size() != num_inputs ||
+            op.output_size() != 1 || num_writes[op.output(0)] != 1) continue;
+        const Argument* mirror_stage = FindArgument(op, "mirror_stage");
+        if (mirror_stage && mirror_stage->b()) continue;
+        bool inplace = false;
+        for (auto& input : op.input()) inplace |= (input == op.output(0));
+        if (inplace) continue;
+        fusible[i] = true;
+        producer[op.output(0)] = i;
+    }
+
+    //  grow a tree from each root in reverse, absorbing the producers
+    //  whose results are read by the tree only, and not the targets
+    vector<bool> merged(num_ops, false);
+    Map<int, OperatorDef> fused;
+    for (int i = num_ops - 1; i >= 0; i--) {
+        if (!fusible[i] || merged[i]) continue;
+        const OperatorDef& root = meta_graph.op(i);
+        const string device = root.device_option().SerializeAsString();
+        vector<int> members;
+        Set<string> reads, writes;
+        //  the number of values if op(p) is absorbed
+        auto num_values = [&](const OperatorDef& op) {
+            int num_inputs = 0;
+            Set<string> new_reads(reads);
+            for (auto& input : op.input()) new_reads.insert(input);
+            for (auto& input : new_reads)
+                num_inputs += !writes.count(input) && input != op.output(0);
+            return (int)members.size() + 1 + num_inputs;
+        };
+        std::function<void(int)> collect = [&](int k) {
+            members.push_back(k);
+            for (auto& input : meta_graph.op(k).input()) reads.insert(input);
+            writes.insert(meta_graph.op(k).output(0));
+            for (auto& input : meta_graph.op(k).input()) {
+                if (!producer.count(input)) continue;
+                const int p = producer[input];
+                const OperatorDef& op = meta_graph.op(p);
+                if (p >= k || merged[p] || num_reads[input] != 1 ||
+                    targets.count(input) ||
+                    op.device_option().SerializeAsString() != device ||
+                    num_values(op) > FUSED_MAX_VALUES) continue;
+                collect(p);
+            }
+        };
+        collect(i);
+        if (members.size() < 2) continue;
+        std::sort(members.begin(), members.end());
+
+        //  the inputs should not be rewritten before the root
+        Set<string> intermediates;
+        for (auto k : members) intermediates.insert(meta_graph.op(k).output(0));
+        vector<string> inputs;
+        Map<string, int> values;
+        bool valid = true;
+        for (int c = 0; c < members.size(); c++) {
+            for (auto& input : meta_graph.op(members[c]).input()) {
+                if (intermediates.count(input)) continue;
+                if (!values.count(input)) {
+                    values[input] = (int)inputs.size();
+                    inputs.push_back(input);
+                }
+                for (int k = members[c] + 1, m = c + 1; k < i && valid; k++) {
+                    if (m < members.size() && members[m] == k) { m++; continue; }
+                    for (auto& output : meta_graph.op(k).output())
+                        valid &= (output != input);
+                }
+            }
+        }
+        if (!valid) continue;
+
+        vector<Argument> args(3);
+        args[0].set_name("ops");
+        args[1].set_name("operands");
+        args[2].set_name("params");
+        for (int c = 0; c < members.size(); c++) {
+            const OperatorDef& op = meta_graph.op(members[c]);
+            values[op.output(0)] = (int)inputs.size() + c;
+            args[0].add_strings(op.type());
+            args[1].add_ints(values[op.input(0)]);
+            args[1].add_ints(op.input_size() > 1 ? values[op.input(1)] : -1);
+            auto param = [&](const string& name, float default_value) {
+                const Argument* arg = FindArgument(op, name);
+                args[2].add_floats(arg ? arg->f() : default_value);
+            };
+            if (op.type() == "Relu") param("slope", 0.f);
+            else if (op.type() == "Elu") param("alpha", 1.f);
+            else if (op.type() == "Pow") {
+                param("power", 1.f); param("scale", 1.f); param("shift", 0.f);
+            } else if (op.type() == "Clip") {
+                param("low", -FLT_MAX); param("high", FLT_MAX);
+            }
+            while (args[2].floats_size() < 3 * (c + 1)) args[2].add_floats(0.f);
+        }
+        OperatorDef fused_op = MakeOperatorDef("FusedElementwise", root.name(),
+            inputs, vector<string>({ root.output(0) }), args);
+        if (root.has_device_option())
+            fused_op.mutable_device_option()->CopyFrom(root.device_option());
+        fused[i] = fused_op;
+        for (auto k : members) merged[k] = true;
+        LOG(DEBUG) << "Fuse " << members.size() << " elementwise operators "
+                   << "into FusedElementwise(" << root.name() << ")";
+    }
+
+    GraphDef fused_graph;
+    fused_graph.CopyFrom(meta_graph);
+    fused_graph.clear_op();
+    for (int i = 0; i < num_ops; i++) {
+        if (fused.count(i)) fused_graph.add_op()->CopyFrom(fused[i]);
+        else if (!merged[i]) fused_graph.add_op()->CopyFrom(meta_graph.op(i));
+    }
+    return fused_graph;
+}
+
+Map<string, TensorProto> InferShapes(const GraphDef& meta_graph,
+                                     Workspace* ws,
+                                     string* error) {
+    Map<string, TensorProto> shapes;
+    //  the outputs can not be inferred, which are not read from workspace
+    Set<string> unknowns;
+    auto known = [&](const string& name) -> const TensorProto* {
+        if (shapes.count(name)) return &shapes[name];
+        if (unknowns.count(name)) return nullptr;
+        if (name == "ignore" || !ws->HasTensor(name)) return nullptr;
+        Tensor* tensor = ws->GetTensor(name);
+        if (tensor->count() == 0) return nullptr;
+        const TypeMeta& meta = tensor->meta();
+        TensorProto::DataType data_type;
+        if (meta == TypeMeta::Make<float>()) data_type = TensorProto::FLOAT;
+        else if (meta == TypeMeta::Make<int>()) data_type = TensorProto::INT32;
+        else if (meta == TypeMeta::Make<uint8_t>()) data_type = TensorProto::BYTE;
+        else if (meta == TypeMeta::Make<float16>()) data_type = TensorProto::FLOAT16;
+        else return nullptr;
+        shapes[name] = TensorShape(tensor->dims(), data_type);
+        return &shapes[name];
+    };
+    for (auto& op : meta_graph.op()) {
+        vector<TensorProto> inputs;
+        for (auto& input : op.input()) {
+            const TensorProto* shape = known(input);
+            inputs.push_back(shape ? *shape : TensorProto());
+        }
+        vector<TensorProto> outputs = OpSchemaRegistry::Schema(op.type())->InferShape(op, inputs, error);
+        if (error && !error->empty()) break;
+        for (int i = 0; i < op.output_size(); i++) {
+            if (op.output(i) == "ignore") continue;
+            //  an unknown output hides the stale shape of an in-place input
+            if (outputs.empty()) {
+                shapes.erase(op.output(i));
+                unknowns.insert(op.output(i));
+            } else {
+                shapes[op.output(i)] = outputs[i];
+                unknowns.erase(op.output(i));
+            }
+        }
+    }
+    return shapes;
+}
+
 GraphDef Graph::MakeUpdate(const GraphDef& meta_graph) {
     OperatorDef collective_op;
     collective_op.set_type("CollectiveUpdate");
+    //  the states of collectives are stored under the name
+    collective_op.set_name(name() + "_Collective");
 
     //  make update ops
     vector<OperatorDef> update_ops;
@@ -240,8 +781,14 @@ GraphDef Graph::MakeUpdate(const GraphDef& meta_graph) {
     //  make collective ops if necessary
     vector<OperatorDef> collective_ops;
     if (this->args_.count("parallel_mode")) {
+        /*
+            MIXED reduces within the nodes before across them, see:
+                Accurate, Large Minibatch SGD: Training ImageNet in 1 Hour
+                Link: http://arxiv.org/abs/1706.02677
+        */
         if (this->args_["parallel_mode"].s() == "MPI" ||
-            this->args_["parallel_mode"].s() == "NCCL") {
+            this->args_["parallel_mode"].s() == "NCCL" ||
+            this->args_["parallel_mode"].s() == "MIXED") {
             OperatorDef op_def;
             op_def.CopyFrom(collective_op);
             Argument collective_mode;
@@ -257,16 +804,49 @@ GraphDef Graph::MakeUpdate(const GraphDef& meta_graph) {
             } else {
                 LOG(FATAL) << "MPI was not initialized.";
             }
+            //  the fusion buckets, the overlapped reduction and the compression
+            for (auto& key : { "bucket_size", "overlap", "compression", "topk_ratio" })
+                if (this->args_.count(key)) op_def.add_arg()->CopyFrom(this->args_[key]);
+            collective_ops.push_back(op_def);
+        } else if (this->args_["parallel_mode"].s() == "SHM") {
+            OperatorDef op_def;
+            op_def.CopyFrom(collective_op);
+            op_def.set_type("SHMCollectiveUpdate");
+            Argument collective_mode;
+            collective_mode.set_name("mode");
+            collective_mode.set_s("SHM_ALLREDUCE");
+            op_def.add_arg()->CopyFrom(collective_mode);
+            if (this->args_.count("shm_key") &&
+                this->args_.count("shm_rank") &&
+                this->args_.count("shm_size")) {
+                //  each update graph owns a segment
+                Argument key;
+                key.set_name("shm_key");
+                key.set_s(this->args_["shm_key"].s() + "_" + name());
+                op_def.add_arg()->CopyFrom(key);
+                op_def.add_arg()->CopyFrom(this->args_["shm_rank"]);
+                op_def.add_arg()->CopyFrom(this->args_["shm_size"]);
+            } else {
+                LOG(FATAL) << "SHM was not initialized.";
+            }
             collective_ops.push_back(op_def);
-        } else if (this->args_["parallel_mode"].s() == "MIXED") {
-            /*
-                See:  Accurate, Large Minibatch SGD: Training ImageNet in 1 Hour
-                Link: http://arxiv.org/abs/1706.02677
-            */
-            NOT_IMPLEMENTED;
         }
     }
 
+    //  multi-tensor apply if necessary,
+    //  the parameters filled lazily are still empty before the first running,
+    //  in which case the grouping is deferred to it
+    if (this->args_.count("multi_tensor_update") &&
+        this->args_["multi_tensor_update"].i() > 0) {
+        bool filled = true;
+        for (auto& op : update_ops)
+            filled &= ws()->GetTensor(op.output(0))->count() > 0;
+        if (filled) update_ops = MergeUpdate(update_ops,
+            this->args_["multi_tensor_update"].i());
+        else pending_updates_ = update_ops;
+    }
+    num_updates_ = (int)update_ops.size();
+
     //  generate graph
     GraphDef update_graph;
     update_graph.CopyFrom(meta_graph);
@@ -276,6 +856,90 @@ GraphDef Graph::MakeUpdate(const GraphDef& meta_graph) {
     return update_graph;
 }
 
+vector<OperatorDef> Graph::MergeUpdate(const vector<OperatorDef>& update_ops,
+                                       const int max_count) {
+    //  the parameters with at most max_count elements are merged,
+    //  if they share the updater and its arguments except the multipliers,
+    //  each of them keeps its own slot, thus the same states as before
+    vector<OperatorDef> merged_ops;
+    Map<string, int> groups;
+    for (auto& op : update_ops) {
+        const TIndex count = ws()->GetTensor(op.output(0))->count();
+        if (count == 0 || count > max_count) {
+            merged_ops.push_back(op);
+            continue;
+        }
+        float lr_mult = 1.0, decay_mult = 1.0;
+        string slot;
+        std::map<string, string> common_args;
+        for (auto& arg : op.arg()) {
+            if (arg.name() == "lr_mult") lr_mult = arg.f();
+            else if (arg.name() == "decay_mult") decay_mult = arg.f();
+            else if (arg.name() == "slot") slot = arg.s();
+            else common_args[arg.name()] = arg.SerializeAsString();
+        }
+        string key = op.type();
+        for (auto& it : common_args) key += "/" + it.second;
+        if (!groups.count(key)) {
+            OperatorDef merged_op;
+            merged_op.set_type(op.type());
+            merged_op.set_name(op.name());
+            for (auto& arg : op.arg()) {
+                if (arg.name() == "lr_mult" || arg.name() == "decay_mult" ||
+                    arg.name() == "slot") continue;
+                merged_op.add_arg()->CopyFrom(arg);
+            }
+            merged_op.add_arg()->set_name("lr_mults");
+            merged_op.add_arg()->set_name("decay_mults");
+            merged_op.add_arg()->set_name("slots");
+            groups[key] = (int)merged_ops.size();
+            merged_ops.push_back(merged_op);
+        }
+        OperatorDef& merged_op = merged_ops[groups[key]];
+        merged_op.add_input(op.input(0));
+        merged_op.add_output(op.output(0));
+        const int num_args = merged_op.arg_size();
+        merged_op.mutable_arg(num_args - 3)->add_floats(lr_mult);
+        merged_op.mutable_arg(num_args - 2)->add_floats(decay_mult);
+        merged_op.mutable_arg(num_args - 1)->add_strings(slot.empty() ? op.name() : slot);
+    }
+    return merged_ops;
+}
+
+bool Graph::MergePendingUpdates() {
+    if (pending_updates_.empty()) return false;
+    vector<OperatorDef> update_ops = MergeUpdate(pending_updates_,
+        this->args_["multi_tensor_update"].i());
+    pending_updates_.clear();
+
+    //  the update operators follow the collectives,
+    //  recreate them and keep the slots, thus the same states as before
+    Tensor* string_tensor = ws()->GetTensor("GraphDef_" + name());
+    string* data = string_tensor->mutable_data<string, CPUContext>();
+    GraphDef graph_def;
+    graph_def.ParseFromString(data[0]);
+    const int first = (int)ops_.size() - num_updates_;
+    for (int i = first; i < ops_.size(); i++) delete ops_[i];
+    ops_.resize(first);
+    graph_def.mutable_op()->DeleteSubrange(first, num_updates_);
+    GraphDef merged_graph(graph_def);
+    merged_graph.clear_op();
+    for (auto& op : update_ops) {
+        graph_def.add_op()->CopyFrom(op);
+        merged_graph.add_op()->CopyFrom(op);
+    }
+    Create(merged_graph, ws());
+    num_updates_ = (int)update_ops.size();
+    data[0] = graph_def.SerializeAsString();
+
+    //  the compiled plans point to the released operators
+    plans_.clear();
+    last_plan_ = nullptr;
+    LOG(DEBUG) << "Graph(" << name() << ") merges the updates into "
+               << num_updates_ << " operators.";
+    return true;
+}
+
 bool Graph::Create(const GraphDef& optimized_graph, Workspace* ws) {
     bool has_device_option = optimized_graph.has_device_option();
     bool has_debug_mode = optimized_graph.has_debug_mode();
@@ -375,15 +1039,36 @@ void Graph::RecomputingAware(const GraphDef& optimized_graph, Workspace* ws) {
 }
 
 Graph::Graph(const GraphDef& meta_graph, Workspace* ws)
-    : GraphBase(meta_graph, ws) {
+    : GraphBase(meta_graph, ws), bind_memory_(false),
+      plan_pending_(false), profiling_(false), num_updates_(0),
+      bind_hooks_(meta_graph.u_target_size() == 0), hook_version_(-1),
+      last_plan_(nullptr) {
     GraphDef optimized_graph;
+    vector<OperatorDef> constant_ops;
     if (meta_graph.u_target_size() > 0) {
         //  check if existing any update requests
         //  note that graph with update ops is not a dag
         //  we handle them independently
         optimized_graph = MakeUpdate(meta_graph);
     } else {
-        optimized_graph = Prune(meta_graph);
+        optimized_graph = meta_graph;
+        //  fold the affine operators into the layers for inference
+        bool fold = this->args_["phase"].s() == "TEST" &&
+            meta_graph.g_target_size() == 0;
+        if (this->args_.count("fold_inference"))
+            fold &= this->args_["fold_inference"].i() > 0;
+        if (fold) optimized_graph = FoldInference(optimized_graph);
+        if (this->args_.count("fuse_elementwise") &&
+            this->args_["fuse_elementwise"].i() > 0)
+            optimized_graph = FuseElementwise(optimized_graph);
+        //  reuse the same expressions and fold the constant ones
+        if (this->args_.count("eliminate_common") &&
+            this->args_["eliminate_common"].i() > 0)
+            optimized_graph = EliminateCommon(optimized_graph);
+        if (this->args_.count("fold_constant") &&
+            this->args_["fold_constant"].i() > 0)
+            optimized_graph = FoldConstant(optimized_graph, &constant_ops);
+        optimized_graph = Prune(optimized_graph);
         optimized_graph = Share(optimized_graph);
     }
 
@@ -398,25 +1083,330 @@ Graph::Graph(const GraphDef& meta_graph, Workspace* ws)
 
     //  recomputing-aware
     RecomputingAware(optimized_graph, ws);
+
+    //  evaluate the folded constants once, if still required
+    Set<string> required;
+    auto require = [&required](const OperatorDef& op) {
+        for (auto& input : op.input()) required.insert(input);
+        for (auto& arg : op.arg()) {
+            if (arg.has_s()) required.insert(arg.s());
+            for (auto& s : arg.strings()) required.insert(s);
+        }
+    };
+    for (auto& op : optimized_graph.op()) require(op);
+    for (auto& target : optimized_graph.target()) required.insert(target);
+    for (int i = (int)constant_ops.size() - 1; i >= 0; i--) {
+        bool useful = false;
+        for (auto& output : constant_ops[i].output())
+            useful |= required.count(output) > 0;
+        if (useful) require(constant_ops[i]);
+        else constant_ops[i].clear_type();
+    }
+    for (auto& op_def : constant_ops) {
+        if (op_def.type().empty()) continue;
+        unique_ptr<OperatorBase> op(CreateOperator(op_def, ws));
+        op->SwitchToPhase(this->args_["phase"].s());
+        op->Run();
+    }
+
+    if (this->args_.count("profile"))
+        profiling_ = this->args_["profile"].i() > 0;
+
+    //  plan the intermediate tensors over the final operators
+    bool mirror_stage = false;
+    for (auto* op : ops_)
+        mirror_stage |= op->GetSingleArg<bool>("mirror_stage", false);
+    if (meta_graph.u_target_size() == 0 && !mirror_stage &&
+            !optimized_graph.debug_mode()) {
+        Set<string> targets;
+        for (auto& target : optimized_graph.target())
+            targets.insert(ws->GetTensorName(target));
+        for (auto& g_target : optimized_graph.g_target()) {
+            targets.insert(ws->GetTensorName(g_target.wrt() + "_grad"));
+            if (!g_target.external().empty())
+                targets.insert(ws->GetTensorName(g_target.external()));
+        }
+        planner_.reset(new MemoryPlanner(ops_, targets, ws));
+        if (this->args_.count("memory_plan"))
+            bind_memory_ = this->args_["memory_plan"].i() > 0;
+    }
+}
+
+void Graph::BindHooks() {
+    //  the hooks are not bound by the update graphs,
+    //  which consume the gradients instead of producing them
+    hook_version_ = ws()->hook_version();
+    write_hooks_.assign(ops_.size(), vector<string>());
+    ready_hooks_.assign(ops_.size(), vector<string>());
+    Map<string, int> last_writer;
+    for (int i = 0; i < ops_.size(); i++) {
+        for (int j = 0; j < ops_[i]->OutputSize(); j++) {
+            const string& name = ops_[i]->Output(j)->name();
+            if (!ws()->HasTensorHook(name)) continue;
+            write_hooks_[i].push_back(name);
+            last_writer[name] = i;
+        }
+    }
+    for (auto& it : last_writer) ready_hooks_[it.second].push_back(it.first);
+}
+
+void Graph::PlanMemory() {
+    plan_pending_ = false;
+    if (!planner_->Plan()) return;
+    if (bind_memory_) planner_->Bind();
+    LOG(DEBUG) << "Graph(" << name() << ") plans "
+               << planner_->planned_bytes() << " bytes for "
+               << planner_->num_tensors() << " tensors, "
+               << "naive: " << planner_->naive_bytes() << " bytes, "
+               << "lower bound: " << planner_->lower_bytes() << " bytes.";
+
+    //  update the stored graph for querying
+    Tensor* string_tensor = ws()->GetTensor("GraphDef_" + name());
+    string* data = string_tensor->mutable_data<string, CPUContext>();
+    GraphDef graph_def;
+    graph_def.ParseFromString(data[0]);
+    planner_->Report(&graph_def);
+    data[0] = graph_def.SerializeAsString();
+}
+
+const Graph::ExecutionPlan& Graph::GetExecutionPlan(const string& include,
+                                                    const string& exclude) {
+    //  the same rules are usually given by the consecutive runnings
+    if (last_plan_ && last_plan_->include == include &&
+            last_plan_->exclude == exclude && last_plan_->phase == phase_)
+        return *last_plan_;
+    const string key = include + "\n" + exclude + "\n" + phase_;
+    if (!plans_.count(key)) {
+        ExecutionPlan& plan = plans_[key];
+        plan.include = include;
+        plan.exclude = exclude;
+        plan.phase = phase_;
+        plan.skipped.assign(ops_.size(), true);
+        for (int i = 0; i < ops_.size(); i++) {
+            auto* op = ops_[i];
+            if (!include.empty())
+                if (op->type().find(include) == string::npos) continue;
+            if (!exclude.empty())
+                if (op->type().find(exclude) != string::npos) continue;
+            op->SwitchToPhase(plan.phase);
+            plan.ops.push_back(op);
+            plan.op_indices.push_back(i);
+            plan.skipped[i] = false;
+        }
+        LOG(DEBUG) << "Graph(" << name() << ") compiles a plan of "
+                   << plan.ops.size() << " operators for the rules "
+                   << "(include: \"" << include << "\", exclude: \"" << exclude << "\")";
+    }
+    last_plan_ = &plans_[key];
+    return *last_plan_;
 }
 
 bool Graph::Run(const string& include, const string& exclude) {
+    //  the intermediates will be recomputed by a full running,
+    //  it is safe to move them into the arena here
+    bool full_run = include.empty() && exclude.empty();
+    if (full_run && plan_pending_) PlanMemory();
+    MergePendingUpdates();
+
     LOG(DEBUG) << "Run Graph: " << name();
-    for (auto op : ops_) {
-        if (!include.empty())
-            if (op->type().find(include) == string::npos) continue;
-        if (!exclude.empty())
-            if (op->type().find(exclude) != string::npos) continue;
-        op->SwitchToPhase(this->args_["phase"].s());
+    bool profiling = this->profiling();
+    if (bind_hooks_ && hook_version_ != ws()->hook_version()) BindHooks();
+    bool has_hooks = !write_hooks_.empty();
+    const ExecutionPlan& plan = GetExecutionPlan(include, exclude);
+    for (int k = 0; k < plan.ops.size(); k++) {
+        auto* op = plan.ops[k];
+        const int i = plan.op_indices[k];
+        if (has_hooks)
+            for (auto& name : write_hooks_[i]) ws()->RunTensorHook(name, false);
         LOG(DEBUG) << "$ Before Operator: " << op->name();
-        op->Run();
+        {
+            ProfileScope scope(op, profiling);
+            op->Run();
+        }
         LOG(DEBUG) << "$ After Operator: " << op->name();
+        if (has_hooks)
+            for (auto& name : ready_hooks_[i]) ws()->RunTensorHook(name, true);
+    }
+    if (planner_) {
+        if (full_run && !planner_->planned()) plan_pending_ = true;
+        if (bind_memory_ && planner_->Escaped()) plan_pending_ = true;
+    }
+    return true;
+}
+
+ParallelGraph::ParallelGraph(const GraphDef& meta_graph, Workspace* ws)
+    : Graph(meta_graph, ws), serial_mode_(false), warmed_up_(false) {
+    for (auto* op : ops_) {
+        //  cuda operators are serialized by the stream, and
+        //  the mirror stage shares the corrupted buffers among operators
+        if (op->op_def().device_option().device_type() != CPU ||
+                op->GetSingleArg<bool>("mirror_stage", false)) {
+            LOG(WARNING) << "Graph(" << name() << ") contains the operator("
+                         << op->name() << ") that can not run in parallel,"
+                         << "\nfallback to run serially.";
+            serial_mode_ = true;
+            break;
+        }
+    }
+    //  the arena assumes the serial order of operators
+    if (bind_memory_) {
+        LOG(WARNING) << "Graph(" << name() << ") runs in parallel, "
+                     << "the memory plan will not be applied.";
+        bind_memory_ = false;
+    }
+    BuildDependency();
+    int num_threads = std::thread::hardware_concurrency();
+    if (this->args_.count("num_threads"))
+        num_threads = this->args_["num_threads"].i();
+    if (!serial_mode_) pool_.reset(new ThreadPool(num_threads));
+}
+
+void ParallelGraph::BuildDependency() {
+    Map<string, int> last_writer;
+    Map<string, vector<int> > readers;
+    Set<string> written;
+    external_inputs_.clear();
+    successors_.assign(ops_.size(), vector<int>());
+    num_parents_.assign(ops_.size(), 0);
+    pinned_.assign(ops_.size(), false);
+    skipped_.assign(ops_.size(), false);
+    deps_left_.reset(new std::atomic<int>[ops_.size()]);
+
+    for (int i = 0; i < ops_.size(); i++) {
+        const OperatorDef& op_def = ops_[i]->op_def();
+        set<int> parents;
+        //  read after write
+        for (auto& input : op_def.input()) {
+            if (input == "ignore") continue;
+            string u = ws()->GetTensorName(input);
+            if (last_writer.count(u)) {
+                parents.insert(last_writer[u]);
+            } else if (!written.count(u)) {
+                //  fed from the outside, watch its shape
+                Tensor* tensor = ws()->GetTensor(u);
+                external_inputs_.push_back(std::make_pair(tensor, tensor->dims()));
+                written.insert(u);
+            }
+            readers[u].push_back(i);
+        }
+        //  write after write & write after read
+        for (auto& output : op_def.output()) {
+            if (output == "ignore") continue;
+            string v = ws()->GetTensorName(output);
+            if (last_writer.count(v)) parents.insert(last_writer[v]);
+            for (auto reader : readers[v]) parents.insert(reader);
+            last_writer[v] = i; readers[v].clear();
+            written.insert(v);
+        }
+        parents.erase(i);
+        for (auto parent : parents) successors_[parent].push_back(i);
+        num_parents_[i] = (int)parents.size();
+        //  python operators stay at the thread holding the interpreter
+        pinned_[i] = (op_def.type() == "Run" ||
+                      op_def.type() == "Template" ||
+                      op_def.type() == "TemplateGradient");
+    }
+}
+
+bool ParallelGraph::InputsReshaped() {
+    bool reshaped = false;
+    for (auto& input : external_inputs_) {
+        if (input.first->dims() == input.second) continue;
+        input.second = input.first->dims();
+        reshaped = true;
+    }
+    return reshaped;
+}
+
+void ParallelGraph::Dispatch(int op_idx) {
+    if (pinned_[op_idx]) {
+        std::unique_lock<std::mutex> lock(run_mutex_);
+        pinned_queue_.push(op_idx);
+        run_cond_.notify_all();
+    } else {
+        pool_->Schedule([this, op_idx]() {
+            LOG(DEBUG) << "$ Before Operator: " << ops_[op_idx]->name();
+            {
+                ProfileScope scope(ops_[op_idx], profiling());
+                ops_[op_idx]->Run();
+            }
+            LOG(DEBUG) << "$ After Operator: " << ops_[op_idx]->name();
+            Finish(op_idx);
+        });
+    }
+}
+
+void ParallelGraph::Finish(int op_idx) {
+    //  skipped operators are finished here without dispatching
+    vector<int> finished(1, op_idx);
+    int num_finished = 0;
+    while (!finished.empty()) {
+        int u = finished.back();
+        finished.pop_back();
+        num_finished++;
+        for (auto v : successors_[u]) {
+            if (--deps_left_[v] > 0) continue;
+            if (skipped_[v]) finished.push_back(v);
+            else Dispatch(v);
+        }
+    }
+    std::unique_lock<std::mutex> lock(run_mutex_);
+    num_unfinished_ -= num_finished;
+    if (num_unfinished_ == 0) run_cond_.notify_all();
+}
+
+bool ParallelGraph::Run(const string& include, const string& exclude) {
+    //  the lazy states (e.g. the fillers and buffers) are
+    //  materialized serially once the fed shapes change,
+    //  which is done only if all the operators are running,
+    //  the shared scratches are private for each worker
+    bool full_run = include.empty() && exclude.empty();
+    if (MergePendingUpdates()) {
+        BuildDependency();
+        warmed_up_ = false;
+    }
+    if (InputsReshaped()) warmed_up_ = false;
+    if (serial_mode_ || !warmed_up_) {
+        if (full_run) warmed_up_ = true;
+        return Graph::Run(include, exclude);
+    }
+
+    if (full_run && plan_pending_) PlanMemory();
+
+    LOG(DEBUG) << "Run Graph: " << name();
+    skipped_ = GetExecutionPlan(include, exclude).skipped;
+    num_unfinished_ = (int)ops_.size();
+    for (int i = 0; i < ops_.size(); i++) deps_left_[i] = num_parents_[i];
+    for (int i = 0; i < ops_.size(); i++) {
+        if (num_parents_[i] > 0) continue;
+        if (skipped_[i]) Finish(i);
+        else Dispatch(i);
+    }
+
+    //  serve the pinned operators until all operators finished
+    std::unique_lock<std::mutex> lock(run_mutex_);
+    while (true) {
+        run_cond_.wait(lock, [this]() {
+            return num_unfinished_ == 0 || !pinned_queue_.empty();
+        });
+        if (num_unfinished_ == 0) break;
+        int op_idx = pinned_queue_.front();
+        pinned_queue_.pop();
+        lock.unlock();
+        {
+            ProfileScope scope(ops_[op_idx], profiling());
+            ops_[op_idx]->Run();
+        }
+        Finish(op_idx);
+        lock.lock();
     }
     return true;
 }
 
 DEFINE_REGISTRY(GraphRegistry, GraphBase, const GraphDef&, Workspace*);
 
+REGISTER_GRAPH(Parallel, ParallelGraph);
+
 GraphBase* NewGraph(const GraphDef& meta_graph, Workspace* ws) {
     if (!meta_graph.has_graph_type()) return new Graph(meta_graph, ws);
     return GraphRegistry()->Create(meta_graph.graph_type(), meta_graph, ws);
@@ -0,0 +1,192 @@
+#include "core/memory_planner.h"
+#include "core/workspace.h"
+
+namespace dragon {
+
+static inline size_t AlignBytes(size_t nbytes) {
+    return (nbytes + CPU_ALLOCATOR_ALIGNMENT - 1)
+        / CPU_ALLOCATOR_ALIGNMENT * CPU_ALLOCATOR_ALIGNMENT;
+}
+
+MemoryPlanner::MemoryPlanner(const vector<OperatorBase*>& ops,
+                             const Set<string>& targets,
+                             Workspace* ws)
+    : planned_bytes_(0), naive_bytes_(0), lower_bytes_(0),
+      planned_(false), ws_(ws) {
+    Map<string, int> first, last;
+    Map<string, bool> first_write, last_write;
+    for (int i = 0; i < ops.size(); i++) {
+        const OperatorDef& op_def = ops[i]->op_def();
+        for (auto& input : op_def.input()) {
+            if (input == "ignore") continue;
+            string u = ws->GetTensorName(input);
+            if (!first.count(u)) { first[u] = i; first_write[u] = false; }
+            last[u] = i; last_write[u] = false;
+        }
+        for (auto& output : op_def.output()) {
+            if (output == "ignore") continue;
+            string v = ws->GetTensorName(output);
+            if (!first.count(v)) { first[v] = i; first_write[v] = true; }
+            last[v] = i; last_write[v] = true;
+        }
+    }
+    for (auto& it : first) {
+        const string& name = it.first;
+        //  fed from the outside, or fetched after the running
+        if (!first_write[name] || last_write[name]) continue;
+        if (targets.count(name) || last[name] <= it.second) continue;
+        ranges_[name] = std::make_pair(it.second, last[name]);
+    }
+}
+
+bool MemoryPlanner::Plan() {
+    blocks_.clear();
+    planned_bytes_ = naive_bytes_ = lower_bytes_ = 0;
+
+    //  count the references of each memory
+    Map<MixedMemory*, int> num_refs;
+    for (auto& name : ws_->GetTensors()) {
+        MixedMemory* mem = ws_->GetTensor(name)->memory();
+        if (mem) num_refs[mem]++;
+    }
+
+    //  group the tensors by memory
+    Map<MixedMemory*, int> block_idx;
+    Set<MixedMemory*> rejected;
+    for (auto& it : ranges_) {
+        Tensor* tensor = ws_->GetTensor(it.first);
+        MixedMemory* mem = tensor->memory();
+        if (!mem || rejected.count(mem)) continue;
+        if (!tensor->own_mem() || tensor->meta().ctor() ||
+                mem->state() != MixedMemory::STATE_AT_CPU) {
+            rejected.insert(mem);
+            continue;
+        }
+        if (!block_idx.count(mem)) {
+            block_idx[mem] = (int)blocks_.size();
+            Block block;
+            block.meta = tensor->meta();
+            block.start = it.second.first;
+            block.end = it.second.second;
+            block.nbytes = AlignBytes(mem->nbytes());
+            block.offset = 0;
+            blocks_.push_back(block);
+        }
+        Block& block = blocks_[block_idx[mem]];
+        block.tensors.push_back(tensor);
+        block.start = std::min(block.start, it.second.first);
+        block.end = std::max(block.end, it.second.second);
+    }
+
+    //  the memory aliased by the unplanned tensors can not be moved
+    vector<Block> blocks;
+    for (auto& it : block_idx) {
+        Block& block = blocks_[it.second];
+        if (rejected.count(it.first)) continue;
+        if (block.tensors.size() < num_refs[it.first]) continue;
+        blocks.push_back(block);
+    }
+    blocks_.swap(blocks);
+    planned_ = true;
+    if (blocks_.empty()) return false;
+
+    //  the lower bound is the peak of the living bytes
+    int num_steps = 0;
+    for (auto& block : blocks_) num_steps = std::max(num_steps, block.end + 1);
+    vector<int64_t> living(num_steps + 1, 0);
+    for (auto& block : blocks_) {
+        living[block.start] += block.nbytes;
+        living[block.end + 1] -= block.nbytes;
+        naive_bytes_ += block.nbytes;
+    }
+    int64_t cur_bytes = 0;
+    for (int i = 0; i < num_steps; i++) {
+        cur_bytes += living[i];
+        lower_bytes_ = std::max(lower_bytes_, (size_t)cur_bytes);
+    }
+
+    //  best-fit, place the larger blocks first
+    vector<int> order(blocks_.size());
+    for (int i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        if (blocks_[a].nbytes != blocks_[b].nbytes)
+            return blocks_[a].nbytes > blocks_[b].nbytes;
+        return blocks_[a].start < blocks_[b].start;
+    });
+    vector<int> placed;
+    for (auto i : order) {
+        Block& block = blocks_[i];
+        vector<pair<size_t, size_t> > used;
+        for (auto j : placed) {
+            const Block& other = blocks_[j];
+            if (other.start > block.end || block.start > other.end) continue;
+            used.push_back(std::make_pair(other.offset, other.offset + other.nbytes));
+        }
+        std::sort(used.begin(), used.end());
+        size_t cursor = 0, best_gap = SIZE_MAX;
+        block.offset = SIZE_MAX;
+        for (auto& interval : used) {
+            if (interval.first > cursor) {
+                size_t gap = interval.first - cursor;
+                if (gap >= block.nbytes && gap < best_gap) {
+                    block.offset = cursor;
+                    best_gap = gap;
+                }
+            }
+            cursor = std::max(cursor, interval.second);
+        }
+        if (block.offset == SIZE_MAX) block.offset = cursor;
+        planned_bytes_ = std::max(planned_bytes_, block.offset + block.nbytes);
+        placed.push_back(i);
+    }
+    return true;
+}
+
+void MemoryPlanner::Bind() {
+    if (planned_bytes_ == 0) return;
+    arena_.reset(CPUContext::New(planned_bytes_), CPUContext::Delete);
+    char* base = (char*)arena_.get();
+    for (auto& block : blocks_) {
+        block.memory.reset(new MixedMemory(block.meta, block.nbytes));
+        block.memory->set_cpu_data(base + block.offset, block.nbytes, arena_);
+        for (auto* tensor : block.tensors) tensor->SetMemory(block.memory);
+    }
+}
+
+bool MemoryPlanner::Escaped() {
+    bool escaped = false;
+    for (auto& block : blocks_) {
+        if (!block.memory) continue;
+        for (auto* tensor : block.tensors) {
+            if (tensor->memory() == block.memory.get()) continue;
+            //  the type changes, it can not stay in the arena
+            if (tensor->meta() != block.meta) ranges_.erase(tensor->name());
+            escaped = true;
+        }
+    }
+    return escaped;
+}
+
+void MemoryPlanner::Report(GraphDef* graph_def) const {
+    const vector<pair<string, size_t> > reports = {
+        { "memory_planned_bytes", planned_bytes_ },
+        { "memory_naive_bytes", naive_bytes_ },
+        { "memory_lower_bytes", lower_bytes_ },
+    };
+    GraphDef reported;
+    reported.CopyFrom(*graph_def);
+    reported.clear_arg();
+    for (auto& arg : graph_def->arg()) {
+        if (arg.name().find("memory_") == 0 &&
+            arg.name().find("_bytes") != string::npos) continue;
+        reported.add_arg()->CopyFrom(arg);
+    }
+    for (auto& report : reports) {
+        Argument* arg = reported.add_arg();
+        arg->set_name(report.first);
+        arg->set_i64((int64_t)report.second);
+    }
+    graph_def->Swap(&reported);
+}
+
+}    // namespace dragon
@@ -91,17 +91,30 @@ MixedMemory::~MixedMemory() {
 #ifdef WITH_CUDA_HOST_MEM
     use_cudahost_mem = true;
 #endif
-    if (cpu_ptr_ && !use_cudahost_mem) {
+    if (cpu_ptr_ && !own_cpu_ptr_) {
+        //  borrowed memory, leave it to the owner
+    } else if (cpu_ptr_ && !use_cudahost_mem) {
         if (meta_.dtor())
             meta_.dtor()(cpu_ptr_, nbytes_ / meta_.itemsize());
         CPUContext::Delete(cpu_ptr_);
     }
 #ifdef WITH_CUDA
-    if (cpu_ptr_ && use_cudahost_mem) cudaFreeHost(cpu_ptr_);
+    if (cpu_ptr_ && own_cpu_ptr_ && use_cudahost_mem) cudaFreeHost(cpu_ptr_);
     if (cuda_ptr_) CUDAContext::Delete(cuda_ptr_);
 #endif
 }
 
+void MixedMemory::set_cpu_data(void* cpu_ptr, size_t nbytes,
+                               shared_ptr<void> owner) {
+    CHECK(state_ == UNINITIALIZED)
+        << "\nCan not borrow the memory for an initialized MixedMemory.";
+    cpu_ptr_ = cpu_ptr;
+    nbytes_ = nbytes;
+    own_cpu_ptr_ = false;
+    cpu_owner_ = owner;
+    state_ = STATE_AT_CPU;
+}
+
 void MixedMemory::SwitchToDevice() {
     if (cuda_ptr_) {
 #ifdef WITH_CUDA
@@ -1,7 +1,12 @@
+#include <sstream>
+
 #include "core/operator_schema.h"
 
 namespace dragon {
 
+//  the rejection of the running shape function
+static thread_local string shape_error;
+
 bool OpSchema::Verify(const OperatorDef& def) const {
     if (ignore_verify_) return true;
     if (def.input_size() < min_input_ || def.input_size() > max_input_) {
@@ -49,6 +54,70 @@ OpSchema& OpSchema::NumOutputs(int n) {
     return NumOutputs(n, n);
 }
 
+static string ShapeString(const TensorProto& shape) {
+    std::stringstream ss;
+    ss << "(";
+    for (int i = 0; i < shape.dims_size(); i++)
+        ss << shape.dims(i) << (i < shape.dims_size() - 1 ? "," : "");
+    ss << ")";
+    return ss.str();
+}
+
+OpSchema& OpSchema::ShapeInference(ShapeInferenceFunction function,
+                                   int num_required) {
+    shape_inference_ = function;
+    num_required_ = num_required;
+    return *this;
+}
+
+OpSchema& OpSchema::IdenticalShape(int idx) {
+    return ShapeInference([idx](const OperatorDef& def,
+                                const vector<TensorProto>& inputs) {
+        CHECK_LT(idx, (int)inputs.size());
+        return vector<TensorProto>(def.output_size(), inputs[idx]);
+    }, idx + 1);
+}
+
+OpSchema& OpSchema::BroadcastShape(int idx) {
+    return ShapeInference([idx](const OperatorDef& def,
+                                const vector<TensorProto>& inputs) {
+        const vector<TIndex> x1 = TensorDims(inputs[idx]);
+        const vector<TIndex> x2 = TensorDims(inputs[1 - idx]);
+        bool valid = x1 == x2;
+        if (!valid && x1.size() > 0 && x2.size() > 0) {
+            const TensorProto& y = inputs[1 - idx];
+            valid |= x1[0] == x2[0] && TensorCount(y, 1) == 1;
+            valid |= x1.back() == x2.back() && TensorCount(y, 0, -1) == 1;
+            valid |= x2.size() == 1 && x2[0] == 1;
+        }
+        if (!valid) return InvalidShape(def, "Could not be broadcast together "
+            "with shapes " + ShapeString(inputs[0]) + "  " + ShapeString(inputs[1]));
+        return vector<TensorProto>(1, inputs[idx]);
+    }, 2);
+}
+
+vector<TensorProto> OpSchema::InferShape(const OperatorDef& def,
+                                         const vector<TensorProto>& inputs,
+                                         string* error) const {
+    if (!shape_inference_ || HasDescArgument(def)) return vector<TensorProto>();
+    CHECK_EQ((int)inputs.size(), def.input_size());
+    for (int i = 0; i < std::min(num_required_, def.input_size()); i++)
+        if (!inputs[i].has_data_type()) return vector<TensorProto>();
+    shape_error.clear();
+    vector<TensorProto> outputs = shape_inference_(def, inputs);
+    if (!shape_error.empty()) {
+        if (error == nullptr) LOG(FATAL) << shape_error;
+        *error = shape_error;
+        return vector<TensorProto>();
+    }
+    if (outputs.size() > 0) {
+        CHECK_EQ((int)outputs.size(), def.output_size())
+            << "\nOpSchema(" << op_type_ << ") infers "
+            << outputs.size() << " outputs, excepted " << def.output_size() << ".";
+    }
+    return outputs;
+}
+
 OpSchema& OpSchema::Inplace(set< pair<int, int> > inplace) {
     CheckInplace = [inplace](int in, int out)->bool {
         return (inplace.count(std::make_pair(in, out)) > 0);
@@ -57,4 +126,81 @@ OpSchema& OpSchema::Inplace(set< pair<int, int> > inplace) {
     return *this;
 }
 
+TensorProto TensorShape(const vector<TIndex>& dims,
+                        TensorProto::DataType data_type) {
+    TensorProto shape;
+    for (auto dim : dims) shape.add_dims((int)dim);
+    shape.set_data_type(data_type);
+    return shape;
+}
+
+vector<TIndex> TensorDims(const TensorProto& shape) {
+    return vector<TIndex>(shape.dims().begin(), shape.dims().end());
+}
+
+TIndex TensorCount(const TensorProto& shape, int start, int end) {
+    if (end == INT_MAX) end = shape.dims_size();
+    start = TensorAxis(shape, start), end = TensorAxis(shape, end);
+    TIndex count = 1;
+    for (int i = start; i < end; i++) count *= shape.dims(i);
+    return count;
+}
+
+int TensorAxis(const TensorProto& shape, int axis) {
+    CHECK(axis >= -shape.dims_size() && axis <= shape.dims_size())
+        << "\nThe axis " << axis << " is out of the range of "
+        << shape.dims_size() << " dimensions.";
+    return axis < 0 ? axis + shape.dims_size() : axis;
+}
+
+#define INSTANTIATE_GET_ARGUMENT(T, fieldname) \
+template <> T GetArgument(const OperatorDef& def, \
+                          const string& name, \
+                          const T& default_value) { \
+    T value = default_value; \
+    for (auto& arg : def.arg()) { \
+        if (arg.name() != name) continue; \
+        CHECK(arg.has_##fieldname()); \
+        value = arg.fieldname(); \
+    } \
+    return value; \
+}
+
+INSTANTIATE_GET_ARGUMENT(float, f)
+INSTANTIATE_GET_ARGUMENT(int, i)
+INSTANTIATE_GET_ARGUMENT(string, s)
+INSTANTIATE_GET_ARGUMENT(bool, b)
+INSTANTIATE_GET_ARGUMENT(int64_t, i64)
+#undef INSTANTIATE_GET_ARGUMENT
+
+#define INSTANTIATE_GET_ARGUMENTS(T, fieldname) \
+template <> vector<T> GetArguments(const OperatorDef& def, const string& name) { \
+    vector<T> values; \
+    for (auto& arg : def.arg()) { \
+        if (arg.name() != name) continue; \
+        values.assign(arg.fieldname().begin(), arg.fieldname().end()); \
+    } \
+    return values; \
+}
+
+INSTANTIATE_GET_ARGUMENTS(float, floats)
+INSTANTIATE_GET_ARGUMENTS(int, ints)
+INSTANTIATE_GET_ARGUMENTS(string, strings)
+#undef INSTANTIATE_GET_ARGUMENTS
+
+bool HasDescArgument(const OperatorDef& def) {
+    for (auto& arg : def.arg()) {
+        const string& name = arg.name();
+        bool desc = name == "shape_like" || (name.size() > 5 &&
+            name.compare(name.size() - 5, 5, "_desc") == 0);
+        if (desc && (!arg.s().empty() || arg.strings_size() > 0)) return true;
+    }
+    return false;
+}
+
+vector<TensorProto> InvalidShape(const OperatorDef& def, const string& message) {
+    shape_error = "[" + def.name() + "] " + message;
+    return vector<TensorProto>();
+}
+
 }    // namespace dragon
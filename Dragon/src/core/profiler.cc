@@ -0,0 +1,150 @@
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+#include "core/profiler.h"
+#include "core/allocator.h"
+
+namespace dragon {
+
+Profiler* Profiler::Get() {
+    static Profiler profiler;
+    return &profiler;
+}
+
+int64_t Profiler::NowUs() {
+    static auto origin = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - origin).count();
+}
+
+int Profiler::ThreadId() {
+    static std::atomic<int> num_threads(0);
+    static thread_local int tid = num_threads++;
+    return tid;
+}
+
+void Profiler::Record(Event& event) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    events_.push_back(std::move(event));
+}
+
+void Profiler::Reset() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    events_.clear();
+}
+
+vector<Profiler::Stats> Profiler::Aggregate() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    Map<string, Stats> type_stats;
+    for (auto& event : events_) {
+        Stats& stats = type_stats[event.type];
+        if (stats.calls == 0) {
+            stats.type = event.type;
+            stats.min_us = event.dur_us;
+        }
+        stats.calls++;
+        stats.total_us += event.dur_us;
+        stats.min_us = std::min(stats.min_us, event.dur_us);
+        stats.max_us = std::max(stats.max_us, event.dur_us);
+        stats.bytes += event.bytes;
+    }
+    vector<Stats> sorted_stats;
+    for (auto& it : type_stats) sorted_stats.push_back(it.second);
+    std::sort(sorted_stats.begin(), sorted_stats.end(),
+        [](const Stats& a, const Stats& b) { return a.total_us > b.total_us; });
+    return sorted_stats;
+}
+
+string Profiler::Summary() {
+    vector<Stats> sorted_stats = Aggregate();
+    int64_t total_us = 0;
+    for (auto& stats : sorted_stats) total_us += stats.total_us;
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << std::left << std::setw(32) << "Type"
+       << std::right << std::setw(10) << "Calls"
+       << std::setw(14) << "Total(ms)"
+       << std::setw(12) << "Avg(ms)"
+       << std::setw(12) << "Min(ms)"
+       << std::setw(12) << "Max(ms)"
+       << std::setw(10) << "Percent"
+       << std::setw(14) << "Alloc(MB)" << "\n";
+    for (auto& stats : sorted_stats) {
+        ss << std::left << std::setw(32) << stats.type
+           << std::right << std::setw(10) << stats.calls
+           << std::setw(14) << stats.total_us / 1e3
+           << std::setw(12) << stats.total_us / 1e3 / stats.calls
+           << std::setw(12) << stats.min_us / 1e3
+           << std::setw(12) << stats.max_us / 1e3
+           << std::setw(9) << (total_us > 0 ? 100.0 * stats.total_us / total_us : 0.0) << "%"
+           << std::setw(14) << stats.bytes / 1048576.0 << "\n";
+    }
+    ss << "Total: " << total_us / 1e3 << " ms";
+    return ss.str();
+}
+
+static string JSONEscape(const string& str) {
+    string escaped;
+    for (auto c : str) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        if ((unsigned char)c < 0x20) continue;
+        escaped += c;
+    }
+    return escaped;
+}
+
+bool Profiler::ExportChromeTrace(const string& filename) {
+    std::ofstream f(filename);
+    if (!f.is_open()) {
+        LOG(ERROR) << "Failed to open the file: " << filename;
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    f << "{\"traceEvents\":[";
+    for (int i = 0; i < events_.size(); i++) {
+        const Event& event = events_[i];
+        f << (i > 0 ? ",\n" : "\n")
+          << "{\"name\":\"" << JSONEscape(event.name) << "\","
+          << "\"cat\":\"" << JSONEscape(event.type) << "\","
+          << "\"ph\":\"X\",\"pid\":0,"
+          << "\"tid\":" << event.tid << ","
+          << "\"ts\":" << event.start_us << ","
+          << "\"dur\":" << event.dur_us << ","
+          << "\"args\":{"
+          << "\"inputs\":\"" << JSONEscape(event.inputs) << "\","
+          << "\"outputs\":\"" << JSONEscape(event.outputs) << "\","
+          << "\"bytes\":" << event.bytes << "}}";
+    }
+    f << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return true;
+}
+
+static string ShapeString(Tensor* tensor) {
+    if (tensor->name() == "ignore") return "ignore";
+    if (tensor->ndim() == 0) return "()";
+    return tensor->dim_string();
+}
+
+ProfileScope::ProfileScope(OperatorBase* op, bool enabled)
+    : op_(enabled ? op : nullptr) {
+    if (!op_) return;
+    for (int i = 0; i < op_->InputSize(); i++)
+        event_.inputs += (i > 0 ? ", " : "") + ShapeString(&op_->Input(i));
+    event_.bytes = CPUAllocator::ThreadAllocatedBytes();
+    event_.start_us = Profiler::NowUs();
+}
+
+ProfileScope::~ProfileScope() {
+    if (!op_) return;
+    event_.dur_us = Profiler::NowUs() - event_.start_us;
+    event_.bytes = CPUAllocator::ThreadAllocatedBytes() - event_.bytes;
+    event_.name = op_->name();
+    event_.type = op_->type();
+    event_.tid = Profiler::ThreadId();
+    for (int i = 0; i < op_->OutputSize(); i++)
+        event_.outputs += (i > 0 ? ", " : "") + ShapeString(op_->Output(i));
+    Profiler::Get()->Record(event_);
+}
+
+}    // namespace dragon
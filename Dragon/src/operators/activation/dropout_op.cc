@@ -38,7 +38,7 @@ DEPLOY_CPU(Dropout);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Dropout);
 #endif
-OPERATOR_SCHEMA(Dropout).NumInputs(1).NumOutputs(1).Inplace({ { 0, 0 } });
+OPERATOR_SCHEMA(Dropout).NumInputs(1).NumOutputs(1).Inplace({ { 0, 0 } }).IdenticalShape();
 
 template <class Context> template <typename T>
 void DropoutGradientOp<Context>::RunWithType() {
@@ -23,7 +23,7 @@ DEPLOY_CPU(Elu);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Elu);
 #endif
-OPERATOR_SCHEMA(Elu).NumInputs(1).NumOutputs(1).Inplace({ { 0, 0 } });
+OPERATOR_SCHEMA(Elu).NumInputs(1).NumOutputs(1).Inplace({ { 0, 0 } }).IdenticalShape();
 
 template <class Context> template <typename T>
 void EluGradientOp<Context>::RunWithType() {
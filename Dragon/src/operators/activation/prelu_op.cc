@@ -46,7 +46,7 @@ DEPLOY_CPU(PRelu);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(PRelu);
 #endif
-OPERATOR_SCHEMA(PRelu).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(PRelu).NumInputs(2).NumOutputs(1).IdenticalShape();
 
 template <class Context> template <typename T>
 void PReluGradientOp<Context>::RunWithType() {
@@ -23,7 +23,7 @@ DEPLOY_CPU(Relu);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Relu);
 #endif
-OPERATOR_SCHEMA(Relu).NumInputs(1).NumOutputs(1).Inplace({ { 0, 0 } });
+OPERATOR_SCHEMA(Relu).NumInputs(1).NumOutputs(1).Inplace({ { 0, 0 } }).IdenticalShape();
 
 template <class Context> template <typename T>
 void ReluGradientOp<Context>::RunWithType() {
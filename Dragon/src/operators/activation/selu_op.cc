@@ -23,7 +23,7 @@ DEPLOY_CPU(SElu);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(SElu);
 #endif
-OPERATOR_SCHEMA(SElu).NumInputs(1).NumOutputs(1).Inplace({ { 0, 0 } });
+OPERATOR_SCHEMA(SElu).NumInputs(1).NumOutputs(1).Inplace({ { 0, 0 } }).IdenticalShape();
 
 template <class Context> template <typename T>
 void SEluGradientOp<Context>::RunWithType() {
@@ -23,7 +23,7 @@ DEPLOY_CPU(Sigmoid);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Sigmoid);
 #endif
-OPERATOR_SCHEMA(Sigmoid).NumInputs(1).NumOutputs(1).Inplace({ { 0, 0 } });
+OPERATOR_SCHEMA(Sigmoid).NumInputs(1).NumOutputs(1).Inplace({ { 0, 0 } }).IdenticalShape();
 
 template <class Context> template <typename T>
 void SigmoidGradientOp<Context>::RunWithType() {
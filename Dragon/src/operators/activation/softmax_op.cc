@@ -26,7 +26,7 @@ void SoftmaxOp<Context>::RunWithType() {
 template <class Context>
 void SoftmaxOp<Context>::RunOnDevice() {
     if (axis == -1) axis = (int)Input(0).ndim() - 1;
-    scale = ws()->CreateTensor("/share/softmax_scale");
+    scale = ws()->CreateTensor(ScratchName("/share/softmax_scale"));
     scale->ReshapeLike(Input(0));
     outer_dim = Input(0).count(0, axis);
     inner_dim = Input(0).count(axis + 1);
@@ -40,7 +40,7 @@ DEPLOY_CPU(Softmax);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Softmax);
 #endif
-OPERATOR_SCHEMA(Softmax).NumInputs(1).NumOutputs(1).Inplace({ { 0, 0 } });
+OPERATOR_SCHEMA(Softmax).NumInputs(1).NumOutputs(1).Inplace({ { 0, 0 } }).IdenticalShape();
 
 template <class Context> template <typename T>
 void SoftmaxGradientOp<Context>::RunWithType() {
@@ -64,7 +64,7 @@ void SoftmaxGradientOp<Context>::RunWithType() {
 template <class Context>
 void SoftmaxGradientOp<Context>::RunOnDevice() {
     if (axis == -1) axis = (int)Input(0).ndim() - 1;
-    scale = ws()->CreateTensor("/share/softmax_scale");
+    scale = ws()->CreateTensor(ScratchName("/share/softmax_scale"));
     scale->ReshapeLike(Input(0));
     outer_dim = Input(0).count(0, axis);
     inner_dim = Input(0).count(axis + 1);
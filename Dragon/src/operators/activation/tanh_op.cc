@@ -23,7 +23,7 @@ DEPLOY_CPU(Tanh);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Tanh);
 #endif
-OPERATOR_SCHEMA(Tanh).NumInputs(1).NumOutputs(1).Inplace({ { 0, 0 } });
+OPERATOR_SCHEMA(Tanh).NumInputs(1).NumOutputs(1).Inplace({ { 0, 0 } }).IdenticalShape();
 
 template <class Context> template <typename T>
 void TanhGradientOp<Context>::RunWithType() {
@@ -83,7 +83,8 @@ DEPLOY_CPU(Add);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Add);
 #endif
-OPERATOR_SCHEMA(Add).NumInputs(2).NumOutputs(1).Inplace({ { 0, 0 }, { 1, 0 } });
+OPERATOR_SCHEMA(Add).NumInputs(2).NumOutputs(1).Inplace({ { 0, 0 }, { 1, 0 } })
+    .BroadcastShape(0);
 
 template <class Context> template <typename T>
 void AddGradientOp<Context>::EltwiseRunWithType() {
@@ -40,7 +40,7 @@ DEPLOY_CPU(BiasAdd);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(BiasAdd);
 #endif
-OPERATOR_SCHEMA(BiasAdd).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(BiasAdd).NumInputs(2).NumOutputs(1).IdenticalShape();
 
 template <class Context> template <typename T>
 void BiasAddGradientOp<Context>::RunWithType() {
@@ -84,7 +84,7 @@ DEPLOY_CPU(Div);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Div);
 #endif
-OPERATOR_SCHEMA(Div).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(Div).NumInputs(2).NumOutputs(1).BroadcastShape(0);
 
 template <class Context> template <typename T>
 void DivGradientOp<Context>::EltwiseRunWithType() {
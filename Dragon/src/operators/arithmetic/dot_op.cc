@@ -88,7 +88,30 @@ DEPLOY_CPU(Dot);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Dot);
 #endif
-OPERATOR_SCHEMA(Dot).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(Dot).NumInputs(2).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const bool transA = GetArgument<bool>(def, "TransA", false);
+        const bool transB = GetArgument<bool>(def, "TransB", false);
+        vector<TIndex> x1 = TensorDims(inputs[0]), x2 = TensorDims(inputs[1]);
+        vector<TIndex> dims;
+        if (x1.size() == 1 && x2.size() == 1) {
+            CHECK_EQ(x1[0], x2[0]) << "\n[" << def.name() << "] can not Dot.";
+            dims.push_back(1);
+        } else if (x1.size() >= 2 && x2.size() == 2) {
+            TIndex m = TensorCount(inputs[0], 0, -1), k = x1.back();
+            CHECK_EQ((transA ? m : k), (transB ? x2[1] : x2[0]))
+                << "\n[" << def.name() << "] can not Dot.";
+            dims = x1;
+            dims.back() = transB ? x2[0] : x2[1];
+        } else if (x1.size() >= 2 && x2.size() == 1) {
+            TIndex m = TensorCount(inputs[0], 0, -1), k = x1.back();
+            CHECK_EQ((transA ? m : k), x2[0]) << "\n[" << def.name() << "] can not Dot.";
+            dims.assign(x1.begin(), x1.end() - 1);
+        } else {
+            LOG(FATAL) << "\n[" << def.name() << "] can not Dot.";
+        }
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void DotGradientOp<Context>::DotRunWithType() {
@@ -62,7 +62,12 @@ DEPLOY_CPU(Eltwise);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Eltwise);
 #endif
-OPERATOR_SCHEMA(Eltwise).NumInputs(2, INT_MAX).NumOutputs(1);
+OPERATOR_SCHEMA(Eltwise).NumInputs(2, INT_MAX).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        for (int i = 1; i < (int)inputs.size(); i++)
+            CHECK(TensorDims(inputs[i]) == TensorDims(inputs[0]));
+        return vector<TensorProto>(1, inputs[0]);
+    });
 
 template <class Context> template <typename T>
 void EltwiseGradientOp<Context>::SumRunWithType() {
@@ -23,7 +23,7 @@ DEPLOY_CPU(Exp);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Exp);
 #endif
-OPERATOR_SCHEMA(Exp).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Exp).NumInputs(1).NumOutputs(1).IdenticalShape();
 
 template <class Context> template <typename T>
 void ExpGradientOp<Context>::RunWithType() {
@@ -0,0 +1,250 @@
+#include "operators/arithmetic/fused_elementwise_op.h"
+#include "core/workspace.h"
+#include "utils/math_functions.h"
+
+namespace dragon {
+
+static TIndex DimsCount(const vector<TIndex>& dims, int start, int end) {
+    TIndex count = 1;
+    for (int i = start; i < end; i++) count *= dims[i];
+    return count;
+}
+
+static string DimsString(const vector<TIndex>& dims) {
+    std::stringstream ss;
+    ss << "(";
+    for (int i = 0; i < (int)dims.size() - 1; i++) ss << dims[i] << ",";
+    if (dims.size() > 0) ss << dims.back();
+    ss << ")";
+    return ss.str();
+}
+
+//  the broadcasting of Add, Sub, Mul and Div:
+//  -1 for the same shapes, 2 for the columns, 1 for the rows, 0 for a scalar
+static int BroadcastType(const vector<TIndex>& x1, const vector<TIndex>& x2) {
+    if (x1 == x2) return -1;
+    if (x1.size() > 0 && x2.size() > 0) {
+        if (x1[0] == x2[0] && DimsCount(x2, 1, (int)x2.size()) == 1) return 2;
+        if (x1.back() == x2.back() && DimsCount(x2, 0, (int)x2.size() - 1) == 1) return 1;
+        if (x2.size() == 1 && x2[0] == 1) return 0;
+    }
+    LOG(FATAL) << "Could not be broadcast together with shapes "
+               << DimsString(x1) << "  " << DimsString(x2);
+    return -1;
+}
+
+template <class Context>
+void FusedElementwiseOpBase<Context>::Compile(const int num_inputs) {
+    static const Map<string, int> opcodes {
+        { "Add", kernel::FUSED_ADD }, { "Sub", kernel::FUSED_SUB },
+        { "Mul", kernel::FUSED_MUL }, { "Div", kernel::FUSED_DIV },
+        { "Relu", kernel::FUSED_RELU }, { "Elu", kernel::FUSED_ELU },
+        { "Sigmoid", kernel::FUSED_SIGMOID }, { "Tanh", kernel::FUSED_TANH },
+        { "Exp", kernel::FUSED_EXP }, { "Log", kernel::FUSED_LOG },
+        { "Square", kernel::FUSED_SQUARE }, { "Pow", kernel::FUSED_POW },
+        { "Clip", kernel::FUSED_CLIP }};
+    const int num_insts = (int)ops.size();
+    const int num_values = num_inputs + num_insts;
+    CHECK_GT(num_insts, 0);
+    CHECK_LE(num_values, FUSED_MAX_VALUES)
+        << "\nExcepted at most " << FUSED_MAX_VALUES << " values, got " << num_values;
+    CHECK_EQ((int)operands.size(), 2 * num_insts);
+    CHECK_EQ((int)params.size(), 3 * num_insts);
+    program.num_inputs = num_inputs;
+    program.num_insts = num_insts;
+
+    //  the shape of each result is given by its first operand
+    vector<vector<TIndex> > dims(num_values);
+    vector<int> bcast(num_insts, -1);
+    for (int i = 0; i < num_inputs; i++) dims[i] = Input(i).dims();
+    for (int k = 0; k < num_insts; k++) {
+        CHECK(opcodes.count(ops[k])) << "\nUnsupported operator to fuse: " << ops[k];
+        const int a = operands[2 * k], b = operands[2 * k + 1];
+        const int opcode = opcodes.at(ops[k]);
+        const bool binary = opcode <= kernel::FUSED_DIV;
+        CHECK(a >= 0 && a < num_inputs + k && b < num_inputs + k && (b >= 0) == binary)
+            << "\nThe operands of " << ops[k] << " are invalid.";
+        program.opcode[k] = opcode;
+        program.a[k] = a; program.b[k] = b;
+        for (int j = 0; j < 3; j++) program.params[k][j] = params[3 * k + j];
+        dims[num_inputs + k] = dims[a];
+        if (binary) bcast[k] = BroadcastType(dims[a], dims[b]);
+    }
+    output_dims = dims.back();
+
+    //  assign the reading of values from the output to the inputs
+    const int count = (int)DimsCount(output_dims, 0, (int)output_dims.size());
+    vector<bool> assigned(num_values, false);
+    auto assign = [&](int v, int div, int mod) {
+        if (!assigned[v]) {
+            program.div[v] = div; program.mod[v] = mod;
+            assigned[v] = true;
+        } else {
+            CHECK(program.div[v] == div && program.mod[v] == mod)
+                << "\n" << (v < num_inputs ? "Tensor(" + Input(v).name() + ")" :
+                    "The result of " + ops[v - num_inputs])
+                << " is broadcast in different ways, can not fuse it.";
+        }
+    };
+    assign(num_values - 1, 1, count);
+    for (int k = num_insts - 1; k >= 0; k--) {
+        const int r = num_inputs + k, a = program.a[k], b = program.b[k];
+        CHECK(assigned[r]) << "\nThe result of " << ops[k] << " is not used.";
+        const int div = program.div[r], mod = program.mod[r];
+        const vector<TIndex>& rdims = dims[r];
+        assign(a, div, mod);
+        if (b < 0) continue;
+        switch (bcast[k]) {
+            case -1: assign(b, div, mod); break;
+            case 2: assign(b, div * (int)DimsCount(rdims, 1, (int)rdims.size()),
+                        (int)rdims[0]); break;
+            case 1: assign(b, div, (int)rdims.back()); break;
+            default: assign(b, 1, 1);
+        }
+    }
+    for (int i = 0; i < num_inputs; i++)
+        CHECK(assigned[i]) << "\nTensor(" << Input(i).name() << ") is not used.";
+}
+
+template <class Context> template <typename T>
+void FusedElementwiseOp<Context>::RunWithType() {
+    kernel::FusedData<T> data;
+    for (int i = 0; i < InputSize(); i++)
+        data.x[i] = Input(i).template data<T, Context>();
+    auto* Ydata = Output(0)->template mutable_data<T, Context>();
+    kernel::FusedElementwise<T, Context>(Output(0)->count(),
+                                               this->program,
+                                                        data,
+                                                       Ydata);
+}
+
+template <class Context>
+void FusedElementwiseOp<Context>::RunOnDevice() {
+    this->Compile(InputSize());
+    Output(0)->Reshape(this->output_dims);
+    if (Output(0)->count() == 0) return;
+
+    bool all_float = true;
+    for (int i = 0; i < InputSize(); i++)
+        all_float &= Input(i).template IsType<float>();
+    if (all_float) RunWithType<float>();
+    else LOG(FATAL) << "Unsupported input types.";
+}
+
+DEPLOY_CPU(FusedElementwise);
+#ifdef WITH_CUDA
+DEPLOY_CUDA(FusedElementwise);
+#endif
+OPERATOR_SCHEMA(FusedElementwise).NumInputs(1, FUSED_MAX_VALUES).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        //  the shape of each result is given by its first operand
+        vector<int> operands = GetArguments<int>(def, "operands");
+        CHECK_GE((int)operands.size(), 2);
+        int value = operands[operands.size() - 2];
+        while (value >= (int)inputs.size())
+            value = operands[2 * (value - (int)inputs.size())];
+        return vector<TensorProto>(1, inputs[value]);
+    });
+
+template <class Context> template <typename T>
+void FusedElementwiseGradientOp<Context>::RunWithType() {
+    const kernel::FusedProgram& program = this->program;
+    const int count = Input(-1).count();
+    kernel::FusedData<T> data;
+    vector<Tensor*> buffers(OutputSize(), nullptr);
+    for (int i = 0; i < OutputSize(); i++) {
+        data.x[i] = Input(i).template data<T, Context>();
+        data.dx[i] = nullptr;
+        if (Output(i)->name() == "ignore") continue;
+        Output(i)->ReshapeLike(Input(i));
+        if (program.div[i] == 1 && program.mod[i] == count) {
+            data.dx[i] = Output(i)->template mutable_data<T, Context>();
+        } else {
+            //  collect the gradients of each output element first
+            buffers[i] = ws()->GetBuffer();
+            buffers[i]->Reshape(vector<TIndex>(1, count));
+            data.dx[i] = buffers[i]->template mutable_data<T, Context>();
+        }
+    }
+    auto* dYdata = Input(-1).template data<T, Context>();
+    kernel::FusedElementwiseGrad<T, Context>(count, program, data, dYdata);
+
+    //  reduce the broadcast ones, viewed as (outer_dim, mod, div)
+    for (int i = 0; i < OutputSize(); i++) {
+        if (buffers[i] == nullptr) continue;
+        const int div = program.div[i], mod = program.mod[i];
+        const int outer_dim = count / (div * mod);
+        auto* Bdata = buffers[i]->template data<T, Context>();
+        auto* dXdata = Output(i)->template mutable_data<T, Context>();
+        INIT_MULTIPLIER(bcast_multiplier, std::max(div, outer_dim));
+        auto* BMul_data = bcast_multiplier->template data<T, Context>();
+        if (div == 1) {
+            math::Gemv<T, Context>(CblasTrans, outer_dim, mod,
+                                   1.0, Bdata, BMul_data, 0.0, dXdata);
+        } else if (outer_dim == 1) {
+            math::Gemv<T, Context>(CblasNoTrans, mod, div,
+                                   1.0, Bdata, BMul_data, 0.0, dXdata);
+        } else {
+            Tensor* inner = ws()->GetBuffer();
+            inner->Reshape(vector<TIndex>(1, outer_dim * mod));
+            auto* Idata = inner->template mutable_data<T, Context>();
+            math::Gemv<T, Context>(CblasNoTrans, outer_dim * mod, div,
+                                   1.0, Bdata, BMul_data, 0.0, Idata);
+            math::Gemv<T, Context>(CblasTrans, outer_dim, mod,
+                                   1.0, Idata, BMul_data, 0.0, dXdata);
+            ws()->ReleaseBuffer(inner);
+        }
+        ws()->ReleaseBuffer(buffers[i]);
+    }
+}
+
+template <class Context>
+void FusedElementwiseGradientOp<Context>::RunOnDevice() {
+    CHECK_EQ(InputSize(), OutputSize() + 1)
+        << "\nExcepted the inputs and the gradient of output.";
+    this->Compile(OutputSize());
+    CHECK(this->output_dims == Input(-1).dims())
+        << "\nThe gradient of output should be " << DimsString(this->output_dims)
+        << ", got " << Input(-1).dim_string();
+    if (Input(-1).count() == 0) return;
+
+    bool all_float = true;
+    for (int i = 0; i < InputSize(); i++)
+        all_float &= Input(i).template IsType<float>();
+    if (all_float) RunWithType<float>();
+    else LOG(FATAL) << "Unsupported input types.";
+}
+
+template <class Context>
+void FusedElementwiseGradientOp<Context>::ShareGradient() {
+    for (int i = 0; i < OutputSize(); i++) {
+        if (Output(i)->name() != "ignore") {
+            Tensor* dX = ws()->GetBuffer("Grad");
+            ws()->CreateAvatar(Output(i), dX);
+            break;
+        }
+    }
+}
+
+DEPLOY_CPU(FusedElementwiseGradient);
+#ifdef WITH_CUDA
+DEPLOY_CUDA(FusedElementwiseGradient);
+#endif
+OPERATOR_SCHEMA(FusedElementwiseGradient).NumInputs(2, INT_MAX).NumOutputs(1, INT_MAX);
+
+class GetFusedElementwiseGradient final : public GradientMakerBase {
+ public:
+    GRADIENT_MAKER_CTOR(GetFusedElementwiseGradient);
+    vector<OperatorDef> MakeDefs() override {
+        vector<string> inputs, outputs;
+        for (int i = 0; i < def.input_size(); i++) {
+            inputs.push_back(def.input(i));
+            outputs.push_back(GI(i));
+        }
+        inputs.push_back(GO(0));
+        return SingleDef(def.type() + "Gradient", "", inputs, outputs);
+    }
+};
+REGISTER_GRADIENT(FusedElementwise, GetFusedElementwiseGradient);
+
+}    // namespace dragon
@@ -35,7 +35,13 @@ DEPLOY_CPU(GramMatrix);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(GramMatrix);
 #endif
-OPERATOR_SCHEMA(GramMatrix).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(GramMatrix).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int axis = GetArgument<int>(def, "axis", 1);
+        const TIndex dim = inputs[0].dims(axis);
+        return vector<TensorProto>(1, TensorShape({
+            TensorCount(inputs[0], 0, axis), dim, dim }, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void GramMatrixGradientOp<Context>::RunWithType() {
@@ -1,6 +1,7 @@
 #include "operators/arithmetic/inner_product_op.h"
 #include "core/workspace.h"
 #include "utils/filler.h"
+#include "utils/op_kernel.h"
 
 namespace dragon {
 
@@ -22,10 +23,16 @@ void InnerProductOp<Context>::TransRunWithType() {
     auto* Ydata = Output(0)->template mutable_data<T, Context>();
     math::Gemm<T, Context>(CblasNoTrans, CblasTrans, M, num_output, K,
                            1.0, Xdata, Wdata, 0.0, Ydata);
-    if (InputSize() > 2) {
+    if (InputSize() > 2 && activation == "Relu") {
+        //  add the bias and activate in one pass
+        auto* Bdata = Input(2).template data<T, Context>();
+        kernel::BiasRelu<T, Context>(M, num_output, 1, Bdata, slope, Ydata);
+    } else if (InputSize() > 2) {
         auto* Bdata = Input(2).template data<T, Context>();
         math::Gemm<T, Context>(CblasNoTrans, CblasNoTrans, M, num_output, 1,
             1.0, bias_multiplier->data<T, Context>(), Bdata, 1.0, Ydata);
+    } else if (activation == "Relu") {
+        kernel::Relu<T, Context>(Output(0)->count(), Ydata, slope, Ydata);
     }
 }
 
@@ -47,10 +54,16 @@ void InnerProductOp<Context>::NoTransRunWithType() {
     auto* Ydata = Output(0)->template mutable_data<T, Context>();
     math::Gemm<T, Context>(CblasNoTrans, CblasNoTrans, M, num_output, K,
                            1.0, Xdata, Wdata, 0.0, Ydata);
-    if (InputSize() > 2) {
+    if (InputSize() > 2 && activation == "Relu") {
+        //  add the bias and activate in one pass
+        auto* Bdata = Input(2).template data<T, Context>();
+        kernel::BiasRelu<T, Context>(M, num_output, 1, Bdata, slope, Ydata);
+    } else if (InputSize() > 2) {
         auto* Bdata = Input(2).template data<T, Context>();
         math::Gemm<T, Context>(CblasNoTrans, CblasNoTrans, M, num_output, 1,
-                1.0, bias_multiplier->data<T, Context>(), Bdata, 1.0, Ydata);
+            1.0, bias_multiplier->data<T, Context>(), Bdata, 1.0, Ydata);
+    } else if (activation == "Relu") {
+        kernel::Relu<T, Context>(Output(0)->count(), Ydata, slope, Ydata);
     }
 }
 
@@ -72,7 +85,13 @@ DEPLOY_CPU(InnerProduct);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(InnerProduct);
 #endif
-OPERATOR_SCHEMA(InnerProduct).NumInputs(2, 3).NumOutputs(1);
+OPERATOR_SCHEMA(InnerProduct).NumInputs(2, 3).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int axis = GetArgument<int>(def, "axis", 1);
+        const TIndex num_output = GetArgument<int>(def, "num_output", 0);
+        return vector<TensorProto>(1, TensorShape({
+            TensorCount(inputs[0], 0, axis), num_output }, inputs[0].data_type()));
+    }, 1);
 
 template <class Context> template <typename T>
 void InnerProductGradientOp<Context>::RunWithType() {
@@ -23,7 +23,7 @@ DEPLOY_CPU(Log);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Log);
 #endif
-OPERATOR_SCHEMA(Log).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Log).NumInputs(1).NumOutputs(1).IdenticalShape();
 
 template <class Context> template <typename T>
 void LogGradientOp<Context>::RunWithType() {
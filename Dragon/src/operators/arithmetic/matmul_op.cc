@@ -58,7 +58,23 @@ DEPLOY_CPU(Matmul);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Matmul);
 #endif
-OPERATOR_SCHEMA(Matmul).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(Matmul).NumInputs(2).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const bool transA = GetArgument<bool>(def, "TransA", false);
+        const bool transB = GetArgument<bool>(def, "TransB", false);
+        vector<TIndex> x1 = TensorDims(inputs[0]), x2 = TensorDims(inputs[1]);
+        CHECK(x1.size() == x2.size() && x1.size() >= 2)
+            << "\n[" << def.name() << "] excepted the matrices of same dimensions.";
+        TIndex m = x1[x1.size() - 2], k = x1.back();
+        TIndex M = transA ? k : m, K1 = transA ? m : k;
+        TIndex K2 = transB ? x2.back() : x2[x2.size() - 2];
+        TIndex N = transB ? x2[x2.size() - 2] : x2.back();
+        CHECK_EQ(K1, K2) << "\n[" << def.name() << "] can not mul the matrices.";
+        CHECK_EQ(TensorCount(inputs[0]) / M / K1, TensorCount(inputs[1]) / K2 / N)
+            << "\n[" << def.name() << "] can not mul the matrices.";
+        x1[x1.size() - 2] = M; x1.back() = N;
+        return vector<TensorProto>(1, TensorShape(x1, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void MatmulGradientOp<Context>::RunWithType() {
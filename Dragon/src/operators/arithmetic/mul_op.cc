@@ -84,7 +84,7 @@ DEPLOY_CPU(Mul);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Mul);
 #endif
-OPERATOR_SCHEMA(Mul).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(Mul).NumInputs(2).NumOutputs(1).BroadcastShape(0);
 
 template <class Context> template <typename T>
 void MulGradientOp<Context>::EltwiseRunWithType() {
@@ -36,7 +36,7 @@ DEPLOY_CPU(Pow);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Pow);
 #endif
-OPERATOR_SCHEMA(Pow).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Pow).NumInputs(1).NumOutputs(1).IdenticalShape();
 
 template <class Context> template <typename T>
 void PowGradientOp<Context>::RunWithType() {
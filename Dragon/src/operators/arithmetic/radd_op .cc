@@ -83,7 +83,7 @@ DEPLOY_CPU(RAdd);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(RAdd);
 #endif
-OPERATOR_SCHEMA(RAdd).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(RAdd).NumInputs(2).NumOutputs(1).BroadcastShape(1);
 
 template <class Context> template <typename T>
 void RAddGradientOp<Context>::EltwiseRunWithType() {
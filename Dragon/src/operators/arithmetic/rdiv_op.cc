@@ -84,7 +84,7 @@ DEPLOY_CPU(RDiv);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(RDiv);
 #endif
-OPERATOR_SCHEMA(RDiv).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(RDiv).NumInputs(2).NumOutputs(1).BroadcastShape(1);
 
 template <class Context> template <typename T>
 void RDivGradientOp<Context>::EltwiseRunWithType() {
@@ -84,7 +84,7 @@ DEPLOY_CPU(RMul);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(RMul);
 #endif
-OPERATOR_SCHEMA(RMul).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(RMul).NumInputs(2).NumOutputs(1).BroadcastShape(1);
 
 template <class Context> template <typename T>
 void RMulGradientOp<Context>::EltwiseRunWithType() {
@@ -83,7 +83,7 @@ DEPLOY_CPU(RSub);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(RSub);
 #endif
-OPERATOR_SCHEMA(RSub).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(RSub).NumInputs(2).NumOutputs(1).BroadcastShape(1);
 
 template <class Context> template <typename T>
 void RSubGradientOp<Context>::EltwiseRunWithType() {
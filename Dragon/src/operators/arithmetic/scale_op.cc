@@ -52,7 +52,7 @@ DEPLOY_CPU(Scale);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Scale);
 #endif
-OPERATOR_SCHEMA(Scale).NumInputs(2, 3).NumOutputs(1);
+OPERATOR_SCHEMA(Scale).NumInputs(2, 3).NumOutputs(1).IdenticalShape();
 
 template <class Context> template <typename T>
 void ScaleGradientOp<Context>::BiasRunWithType() {
@@ -23,7 +23,7 @@ DEPLOY_CPU(Square);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Square);
 #endif
-OPERATOR_SCHEMA(Square).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Square).NumInputs(1).NumOutputs(1).IdenticalShape();
 
 template <class Context> template <typename T>
 void SquareGradientOp<Context>::RunWithType() {
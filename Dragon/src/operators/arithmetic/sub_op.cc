@@ -83,7 +83,8 @@ DEPLOY_CPU(Sub);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Sub);
 #endif
-OPERATOR_SCHEMA(Sub).NumInputs(2).NumOutputs(1).Inplace({ { 0, 0 }, { 1, 0 } });
+OPERATOR_SCHEMA(Sub).NumInputs(2).NumOutputs(1).Inplace({ { 0, 0 }, { 1, 0 } })
+    .BroadcastShape(0);
 
 template <class Context> template <typename T>
 void SubGradientOp<Context>::EltwiseRunWithType() {
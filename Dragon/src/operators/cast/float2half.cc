@@ -26,7 +26,11 @@ void FloatToHalfOp<Context>::RunOnDevice() {
 #ifdef WITH_CUDA
 DEPLOY_CUDA(FloatToHalf);
 #endif
-OPERATOR_SCHEMA(FloatToHalf).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(FloatToHalf).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        return vector<TensorProto>(1, TensorShape(
+            TensorDims(inputs[0]), TensorProto::FLOAT16));
+    });
 
 NO_GRADIENT(FloatToHalf);
 
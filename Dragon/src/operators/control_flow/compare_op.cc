@@ -30,7 +30,12 @@ DEPLOY_CPU(Compare);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Compare);
 #endif
-OPERATOR_SCHEMA(Compare).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(Compare).NumInputs(2).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        CHECK_EQ(TensorCount(inputs[0]), TensorCount(inputs[1]))
+            << "\n[" << def.name() << "] Both conditioned tensors should have same elements.";
+        return vector<TensorProto>(1, inputs[0]);
+    });
 
 NO_GRADIENT(Compare);
 
@@ -25,7 +25,7 @@ DEPLOY_CPU(Copy);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Copy);
 #endif
-OPERATOR_SCHEMA(Copy).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Copy).NumInputs(1).NumOutputs(1).IdenticalShape();
 NO_GRADIENT(Copy);
 
 }    // namespace dragon
\ No newline at end of file
@@ -42,7 +42,12 @@ DEPLOY_CPU(L1Loss);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(L1Loss);
 #endif
-OPERATOR_SCHEMA(L1Loss).NumInputs(2, 3).NumOutputs(1);
+OPERATOR_SCHEMA(L1Loss).NumInputs(2, 3).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        CHECK_EQ(TensorCount(inputs[0]), TensorCount(inputs[1]))
+            << "\n[" << def.name() << "] Number of predictions must match the number of labels.";
+        return vector<TensorProto>(1, TensorShape({ 1 }, inputs[0].data_type()));
+    }, 2);
 
 template <class Context> template <typename T>
 void L1LossGradientOp<Context>::RunWithType() {
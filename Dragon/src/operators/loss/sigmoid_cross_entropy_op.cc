@@ -51,7 +51,14 @@ DEPLOY_CPU(SigmoidCrossEntropy);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(SigmoidCrossEntropy);
 #endif
-OPERATOR_SCHEMA(SigmoidCrossEntropy).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(SigmoidCrossEntropy).NumInputs(2).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        CHECK_EQ(TensorCount(inputs[0]), TensorCount(inputs[1]))
+            << "\n[" << def.name() << "] Number of predictions must match the number of labels.";
+        if (GetArgument<string>(def, "normalization", "VALID") == "UNIT")
+            return vector<TensorProto>(1, inputs[0]);
+        return vector<TensorProto>(1, TensorShape({ 1 }, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void SigmoidCrossEntropyGradientOp<Context>::RunWithType() {
@@ -40,7 +40,7 @@ void SmoothL1LossOp<Context>::RunOnDevice() {
     Output(0)->Reshape(vector<TIndex>(1, 1));
 
     diff = ws()->CreateTensor("/mnt/" + Anchor() + "/smoothl1_loss/diff");
-    error = ws()->CreateTensor("/share/smoothl1_loss_error");
+    error = ws()->CreateTensor(ScratchName("/share/smoothl1_loss_error"));
     diff->ReshapeLike(Input(0));
     error->ReshapeLike(Input(0));
 
@@ -52,7 +52,12 @@ DEPLOY_CPU(SmoothL1Loss);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(SmoothL1Loss);
 #endif
-OPERATOR_SCHEMA(SmoothL1Loss).NumInputs(2, 4).NumOutputs(1);
+OPERATOR_SCHEMA(SmoothL1Loss).NumInputs(2, 4).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        CHECK_EQ(TensorCount(inputs[0]), TensorCount(inputs[1]))
+            << "\n[" << def.name() << "] Number of predictions must match the number of labels.";
+        return vector<TensorProto>(1, TensorShape({ 1 }, inputs[0].data_type()));
+    }, 2);
 
 template <class Context> template <typename T>
 void SmoothL1LossGradientOp<Context>::RunWithType() {
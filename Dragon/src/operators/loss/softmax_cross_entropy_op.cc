@@ -53,7 +53,16 @@ DEPLOY_CPU(SoftmaxCrossEntropy);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(SoftmaxCrossEntropy);
 #endif
-OPERATOR_SCHEMA(SoftmaxCrossEntropy).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(SoftmaxCrossEntropy).NumInputs(2).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int axis = GetArgument<int>(def, "axis", 1);
+        const TIndex num_preds = TensorCount(inputs[0], 0, axis) * TensorCount(inputs[0], axis + 1);
+        CHECK_EQ(TensorCount(inputs[0]), TensorCount(inputs[1]))
+            << "\n[" << def.name() << "] Number of predictions must match the number of labels.";
+        if (GetArgument<string>(def, "normalization", "FULL") == "UNIT")
+            return vector<TensorProto>(1, TensorShape({ num_preds }, inputs[0].data_type()));
+        return vector<TensorProto>(1, TensorShape({ 1 }, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void SoftmaxCrossEntropyGradientOp<Context>::RunWithType() {
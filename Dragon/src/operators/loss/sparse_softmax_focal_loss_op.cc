@@ -69,7 +69,16 @@ DEPLOY_CPU(SparseSoftmaxFocalLoss);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(SparseSoftmaxFocalLoss);
 #endif
-OPERATOR_SCHEMA(SparseSoftmaxFocalLoss).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(SparseSoftmaxFocalLoss).NumInputs(2).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int axis = GetArgument<int>(def, "axis", 1);
+        const TIndex num_preds = TensorCount(inputs[0], 0, axis) * TensorCount(inputs[0], axis + 1);
+        CHECK_EQ(num_preds, TensorCount(inputs[1]))
+            << "\n[" << def.name() << "] Number of predictions must match the number of labels.";
+        if (GetArgument<string>(def, "normalization", "VALID") == "UNIT")
+            return vector<TensorProto>(1, TensorShape({ num_preds }, inputs[0].data_type()));
+        return vector<TensorProto>(1, TensorShape({ 1 }, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void SparseSoftmaxFocalLossGradientOp<Context>::RunWithType() {
@@ -66,7 +66,17 @@ DEPLOY_CPU(Accuracy);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Accuracy);
 #endif
-OPERATOR_SCHEMA(Accuracy).NumInputs(2).NumOutputs(1, 2);
+OPERATOR_SCHEMA(Accuracy).NumInputs(2).NumOutputs(1, 2)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int axis = GetArgument<int>(def, "axis", 1);
+        CHECK_EQ(TensorCount(inputs[0], 0, axis) * TensorCount(inputs[0], axis + 1),
+                 TensorCount(inputs[1]))
+            << "\n[" << def.name() << "] Number of predictions must match the number of labels.";
+        vector<TensorProto> outputs(1, TensorShape({ 1 }));
+        if (def.output_size() > 1)
+            outputs.push_back(TensorShape({ inputs[0].dims(axis) }));
+        return outputs;
+    });
 
 NO_GRADIENT(Accuracy);
 
@@ -0,0 +1,47 @@
+#include "operators/misc/data_loader_op.h"
+
+namespace dragon {
+
+template <class Context>
+void DataLoaderOp<Context>::RunOnDevice() {
+    //  spawn the threads at the first run
+    if (!loader) loader.reset(new DataLoader(param));
+
+    //  assemble the batch into the outputs directly
+    DataSample sample;
+    float* Ydata = nullptr, *Ldata = nullptr;
+    TIndex sample_dim = 0, label_dim = 0;
+    for (int i = 0; i < param.batch_size; i++) {
+        loader->Next(&sample);
+        if (i == 0) {
+            sample_dim = sample.data.size();
+            label_dim = sample.labels.size();
+            Output(0)->Reshape(vector<TIndex>({ param.batch_size,
+                sample.channels, sample.height, sample.width }));
+            Output(1)->Reshape(vector<TIndex>({ param.batch_size, label_dim }));
+            Ydata = Output(0)->template mutable_data<float, CPUContext>();
+            Ldata = Output(1)->template mutable_data<float, CPUContext>();
+        } else {
+            CHECK(sample.channels == Output(0)->dim(1) &&
+                  sample.height == Output(0)->dim(2) &&
+                  sample.width == Output(0)->dim(3))
+                << "\nThe images of a batch should have the same shape, "
+                << "set the crop size if necessary.";
+            CHECK_EQ((TIndex)sample.labels.size(), label_dim);
+        }
+        CPUContext::Copy<float, CPUContext, CPUContext>(sample_dim,
+            Ydata + i * sample_dim, sample.data.data());
+        CPUContext::Copy<float, CPUContext, CPUContext>(label_dim,
+            Ldata + i * label_dim, sample.labels.data());
+    }
+}
+
+DEPLOY_CPU(DataLoader);
+#ifdef WITH_CUDA
+DEPLOY_CUDA(DataLoader);
+#endif
+OPERATOR_SCHEMA(DataLoader).NumInputs(0).NumOutputs(2);
+
+NO_GRADIENT(DataLoader);
+
+}    // namespace dragon
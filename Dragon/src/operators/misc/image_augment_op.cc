@@ -0,0 +1,90 @@
+#include "operators/misc/image_augment_op.h"
+#include "utils/op_kernel.h"
+
+namespace dragon {
+
+template <class Context> template <typename Tx>
+void ImageAugmentOp<Context>::RunWithType() {
+    //  draw the augmentation of each image ahead of the parallel kernel
+    params.resize(n * 5);
+    const bool is_train = phase() == "TRAIN";
+    std::uniform_real_distribution<float> scale_dist(min_scale, max_scale);
+    for (int i = 0; i < n; ++i) {
+        int* p = params.data() + i * 5;
+        const float scale = is_train ? scale_dist(rng) : 1.f;
+        p[0] = std::max(int(h * scale), 1);
+        p[1] = std::max(int(w * scale), 1);
+        CHECK(p[0] >= crop_h && p[1] >= crop_w)
+            << "\nThe resized image (" << p[0] << ", " << p[1] << ") "
+            << "is smaller than the crop size " << crop_size << ".";
+        if (is_train) {
+            p[2] = std::uniform_int_distribution<int>(0, p[0] - crop_h)(rng);
+            p[3] = std::uniform_int_distribution<int>(0, p[1] - crop_w)(rng);
+            p[4] = mirror ? (int)(rng() & 1) : 0;
+        } else {
+            p[2] = (p[0] - crop_h) / 2;
+            p[3] = (p[1] - crop_w) / 2;
+            p[4] = 0;
+        }
+    }
+
+    auto* Xdata = Input(0).template data<Tx, CPUContext>();
+    auto* Ydata = Output(0)->template mutable_data<float, CPUContext>();
+    kernel::ImageAugment<Tx, CPUContext>(n, c, h, w,
+                                   crop_h, crop_w,
+                                padding, fill_value,
+                                     params.data(),
+             mean_values.size() ? mean_values.data() : nullptr,
+               std_values.size() ? std_values.data() : nullptr,
+                                        data_format,
+                                              Xdata,
+                                              Ydata);
+}
+
+template <class Context>
+void ImageAugmentOp<Context>::RunOnDevice() {
+    n = Input(0).dim(0);
+    h = Input(0).dim(1);
+    w = Input(0).dim(2);
+    c = Input(0).dim(3);
+    if (mean_values.size() > 0) CHECK_EQ((TIndex)mean_values.size(), c)
+        << "\nThe number of mean values should be " << c << ".";
+    if (std_values.size() > 0) CHECK_EQ((TIndex)std_values.size(), c)
+        << "\nThe number of std values should be " << c << ".";
+    crop_h = crop_size > 0 ? crop_size : h;
+    crop_w = crop_size > 0 ? crop_size : w;
+    const TIndex out_h = crop_h + 2 * padding, out_w = crop_w + 2 * padding;
+
+    if (data_format == "NCHW") {
+        Output(0)->Reshape(vector<TIndex>({ n, c, out_h, out_w }));
+    } else if (data_format == "NHWC") {
+        Output(0)->Reshape(vector<TIndex>({ n, out_h, out_w, c }));
+    } else LOG(FATAL) << "Unknown data format: " << data_format;
+
+    if (Input(0).template IsType<uint8_t>()) RunWithType<uint8_t>();
+    else if (Input(0).template IsType<float>()) RunWithType<float>();
+    else LOG(FATAL) << "Unsupported input types.";
+}
+
+//  the images are augmented on the host in both contexts
+DEPLOY_CPU(ImageAugment);
+#ifdef WITH_CUDA
+DEPLOY_CUDA(ImageAugment);
+#endif
+OPERATOR_SCHEMA(ImageAugment).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        CHECK_EQ((int)dims.size(), 4) << "\n[" << def.name() << "] excepted the NHWC images.";
+        const TIndex crop_size = GetArgument<int>(def, "crop_size", 0);
+        const TIndex padding = GetArgument<int>(def, "padding", 0);
+        const TIndex out_h = (crop_size > 0 ? crop_size : dims[1]) + 2 * padding;
+        const TIndex out_w = (crop_size > 0 ? crop_size : dims[2]) + 2 * padding;
+        if (GetArgument<string>(def, "data_format", "NCHW") == "NCHW")
+            dims = vector<TIndex>({ dims[0], dims[3], out_h, out_w });
+        else dims = vector<TIndex>({ dims[0], out_h, out_w, dims[3] });
+        return vector<TensorProto>(1, TensorShape(dims));
+    });
+
+NO_GRADIENT(ImageAugment);
+
+}    // namespace dragon
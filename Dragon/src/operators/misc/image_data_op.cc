@@ -50,7 +50,16 @@ DEPLOY_CPU(ImageData);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(ImageData);
 #endif
-OPERATOR_SCHEMA(ImageData).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(ImageData).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        CHECK_EQ((int)dims.size(), 4) << "\n[" << def.name() << "] excepted the NHWC images.";
+        if (GetArgument<string>(def, "data_format", "NCHW") == "NCHW")
+            dims = vector<TIndex>({ dims[0], dims[3], dims[1], dims[2] });
+        const bool half = GetArgument<string>(def, "dtype", "FLOAT32") == "FLOAT16";
+        return vector<TensorProto>(1, TensorShape(dims,
+            half ? TensorProto::FLOAT16 : TensorProto::FLOAT));
+    });
 
 NO_GRADIENT(ImageData);
 
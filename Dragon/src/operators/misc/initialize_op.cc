@@ -28,12 +28,21 @@ void InitializeOp<Context>::RunOnDevice() {
     RunWithType<float>();
 }
 
+//  the shape is given by the "dims", or the "shape" tensor
+static vector<TensorProto> InitializeShape(const OperatorDef& def,
+                                           const vector<TensorProto>& inputs) {
+    if (!GetArgument<string>(def, "shape", "").empty()) return vector<TensorProto>();
+    vector<int> dims = GetArguments<int>(def, "dims");
+    return vector<TensorProto>(1, TensorShape(vector<TIndex>(dims.begin(), dims.end())));
+}
+
 //  constant
 DEPLOY_CPU(Fill);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Fill);
 #endif
-OPERATOR_SCHEMA(Fill).NumInputs(0, 1).NumOutputs(1);
+OPERATOR_SCHEMA(Fill).NumInputs(0, 1).NumOutputs(1)
+    .ShapeInference(InitializeShape, 0);
 NO_GRADIENT(Fill);
 
 //  uniform
@@ -41,7 +50,8 @@ DEPLOY_CPU(RandomUniform);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(RandomUniform);
 #endif
-OPERATOR_SCHEMA(RandomUniform).NumInputs(0, 1).NumOutputs(1);
+OPERATOR_SCHEMA(RandomUniform).NumInputs(0, 1).NumOutputs(1)
+    .ShapeInference(InitializeShape, 0);
 NO_GRADIENT(RandomUniform);
 
 //  normal
@@ -49,7 +59,8 @@ DEPLOY_CPU(RandomNormal);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(RandomNormal);
 #endif
-OPERATOR_SCHEMA(RandomNormal).NumInputs(0, 1).NumOutputs(1);
+OPERATOR_SCHEMA(RandomNormal).NumInputs(0, 1).NumOutputs(1)
+    .ShapeInference(InitializeShape, 0);
 NO_GRADIENT(RandomNormal);
 
 //  truncated normal
@@ -58,7 +69,8 @@ DEPLOY_CPU_CUDA(TruncatedNormal);
 #else
 DEPLOY_CPU(TruncatedNormal);
 #endif
-OPERATOR_SCHEMA(TruncatedNormal).NumInputs(0, 1).NumOutputs(1);
+OPERATOR_SCHEMA(TruncatedNormal).NumInputs(0, 1).NumOutputs(1)
+    .ShapeInference(InitializeShape, 0);
 NO_GRADIENT(TruncatedNormal);
 
 //  glorot uniform
@@ -66,7 +78,8 @@ DEPLOY_CPU(GlorotUniform);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(GlorotUniform);
 #endif
-OPERATOR_SCHEMA(GlorotUniform).NumInputs(0, 1).NumOutputs(1);
+OPERATOR_SCHEMA(GlorotUniform).NumInputs(0, 1).NumOutputs(1)
+    .ShapeInference(InitializeShape, 0);
 NO_GRADIENT(GlorotUniform);
 
 //  glorot normal
@@ -74,7 +87,8 @@ DEPLOY_CPU(GlorotNormal);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(GlorotNormal);
 #endif
-OPERATOR_SCHEMA(GlorotNormal).NumInputs(0, 1).NumOutputs(1);
+OPERATOR_SCHEMA(GlorotNormal).NumInputs(0, 1).NumOutputs(1)
+    .ShapeInference(InitializeShape, 0);
 NO_GRADIENT(GlorotNormal);
 
 }    // namespace dragon
\ No newline at end of file
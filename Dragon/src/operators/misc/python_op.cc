@@ -19,6 +19,7 @@ RunOp<Context>::RunOp(const OperatorDef& op_def, Workspace* ws)
       param_str((OperatorBase::GetSingleArg<string>("param_str", ""))) {
     //  init interpreter & load module
     Py_Initialize();
+    ScopedGILAcquire gil;
     PyObject* py_module = PyImport_ImportModule(module.c_str());
     CHECK(py_module) << "\nFail to import py module: " << module;
     PyObject* py_dict = PyModule_GetDict(py_module);
@@ -47,6 +48,7 @@ RunOp<Context>::RunOp(const OperatorDef& op_def, Workspace* ws)
 
 template <class Context>
 void RunOp<Context>::RunOnDevice() {
+    ScopedGILAcquire gil;
     //  init phase
     PyObject_SetAttr(self, String("phase"), String(this->phase().c_str()));
 
@@ -72,6 +74,7 @@ NO_GRADIENT(Run);
 
 template <class Context>
 void TemplateGradientOp<Context>::RunOnDevice() {
+    ScopedGILAcquire gil;
     //  init phase
     PyObject_SetAttr(this->self, String("phase"), String(this->phase().c_str()));
 
@@ -25,7 +25,16 @@ DEPLOY_CPU(Arange);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Arange);
 #endif
-OPERATOR_SCHEMA(Arange).NumInputs(0).NumOutputs(1);
+OPERATOR_SCHEMA(Arange).NumInputs(0).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        TIndex start = GetArgument<int>(def, "start", 0);
+        TIndex stop = GetArgument<int>(def, "stop", 0);
+        TIndex step = GetArgument<int>(def, "step", 1);
+        if (stop == 0) { stop = start; start = 0; }
+        const bool int32 = GetArgument<string>(def, "dtype", "FLOAT32") == "INT32";
+        return vector<TensorProto>(1, TensorShape({ (stop - start - 1) / step + 1 },
+            int32 ? TensorProto::INT32 : TensorProto::FLOAT));
+    });
 
 NO_GRADIENT(Arange);
 
@@ -49,7 +49,24 @@ DEPLOY_CPU(Argmin);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Argmin);
 #endif
-OPERATOR_SCHEMA(Argmin).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Argmin).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int axis = GetArgument<int>(def, "axis", -1);
+        const TIndex top_k = GetArgument<int>(def, "top_k", 1);
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        if (!GetArgument<bool>(def, "keep_dims", false)) {
+            if (axis != -1) {
+                if (top_k == 1) dims.erase(dims.begin() + axis);
+                else dims[axis] = top_k;
+            } else {
+                dims = vector<TIndex>(1, top_k);
+            }
+        } else {
+            if (axis == -1) dims = vector<TIndex>(dims.size(), 1);
+            dims[axis] = top_k;
+        }
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 NO_GRADIENT(Argmin);
 
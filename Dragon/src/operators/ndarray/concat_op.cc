@@ -59,7 +59,25 @@ DEPLOY_CPU(Concat);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Concat);
 #endif
-OPERATOR_SCHEMA(Concat).NumInputs(1, INT_MAX).NumOutputs(1);
+OPERATOR_SCHEMA(Concat).NumInputs(1, INT_MAX).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int axis = GetArgument<int>(def, "axis", 1);
+        const int nin = GetArgument<int>(def, "num_input", 1);
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        if (axis < 0 || axis >= (int)dims.size())
+            return InvalidShape(def, "The concat axis is out of the range.");
+        for (int i = 1; i < nin; i++) {
+            if ((int)dims.size() != inputs[i].dims_size())
+                return InvalidShape(def, "All inputs should have the same ndim.");
+            for (int j = 0; j < (int)dims.size(); j++) {
+                if (j != axis && dims[j] != inputs[i].dims(j))
+                    return InvalidShape(def, "All inputs should have the same dimensions"
+                                             ", except the concat axis.");
+            }
+            dims[axis] += inputs[i].dims(axis);
+        }
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void ConcatGradientOp<Context>::RunWithType() {
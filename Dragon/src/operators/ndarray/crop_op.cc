@@ -134,7 +134,40 @@ DEPLOY_CPU(Crop);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Crop);
 #endif
-OPERATOR_SCHEMA(Crop).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Crop).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int start_axis = GetArgument<int>(def, "start_axis", -1);
+        vector<int> starts = GetArguments<int>(def, "starts");
+        vector<int> ends = GetArguments<int>(def, "ends");
+        vector<int> offsets = GetArguments<int>(def, "offsets");
+        vector<int> shape = GetArguments<int>(def, "shape");
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        const int ndim = (int)dims.size();
+        if (start_axis != -1) {
+            starts.assign(ndim, 0);
+            for (int i = start_axis; i < ndim && offsets.size() > 0; i++)
+                starts[i] = offsets[std::min(i - start_axis, (int)offsets.size() - 1)];
+        }
+        if (shape.size() > 0) {
+            CHECK_EQ((int)shape.size(), ndim)
+                << "\n[" << def.name() << "] The cropping is performed on "
+                << shape.size() << " dimensions.";
+            ends.resize(ndim);
+            for (int i = 0; i < ndim; i++) ends[i] = (start_axis != -1 &&
+                i < start_axis) ? (int)dims[i] : starts[i] + shape[i];
+        }
+        CHECK(ndim == (int)starts.size() && ndim == (int)ends.size())
+            << "\n[" << def.name() << "] The cropping is performed on "
+            << starts.size() << " dimensions.";
+        for (int i = 0; i < ndim; i++) {
+            if (ends[i] == 0) ends[i] = (int)dims[i];
+            CHECK(starts[i] >= 0 && starts[i] < dims[i] && ends[i] > 0 && ends[i] <= dims[i])
+                << "\n[" << def.name() << "] Crop [" << starts[i] << ", " << ends[i]
+                << ") of axis " << i << ", while the dimension is " << dims[i] << ".";
+            dims[i] = ends[i] - starts[i];
+        }
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 template <class Context>
 void CropGradientOp<Context>::Setup() {
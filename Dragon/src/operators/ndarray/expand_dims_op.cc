@@ -15,7 +15,14 @@ DEPLOY_CPU(ExpandDims);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(ExpandDims);
 #endif
-OPERATOR_SCHEMA(ExpandDims).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(ExpandDims).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int axis = GetArgument<int>(def, "axis", -1);
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        if (axis == -1 || axis >= (int)dims.size()) dims.push_back(1);
+        else dims.insert(dims.begin() + axis, 1);
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 template <class Context>
 void ExpandDimsGradientOp<Context>::RunOnDevice() {
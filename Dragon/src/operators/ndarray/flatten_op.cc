@@ -42,7 +42,32 @@ DEPLOY_CPU(Flatten);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Flatten);
 #endif
-OPERATOR_SCHEMA(Flatten).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Flatten).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int axis = GetArgument<int>(def, "axis", 0);
+        const int num_axes = GetArgument<int>(def, "num_axes", -1);
+        const int keep_axes = GetArgument<int>(def, "keep_axes", INT_MAX);
+        const vector<TIndex> in_dims = TensorDims(inputs[0]);
+        vector<TIndex> dims;
+        if (keep_axes != INT_MAX) {
+            CHECK_LE(keep_axes, (int)in_dims.size())
+                << "\n[" << def.name() << "] The total number of axes is "
+                << in_dims.size() << ", can not keep " << keep_axes << " .";
+            int i = 0;
+            for (; i < keep_axes - 1; i++) dims.push_back(in_dims[i]);
+            if (TensorCount(inputs[0], i) != 1) dims.push_back(TensorCount(inputs[0], i));
+        } else {
+            for (int i = 0; i < axis; i++) dims.push_back(in_dims[i]);
+            if (num_axes < 1) {
+                dims.push_back(TensorCount(inputs[0], axis));
+            } else {
+                dims.push_back(TensorCount(inputs[0], axis, axis + num_axes));
+                for (int i = axis + num_axes; i < (int)in_dims.size(); i++)
+                    dims.push_back(in_dims[i]);
+            }
+        }
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 
 template <class Context>
@@ -39,7 +39,14 @@ DEPLOY_CPU(Gather);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Gather);
 #endif
-OPERATOR_SCHEMA(Gather).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(Gather).NumInputs(2).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int axis = GetArgument<int>(def, "axis", 0);
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        dims[axis] = TensorCount(inputs[1]);
+        CHECK_GT(dims[axis], 0) << "\n[" << def.name() << "] Length of indices must > 0.";
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void GatherGradientOp<Context>::RunWithType() {
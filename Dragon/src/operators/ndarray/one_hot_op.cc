@@ -29,7 +29,12 @@ DEPLOY_CPU(OneHot);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(OneHot);
 #endif
-OPERATOR_SCHEMA(OneHot).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(OneHot).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        dims.push_back(GetArgument<int>(def, "depth", -1));
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 NO_GRADIENT(OneHot);
 
@@ -106,7 +106,17 @@ DEPLOY_CPU(Pad);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Pad);
 #endif
-OPERATOR_SCHEMA(Pad).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Pad).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        vector<int> pad_l = GetArguments<int>(def, "pad_l");
+        vector<int> pad_r = GetArguments<int>(def, "pad_r");
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        CHECK(dims.size() == pad_l.size() && dims.size() == pad_r.size())
+            << "\n[" << def.name() << "] The padding is performed on "
+            << pad_l.size() << " dimensions.";
+        for (int i = 0; i < (int)dims.size(); i++) dims[i] += (pad_l[i] + pad_r[i]);
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void PadGradientOp<Context>::ConstRunWithType() {
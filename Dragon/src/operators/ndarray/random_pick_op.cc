@@ -7,9 +7,11 @@ namespace dragon {
 
 template <class Context> template <typename T>
 void RandomPickOp<Context>::RunWithType() {
+    //  draw from the generator of this operator,
+    //  which is safe if the operators are running concurrently
     auto* indices = pick_indices->template mutable_data<int, CPUContext>();
-    for (int i = 0; i < pick_indices->count(); i++)
-        indices[i] = int((*rand_generator())() % x_slice_dim);
+    math::RandomUniform<uint32_t, CPUContext>(pick_indices->count(),
+        0, float(x_slice_dim - 1), (uint32_t*)indices);
 
     auto* Xdata = Input(0).template data<T, Context>();
     indices = pick_indices->template mutable_data<int, Context>();
@@ -48,7 +50,15 @@ DEPLOY_CPU(RandomPick);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(RandomPick);
 #endif
-OPERATOR_SCHEMA(RandomPick).NumInputs(1).NumOutputs(2);
+OPERATOR_SCHEMA(RandomPick).NumInputs(1).NumOutputs(2)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int axis = GetArgument<int>(def, "axis", 0);
+        const TIndex max_samples = GetArgument<int>(def, "max_samples", 1);
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        dims[axis] = max_samples;
+        return vector<TensorProto>({ TensorShape(dims, inputs[0].data_type()),
+            TensorShape({ max_samples }, TensorProto::INT32) });
+    });
 
 template <class Context> template <typename T>
 void RandomPickGradientOp<Context>::RunWithType() {
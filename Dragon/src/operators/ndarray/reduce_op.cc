@@ -61,7 +61,19 @@ DEPLOY_CPU(Reduce);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Reduce);
 #endif
-OPERATOR_SCHEMA(Reduce).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Reduce).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int axis = GetArgument<int>(def, "axis", -1);
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        if (!GetArgument<bool>(def, "keep_dims", false)) {
+            if (axis != -1) dims.erase(dims.begin() + axis);
+            else dims = vector<TIndex>(1, 1);
+        } else {
+            if (axis != -1) dims[axis] = 1;
+            else dims = vector<TIndex>(dims.size(), 1);
+        }
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void ReduceGradientOp<Context>::SumRunWithType() {
@@ -41,7 +41,15 @@ DEPLOY_CPU(Repeat);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Repeat);
 #endif
-OPERATOR_SCHEMA(Repeat).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Repeat).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int axis = GetArgument<int>(def, "axis", -1);
+        const TIndex repeats = GetArgument<int>(def, "repeats", 1);
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        if (axis == -1) dims = vector<TIndex>(1, TensorCount(inputs[0]) * repeats);
+        else dims[axis] *= repeats;
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void RepeatGradientOp<Context>::RunWithType() {
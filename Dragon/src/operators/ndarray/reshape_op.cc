@@ -73,7 +73,39 @@ DEPLOY_CPU(Reshape);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Reshape);
 #endif
-OPERATOR_SCHEMA(Reshape).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Reshape).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        vector<int> shape = GetArguments<int>(def, "shape");
+        const TIndex count = TensorCount(inputs[0]);
+        if (shape.empty()) return InvalidShape(def, "Missing the require shape.");
+        vector<TIndex> dims(shape.size());
+        int infer_dim = -1;
+        TIndex total_count = 1;
+        for (int i = 0; i < (int)shape.size(); i++) {
+            if (shape[i] == 0) {
+                if (i >= inputs[0].dims_size())
+                    return InvalidShape(def, "Dim(" + dragon_cast<string, int>(i)
+                                                    + ") is out of the range.");
+                dims[i] = inputs[0].dims(i);
+            } else if (shape[i] > 0) {
+                dims[i] = shape[i];
+            } else {
+                if (infer_dim != -1)
+                    return InvalidShape(def, "Could not infer two dimensions.");
+                infer_dim = i;
+                continue;
+            }
+            total_count *= dims[i];
+        }
+        if (infer_dim != -1) {
+            if (total_count <= 0 || count % total_count != 0)
+                return InvalidShape(def, "Can not change the total size.");
+            dims[infer_dim] = count / total_count;
+            total_count *= dims[infer_dim];
+        }
+        if (total_count != count) return InvalidShape(def, "Can not change the total size.");
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 template <class Context>
 void ReshapeGradientOp<Context>::RunOnDevice() {
@@ -16,7 +16,11 @@ DEPLOY_CPU(Shape);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Shape);
 #endif
-OPERATOR_SCHEMA(Shape).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Shape).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        return vector<TensorProto>(1, TensorShape(
+            { inputs[0].dims_size() }, TensorProto::INT32));
+    });
 
 NO_GRADIENT(Shape);
 
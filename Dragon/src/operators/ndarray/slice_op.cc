@@ -41,7 +41,18 @@ DEPLOY_CPU(Slice);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Slice);
 #endif
-OPERATOR_SCHEMA(Slice).NumInputs(1).NumOutputs(1, INT_MAX);
+OPERATOR_SCHEMA(Slice).NumInputs(1).NumOutputs(1, INT_MAX)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int axis = GetArgument<int>(def, "axis", 1);
+        const TIndex nout = GetArgument<int>(def, "num_output", 1);
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        CHECK_EQ(dims[axis] % nout, 0)
+            << "\n[" << def.name() << "] Selected dim is " << dims[axis]
+            << ", can't be sliced by nout of " << nout;
+        dims[axis] /= nout;
+        return vector<TensorProto>(def.output_size(),
+            TensorShape(dims, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void SliceGradientOp<Context>::RunWithType() {
@@ -57,7 +57,18 @@ DEPLOY_CPU(Stack);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Stack);
 #endif
-OPERATOR_SCHEMA(Stack).NumInputs(1, INT_MAX).NumOutputs(1);
+OPERATOR_SCHEMA(Stack).NumInputs(1, INT_MAX).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        int axis = GetArgument<int>(def, "axis", 0);
+        const int nin = GetArgument<int>(def, "num_input", 1);
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        while (axis < 0) axis += ((int)dims.size() + 1);
+        for (int i = 1; i < nin; i++)
+            CHECK(TensorDims(inputs[i]) == dims)
+                << "\n[" << def.name() << "] All inputs should have the same dimensions.";
+        dims.insert(dims.begin() + axis, (TIndex)nin);
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void StackGradientOp<Context>::RunWithType() {
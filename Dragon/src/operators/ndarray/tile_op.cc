@@ -61,7 +61,15 @@ DEPLOY_CPU(Tile);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Tile);
 #endif
-OPERATOR_SCHEMA(Tile).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Tile).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        vector<int> multiples = GetArguments<int>(def, "multiples");
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        CHECK_GE((int)multiples.size(), (int)dims.size());
+        for (int i = 0; i < (int)dims.size(); i++)
+            if (multiples[i] > 1) dims[i] *= multiples[i];
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void TileGradientOp<Context>::TileRunWithType() {
@@ -59,7 +59,17 @@ DEPLOY_CPU(Transpose);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Transpose);
 #endif
-OPERATOR_SCHEMA(Transpose).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Transpose).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        vector<int> perms = GetArguments<int>(def, "perms");
+        if (perms.empty())
+            for (int i = inputs[0].dims_size() - 1; i >= 0; i--) perms.push_back(i);
+        CHECK_EQ(inputs[0].dims_size(), (int)perms.size())
+            << "\n[" << def.name() << "] Provide " << perms.size() << " dims to permsute.";
+        vector<TIndex> dims;
+        for (auto perm : perms) dims.push_back(inputs[0].dims(perm));
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void TransposeGradientOp<Context>::RunWithType() {
@@ -236,7 +236,7 @@ DEPLOY_CPU(BatchNorm);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(BatchNorm);
 #endif
-OPERATOR_SCHEMA(BatchNorm).NumInputs(3, 4).NumOutputs(1);
+OPERATOR_SCHEMA(BatchNorm).NumInputs(3, 4).NumOutputs(1).IdenticalShape();
 
 template <class Context> template <typename T>
 void BatchNormGradientOp<Context>::TrainingRunWithType() {
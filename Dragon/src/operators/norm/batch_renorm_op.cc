@@ -312,7 +312,7 @@ DEPLOY_CPU(BatchRenorm);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(BatchRenorm);
 #endif
-OPERATOR_SCHEMA(BatchRenorm).NumInputs(3, 4).NumOutputs(1); 
+OPERATOR_SCHEMA(BatchRenorm).NumInputs(3, 4).NumOutputs(1).IdenticalShape();
 
 template <class Context> template <typename T>
 void BatchRenormGradientOp<Context>::TrainingRunWithType() {
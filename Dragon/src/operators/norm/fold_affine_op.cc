@@ -0,0 +1,100 @@
+#include "operators/norm/fold_affine_op.h"
+#include "core/workspace.h"
+#include "utils/math_functions.h"
+#include "utils/op_kernel.h"
+#include "utils/filler.h"
+
+namespace dragon {
+
+template <class Context> template <typename T>
+void FoldAffineOp<Context>::RunWithType() {
+    //  y = alpha * (W * x + B) + beta  =>  W' = alpha * W, B' = alpha * B + beta
+    Tensor* buffer = ws()->GetBuffer();
+    buffer->Reshape(vector<TIndex>(1, C));
+    auto* Adata = alpha.template mutable_data<T, Context>();
+    auto* Bdata = Output(1)->template mutable_data<T, Context>();
+    auto* Tdata = buffer->template mutable_data<T, Context>();
+    math::Set<T, Context>(C, dragon_cast<T, float>(1.0f), Adata);
+    if (has_bias) {
+        TENSOR_FILL(Input(1), vector<TIndex>(1, C));
+        ctx().template Copy<T, Context, Context>(C, Bdata,
+            Input(1).template data<T, Context>());
+    } else {
+        math::Set<T, Context>(C, dragon_cast<T, float>(0.0f), Bdata);
+    }
+
+    int idx = has_bias ? 2 : 1, norm_idx = 0;
+    for (auto& stage : stages) {
+        if (stage == "norm" || stage == "norm_caffe") {
+            TENSOR_FILL(Input(idx), vector<TIndex>(1, C));        //  mean
+            TENSOR_FILL(Input(idx + 1), vector<TIndex>(1, C));    //  var
+            auto* Mdata = Input(idx).template data<T, Context>();
+            auto* Vdata = Input(idx + 1).template data<T, Context>();
+            float scale = 1.0;
+            if (stage == "norm_caffe") {
+                TENSOR_FILL(Input(idx + 2), vector<TIndex>(1, 1));
+                auto* Fdata = Input(idx + 2).template data<T, CPUContext>();
+                const float factor = dragon_cast<float, T>(Fdata[0]);
+                scale = factor == 0 ? 0 : 1.0 / factor;
+                idx += 3;
+            } else { idx += 2; }
+            //  1 / sqrt(var + eps)
+            math::Scale<T, Context>(C, scale, Vdata, Tdata);
+            math::AddScalar<T, Context>(C, eps[norm_idx++], Tdata);
+            math::Sqrt<T, Context>(C, Tdata, Tdata);
+            math::Inv<T, Context>(C, 1.0, Tdata, Tdata);
+            math::Axpy<T, Context>(C, -scale, Mdata, Bdata);
+            math::Mul<T, Context>(C, Bdata, Tdata, Bdata);
+            math::Mul<T, Context>(C, Adata, Tdata, Adata);
+        } else if (stage == "scale" || stage == "scale_bias") {
+            TENSOR_FILL(Input(idx), vector<TIndex>(1, C));    //  gamma
+            auto* Gdata = Input(idx).template data<T, Context>();
+            math::Mul<T, Context>(C, Bdata, Gdata, Bdata);
+            math::Mul<T, Context>(C, Adata, Gdata, Adata);
+            if (stage == "scale_bias") {
+                TENSOR_FILL(Input(idx + 1), vector<TIndex>(1, C));    //  beta
+                math::Add<T, Context>(C, Bdata,
+                    Input(idx + 1).template data<T, Context>(), Bdata);
+                idx += 2;
+            } else { idx += 1; }
+        } else {
+            LOG(FATAL) << "Unknown affine stage: " << stage;
+        }
+    }
+    CHECK_EQ(idx, InputSize()) << "\nThe stages do not match the inputs.";
+    ws()->ReleaseBuffer(buffer);
+
+    kernel::Scale<T, Context>(axis, &Input(0), &alpha,
+                                   nullptr, nullptr,
+                                          Output(0));
+}
+
+template <class Context>
+void FoldAffineOp<Context>::RunOnDevice() {
+    CHECK_GT(Input(0).count(), 0)
+        << "\nTensor(" << Input(0).name() << ") is empty, can not fold it.";
+    CHECK_LT(axis, (int)Input(0).ndim());
+    C =Input(0).dim(axis);
+    alpha.Reshape(vector<TIndex>(1, C));
+    Output(0)->ReshapeLike(Input(0));
+    Output(1)->Reshape(vector<TIndex>(1, C));
+
+    if (Input(0).template IsType<float>()) RunWithType<float>();
+    else LOG(FATAL) << "Unsupported input types.";
+}
+
+DEPLOY_CPU(FoldAffine);
+#ifdef WITH_CUDA
+DEPLOY_CUDA(FoldAffine);
+#endif
+OPERATOR_SCHEMA(FoldAffine).NumInputs(2, INT_MAX).NumOutputs(2)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const int axis = GetArgument<int>(def, "axis", 0);
+        CHECK_LT(axis, inputs[0].dims_size());
+        return vector<TensorProto>({ inputs[0], TensorShape(
+            { inputs[0].dims(axis) }, inputs[0].data_type()) });
+    }, 1);
+
+NO_GRADIENT(FoldAffine);
+
+}    // namespace dragon
@@ -282,7 +282,7 @@ DEPLOY_CPU(FusedBatchNorm);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(FusedBatchNorm);
 #endif
-OPERATOR_SCHEMA(FusedBatchNorm).NumInputs(5).NumOutputs(1);
+OPERATOR_SCHEMA(FusedBatchNorm).NumInputs(5).NumOutputs(1).IdenticalShape();
 
 template <class Context> template <typename T>
 void FusedBatchNormGradientOp<Context>::TrainingRunWithType() {
@@ -263,7 +263,7 @@ DEPLOY_CPU(FusedGroupNorm);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(FusedGroupNorm);
 #endif
-OPERATOR_SCHEMA(FusedGroupNorm).NumInputs(5).NumOutputs(1);
+OPERATOR_SCHEMA(FusedGroupNorm).NumInputs(5).NumOutputs(1).IdenticalShape();
 
 template <class Context> template <typename T>
 void FusedGroupNormGradientOp<Context>::TrainingRunWithType() {
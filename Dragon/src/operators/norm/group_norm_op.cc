@@ -217,7 +217,7 @@ DEPLOY_CPU(GroupNorm);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(GroupNorm);
 #endif
-OPERATOR_SCHEMA(GroupNorm).NumInputs(3, 4).NumOutputs(1);
+OPERATOR_SCHEMA(GroupNorm).NumInputs(3, 4).NumOutputs(1).IdenticalShape();
 
 template <class Context> template <typename T>
 void GroupNormGradientOp<Context>::TrainingRunWithType() {
@@ -132,7 +132,7 @@ DEPLOY_CPU(InstanceNorm);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(InstanceNorm);
 #endif
-OPERATOR_SCHEMA(InstanceNorm).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(InstanceNorm).NumInputs(1).NumOutputs(1).IdenticalShape();
 
 template <class Context> template <typename T>
 void InstanceNormGradientOp<Context>::RunWithType() {
@@ -89,7 +89,7 @@ DEPLOY_CPU(L2Norm);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(L2Norm);
 #endif
-OPERATOR_SCHEMA(L2Norm).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(L2Norm).NumInputs(1).NumOutputs(1).IdenticalShape();
 
 template <class Context> template <typename T>
 void L2NormGradientOp<Context>::RunWithType() {
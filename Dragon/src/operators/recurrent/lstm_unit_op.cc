@@ -39,7 +39,7 @@ DEPLOY_CPU(LSTMUnit);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(LSTMUnit);
 #endif
-OPERATOR_SCHEMA(LSTMUnit).NumInputs(2, 3).NumOutputs(2);
+OPERATOR_SCHEMA(LSTMUnit).NumInputs(2, 3).NumOutputs(2).IdenticalShape();
 
 
 template <class Context> template <typename T>
@@ -69,7 +69,7 @@ void LSTMUnitGradientOp<Context>::RunOnDevice() {
     Output(0)->ReshapeLike(Input(0));
     Output(1)->ReshapeLike(Input(1));
     if (InputSize() != 5) {
-        zeros = ws()->CreateTensor("/share/zeros");
+        zeros = ws()->CreateTensor(ScratchName("/share/zeros"));
         if (zeros->count() < Input(0).count())
             zeros->ReshapeLike(Input(0));
     }
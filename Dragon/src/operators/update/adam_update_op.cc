@@ -5,28 +5,40 @@
 namespace dragon {
 
 template <class Context>
-void AdamUpdateOp<Context>::ComputeRunWithFloat() {
-    m = ws()->CreateTensor("/mnt/" + Slot() + "/adam/m");
-    v = ws()->CreateTensor("/mnt/" + Slot() + "/adam/v");
-    tmp = ws()->CreateTensor("/mnt/" + Slot() + "/adam/tmp");
-    m->ReshapeLike(Input(0));
-    v->ReshapeLike(Input(0));
+void AdamUpdateOp<Context>::SetupRunWithFloat() {
     t++;
     coeff = sqrt(1. - pow(beta2, t)) / (1. - pow(beta1, t));
-    lr = Param("base_lr") * coeff * this->lr_mult;
-    kernel::AdamUpdate<float, Context>(&Input(0),
-                                       m, v, tmp,
-                                           beta1,
-                                           beta2,
-                                             eps,
-                                             lr);
+    lr = Param("base_lr") * coeff;
+}
+
+template <class Context>
+void AdamUpdateOp<Context>::ComputeRunWithFloat(const int idx) {
+    m = ws()->CreateTensor("/mnt/" + Slot(idx) + "/adam/m");
+    v = ws()->CreateTensor("/mnt/" + Slot(idx) + "/adam/v");
+    m->ReshapeLike(Input(idx));
+    v->ReshapeLike(Input(idx));
+    auto* dXdata = Input(idx).template mutable_data<float, Context>();
+    auto* Xdata = Output(idx)->template mutable_data<float, Context>();
+    auto* Mdata = m->template mutable_data<float, Context>();
+    auto* Vdata = v->template mutable_data<float, Context>();
+    kernel::AdamUpdate<float, Context>(Input(idx).count(),
+                                          lr * lr_mults[idx],
+                                                       beta1,
+                                                       beta2,
+                                                         eps,
+                                                  grad_scale,
+                                                  grad_decay,
+                                                       Xdata,
+                                                      dXdata,
+                                                       Mdata,
+                                                      Vdata);
 }
 
 DEPLOY_CPU(AdamUpdate);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(AdamUpdate);
 #endif
-OPERATOR_SCHEMA(AdamUpdate).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(AdamUpdate).NumInputs(1, INT_MAX).NumOutputs(1, INT_MAX);
 
 NO_GRADIENT(AdamUpdate);
 
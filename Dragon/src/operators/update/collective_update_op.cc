@@ -1,6 +1,8 @@
 #include "operators/update/collective_update_op.h"
 #include "core/workspace.h"
+#include "utils/cast.h"
 #include "utils/math_functions.h"
+#include "utils/omp_alternative.h"
 
 namespace dragon {
 
@@ -20,6 +22,9 @@ void CollectiveUpdateOp<Context>::InitMPI() {
     MPI_Comm_group(MPI_COMM_WORLD, &world_group);
     MPI_Group_translate_ranks(world_group, 1, &world_root, group, &comm_root);
     CHECK(comm_root != MPI_UNDEFINED) << "\nMPI root is not included in layer group.";
+    bucket_comm = local_comm = cross_comm = MPI_COMM_NULL;
+    ring_size = comm_size;
+    half_buffer = nullptr;
 }
 
 template <class Context>
@@ -36,21 +41,291 @@ void CollectiveUpdateOp<Context>::InitNCCL() {
 #endif
 }
 
+template <class Context>
+void CollectiveUpdateOp<Context>::InitBuckets() {
+    //  the ring messages of the buckets should not match the others,
+    //  which may be sent on the same communicator by other threads
+    MPI_Comm_dup(comm, &bucket_comm);
+    if (mode == "MIXED_ALLREDUCE") InitMixed(bucket_comm);
+    if (!overlap) return;
+    for (int i = 0; i < InputSize(); i++) {
+        hooked_tensors.push_back(Input(i).name());
+        ws()->SetTensorHook(Input(i).name(), [this, i](const string& name, bool ready) {
+            GradientHook(i, ready);
+        });
+    }
+    comm_thread = std::thread(&CollectiveUpdateOp<Context>::CommunicationLoop, this);
+}
+
+template <class Context>
+void CollectiveUpdateOp<Context>::InitMixed(MPI_Comm base_comm) {
+    MPI_Comm_split_type(base_comm, MPI_COMM_TYPE_SHARED, comm_rank,
+                                       MPI_INFO_NULL, &local_comm);
+    MPI_Comm_size(local_comm, &local_size);
+    MPI_Comm_rank(local_comm, &local_rank);
+    //  the first rank of each node leads
+    MPI_Comm_split(base_comm, local_rank == 0 ? 0 : MPI_UNDEFINED,
+                                          comm_rank, &cross_comm);
+    if (cross_comm != MPI_COMM_NULL) MPI_Comm_size(cross_comm, &ring_size);
+    else ring_size = 1;
+}
+
+template <class Context>
+CollectiveUpdateOp<Context>::~CollectiveUpdateOp() {
+    for (auto& name : hooked_tensors) ws()->ClearTensorHook(name);
+    if (comm_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(comm_mutex);
+            comm_stop = true;
+        }
+        comm_cond.notify_all();
+        comm_thread.join();
+    }
+    //  the communicators created by this operator,
+    //  which can not be freed after finalizing
+    int finalized;
+    MPI_Finalized(&finalized);
+    if (finalized) return;
+    for (MPI_Comm* created : { &bucket_comm, &local_comm, &cross_comm })
+        if (*created != MPI_COMM_NULL) MPI_Comm_free(created);
+}
+
+template <class Context>
+void CollectiveUpdateOp<Context>::MPIAllReduce(const TIndex count,
+                                               MPI_Comm comm,
+                                               float* x,
+                                               float* buffer) {
+    //  the ring may be a part of ranks, e.g. the leaders of nodes
+    int comm_size, comm_rank;
+    MPI_Comm_size(comm, &comm_size);
+    MPI_Comm_rank(comm, &comm_rank);
+    MPI_Request recv_req;
+    TIndex segment_size = count / comm_size;
+    TIndex residual = count % comm_size;
+    vector<TIndex> segment_sizes(comm_size, segment_size);
+    for (int i = 0; i < residual; i++) segment_sizes[i]++;
+    vector<TIndex> segment_ends(comm_size);
+    segment_ends[0] = segment_sizes[0];
+    for (int i = 1; i < segment_ends.size(); i++) 
+        segment_ends[i] = segment_sizes[i] + segment_ends[i - 1];
+    int recv_from = (comm_rank - 1 + comm_size) % comm_size;
+    int send_to = (comm_rank + 1) % comm_size;
+
+    //  scatter-reduce
+    for (int i = 0; i < comm_size - 1; i++) {
+        int recv_chunk = (comm_rank - i - 1 + comm_size) % comm_size;
+        int send_chunk = (comm_rank - i + comm_size) % comm_size;
+        auto* segment_send = &(x[segment_ends[send_chunk] - 
+                                 segment_sizes[send_chunk]]);
+        MPI_Irecv(buffer, segment_sizes[recv_chunk], 
+                                           MPI_FLOAT, 
+                                        recv_from, 0, 
+                                    comm, &recv_req);
+        MPI_Send(segment_send, segment_sizes[send_chunk],
+                                              MPI_FLOAT, 
+                                             send_to, 0, 
+                                                  comm);
+        auto* segment_update = &(x[segment_ends[recv_chunk] - 
+                                   segment_sizes[recv_chunk]]);
+        MPI_Wait(&recv_req, MPI_STATUS_IGNORE);
+#ifdef WITH_MPI_CUDA
+        math::Axpy<float, Context>(segment_sizes[recv_chunk],
+                                                         1.0, 
+                                                      buffer, 
+                                             segment_update);
+        cudaStreamSynchronize(cudaStreamDefault);
+#else 
+        math::Axpy<float, CPUContext>(segment_sizes[recv_chunk], 
+                                                            1.0, 
+                                                         buffer, 
+                                                segment_update);
+#endif // WITH_MPI_CUDA
+    }
+
+    //  allgather
+    for (int i = 0; i < comm_size - 1; i++) {
+        int send_chunk = (comm_rank - i + 1 + comm_size) % comm_size;
+        int recv_chunk = (comm_rank - i + comm_size) % comm_size;
+        auto* segment_send = &(x[segment_ends[send_chunk] - 
+                                 segment_sizes[send_chunk]]);
+        auto* segment_recv = &(x[segment_ends[recv_chunk] -
+                                 segment_sizes[recv_chunk]]);
+        MPI_Sendrecv(segment_send, segment_sizes[send_chunk],
+                                                   MPI_FLOAT, 
+                                                  send_to, 0, 
+                     segment_recv, segment_sizes[recv_chunk], 
+                                                   MPI_FLOAT, 
+                                                recv_from, 0, 
+                                    comm, MPI_STATUS_IGNORE);
+    }
+}
+
+static void EncodeHalf(const TIndex count, const float* x, float16* y) {
+#ifdef WITH_OMP
+    #pragma omp parallel for num_threads(GET_OMP_THREADS(count))
+#endif
+    for (TIndex i = 0; i < count; ++i) y[i] = dragon_cast<float16, float>(x[i]);
+}
+
+static void DecodeHalf(const TIndex count, const float16* x, float* y, bool accumulate) {
+#ifdef WITH_OMP
+    #pragma omp parallel for num_threads(GET_OMP_THREADS(count))
+#endif
+    for (TIndex i = 0; i < count; ++i) {
+        const float v = dragon_cast<float, float16>(x[i]);
+        y[i] = accumulate ? y[i] + v : v;
+    }
+}
+
+template <class Context>
+void CollectiveUpdateOp<Context>::MPIAllReduceHalf(const TIndex count,
+                                                   MPI_Comm comm,
+                                                   float* x) {
+    int comm_size, comm_rank;
+    MPI_Comm_size(comm, &comm_size);
+    MPI_Comm_rank(comm, &comm_rank);
+    TIndex segment_size = count / comm_size;
+    TIndex residual = count % comm_size;
+    vector<TIndex> segment_sizes(comm_size, segment_size);
+    for (int i = 0; i < residual; i++) segment_sizes[i]++;
+    vector<TIndex> segment_starts(comm_size, 0);
+    for (int i = 1; i < comm_size; i++)
+        segment_starts[i] = segment_starts[i - 1] + segment_sizes[i - 1];
+    int recv_from = (comm_rank - 1 + comm_size) % comm_size;
+    int send_to = (comm_rank + 1) % comm_size;
+
+    if (!half_buffer) half_buffer = ws()->CreateTensor("/mnt/" + name() + "/half_buffer");
+    half_buffer->Reshape(vector<TIndex>(1, 2 * segment_sizes[0]));
+    auto* send_buffer = half_buffer->mutable_data<float16, CPUContext>();
+    auto* recv_buffer = send_buffer + segment_sizes[0];
+
+    //  average before casting, the sums are bounded by the max
+    math::Scal<float, CPUContext>(count, float(1.0 / comm_size), x);
+
+    //  scatter-reduce, accumulate in fp32
+    for (int i = 0; i < comm_size - 1; i++) {
+        int recv_chunk = (comm_rank - i - 1 + comm_size) % comm_size;
+        int send_chunk = (comm_rank - i + comm_size) % comm_size;
+        MPI_Request recv_req;
+        MPI_Irecv(recv_buffer, segment_sizes[recv_chunk], MPI_UNSIGNED_SHORT,
+                                            recv_from, 0, comm, &recv_req);
+        EncodeHalf(segment_sizes[send_chunk], x + segment_starts[send_chunk], send_buffer);
+        MPI_Send(send_buffer, segment_sizes[send_chunk], MPI_UNSIGNED_SHORT,
+                                                        send_to, 0, comm);
+        MPI_Wait(&recv_req, MPI_STATUS_IGNORE);
+        DecodeHalf(segment_sizes[recv_chunk], recv_buffer,
+                   x + segment_starts[recv_chunk], true);
+    }
+
+    //  round the reduced chunk as the others will receive it
+    int owned_chunk = (comm_rank + 1) % comm_size;
+    EncodeHalf(segment_sizes[owned_chunk], x + segment_starts[owned_chunk], send_buffer);
+    DecodeHalf(segment_sizes[owned_chunk], send_buffer, x + segment_starts[owned_chunk], false);
+
+    //  allgather
+    for (int i = 0; i < comm_size - 1; i++) {
+        int send_chunk = (comm_rank - i + 1 + comm_size) % comm_size;
+        int recv_chunk = (comm_rank - i + comm_size) % comm_size;
+        EncodeHalf(segment_sizes[send_chunk], x + segment_starts[send_chunk], send_buffer);
+        MPI_Sendrecv(send_buffer, segment_sizes[send_chunk], MPI_UNSIGNED_SHORT,
+                                                                 send_to, 0,
+                     recv_buffer, segment_sizes[recv_chunk], MPI_UNSIGNED_SHORT,
+                                               recv_from, 0, comm, MPI_STATUS_IGNORE);
+        DecodeHalf(segment_sizes[recv_chunk], recv_buffer,
+                   x + segment_starts[recv_chunk], false);
+    }
+
+    //  the callers expect the sum
+    math::Scal<float, CPUContext>(count, float(comm_size), x);
+}
+
+template <class Context>
+void CollectiveUpdateOp<Context>::TopKAllReduce(const int idx, float* buffer) {
+    struct Pair { int index; float value; };
+    Tensor& dX = Input(idx);
+    const TIndex count = dX.count();
+    const TIndex k = std::max(TIndex(1), TIndex(count * topk_ratio));
+    auto* dXdata = dX.template mutable_data<float, CPUContext>();
+
+    //  the error feedback, i.e. the gradients not sent yet
+    Tensor* residual = ws()->CreateTensor("/mnt/" + name() + "/" + dX.name() + "/residual");
+    if (residual->count() != count) {
+        residual->ReshapeLike(dX);
+        math::Set<float, CPUContext>(count, 0.f,
+            residual->template mutable_data<float, CPUContext>());
+    }
+    auto* Rdata = residual->template mutable_data<float, CPUContext>();
+    math::Add<float, CPUContext>(count, dXdata, Rdata, Rdata);
+
+    //  a pair costs two values, the dense ring is cheaper
+    if (2 * k >= count) {
+        CPUContext::Copy<float, CPUContext, CPUContext>(count, dXdata, Rdata);
+        math::Set<float, CPUContext>(count, 0.f, Rdata);
+        AllReduce(count, comm, dXdata, buffer);
+        return;
+    }
+
+    //  the k-th largest magnitude
+    topk_scratch.resize(count);
+    for (TIndex i = 0; i < count; ++i) topk_scratch[i] = std::abs(Rdata[i]);
+    std::nth_element(topk_scratch.begin(), topk_scratch.begin() + (k - 1),
+                     topk_scratch.end(), std::greater<float>());
+    const float thresh = topk_scratch[k - 1];
+
+    //  the ties of the threshold are taken in order
+    vector<Pair> send_pairs(k), recv_pairs(k * comm_size);
+    TIndex num_selected = 0;
+    for (TIndex i = 0; i < count && num_selected < k; ++i)
+        if (std::abs(Rdata[i]) > thresh) send_pairs[num_selected++] = { (int)i, Rdata[i] };
+    for (TIndex i = 0; i < count && num_selected < k; ++i)
+        if (std::abs(Rdata[i]) == thresh) send_pairs[num_selected++] = { (int)i, Rdata[i] };
+    for (auto& pair : send_pairs) Rdata[pair.index] = 0.f;
+
+    MPI_Allgather(send_pairs.data(), int(k * sizeof(Pair)), MPI_BYTE,
+                  recv_pairs.data(), int(k * sizeof(Pair)), MPI_BYTE, comm);
+    math::Set<float, CPUContext>(count, 0.f, dXdata);
+    for (auto& pair : recv_pairs) dXdata[pair.index] += pair.value;
+}
+
+template <class Context>
+void CollectiveUpdateOp<Context>::RingAllReduce(const TIndex count,
+                                                MPI_Comm comm,
+                                                float* x,
+                                                float* buffer) {
+    if (compression == "FP16") MPIAllReduceHalf(count, comm, x);
+    else MPIAllReduce(count, comm, x, buffer);
+}
+
+template <class Context>
+void CollectiveUpdateOp<Context>::MixedAllReduce(const TIndex count,
+                                                 float* x,
+                                                 float* buffer) {
+    //  reduce to the leader, ring over the leaders, and broadcast back
+    if (local_size > 1) {
+        if (local_rank == 0) MPI_Reduce(MPI_IN_PLACE, x, count,
+                                        MPI_FLOAT, MPI_SUM, 0, local_comm);
+        else MPI_Reduce(x, x, count, MPI_FLOAT, MPI_SUM, 0, local_comm);
+    }
+    if (cross_comm != MPI_COMM_NULL && ring_size > 1)
+        RingAllReduce(count, cross_comm, x, buffer);
+    if (local_size > 1) MPI_Bcast(x, count, MPI_FLOAT, 0, local_comm);
+}
+
+template <class Context>
+void CollectiveUpdateOp<Context>::AllReduce(const TIndex count,
+                                            MPI_Comm comm,
+                                            float* x,
+                                            float* buffer) {
+    if (mode == "MIXED_ALLREDUCE") MixedAllReduce(count, x, buffer);
+    else RingAllReduce(count, comm, x, buffer);
+}
+
 template <class Context>
 void CollectiveUpdateOp<Context>::MPIAllReduceWithFloat() {
     buffer = ws()->GetBuffer();
     for (int j = 0; j < InputSize(); j++) {
         TIndex count = Input(j).count();
-        MPI_Request recv_req;
-        TIndex segment_size = count / comm_size;
-        TIndex residual = count % comm_size;
-        vector<TIndex> segment_sizes(comm_size, segment_size);
-        for (int i = 0; i < residual; i++) segment_sizes[i]++;
-        vector<TIndex> segment_ends(comm_size);
-        segment_ends[0] = segment_sizes[0];
-        for (int i = 1; i < segment_ends.size(); i++) 
-            segment_ends[i] = segment_sizes[i] + segment_ends[i - 1];
-        buffer->Reshape(vector<TIndex>(1, segment_sizes[0]));
+        buffer->Reshape(vector<TIndex>(1, (count + ring_size - 1) / ring_size));
 #ifdef WITH_MPI_CUDA
         auto* Bdata = buffer->mutable_data<float, Context>();
         auto* dXdata = Input(j).template mutable_data<float, Context>();
@@ -58,56 +333,8 @@ void CollectiveUpdateOp<Context>::MPIAllReduceWithFloat() {
         auto* Bdata = buffer->mutable_data<float, CPUContext>();
         auto* dXdata = Input(j).template mutable_data<float, CPUContext>();
 #endif // WITH_MPI_CUDA
-        int recv_from = (comm_rank - 1 + comm_size) % comm_size;
-        int send_to = (comm_rank + 1) % comm_size;
-
-        //  scatter-reduce
-        for (int i = 0; i < comm_size - 1; i++) {
-            int recv_chunk = (comm_rank - i - 1 + comm_size) % comm_size;
-            int send_chunk = (comm_rank - i + comm_size) % comm_size;
-            auto* segment_send = &(dXdata[segment_ends[send_chunk] - 
-                                        segment_sizes[send_chunk]]);
-            MPI_Irecv(Bdata, segment_sizes[recv_chunk], 
-                                             MPI_FLOAT, 
-                                          recv_from, 0, 
-                                      comm, &recv_req);
-            MPI_Send(segment_send, segment_sizes[send_chunk],
-                                                  MPI_FLOAT, 
-                                                 send_to, 0, 
-                                                      comm);
-            auto* segment_update = &(dXdata[segment_ends[recv_chunk] - 
-                                        segment_sizes[recv_chunk]]);
-            MPI_Wait(&recv_req, MPI_STATUS_IGNORE);
-#ifdef WITH_MPI_CUDA
-            math::Axpy<float, Context>(segment_sizes[recv_chunk],
-                                                             1.0, 
-                                                           Bdata, 
-                                                 segment_update);
-            cudaStreamSynchronize(cudaStreamDefault);
-#else 
-            math::Axpy<float, CPUContext>(segment_sizes[recv_chunk], 
-                                                                1.0, 
-                                                              Bdata, 
-                                                    segment_update);
-#endif // WITH_MPI_CUDA
-        }
-
-        //  allgather
-        for (int i = 0; i < comm_size - 1; i++) {
-            int send_chunk = (comm_rank - i + 1 + comm_size) % comm_size;
-            int recv_chunk = (comm_rank - i + comm_size) % comm_size;
-            auto* segment_send = &(dXdata[segment_ends[send_chunk] - 
-                                        segment_sizes[send_chunk]]);
-            auto* segment_recv = &(dXdata[segment_ends[recv_chunk] -
-                                        segment_sizes[recv_chunk]]);
-            MPI_Sendrecv(segment_send, segment_sizes[send_chunk],
-                                                       MPI_FLOAT, 
-                                                      send_to, 0, 
-                         segment_recv, segment_sizes[recv_chunk], 
-                                                       MPI_FLOAT, 
-                                                    recv_from, 0, 
-                                        comm, MPI_STATUS_IGNORE);
-        }
+        if (compression == "TOPK") TopKAllReduce(j, Bdata);
+        else AllReduce(count, comm, dXdata, Bdata);
 
         //  normalization
         if (comm_size > 1) {
@@ -121,6 +348,151 @@ void CollectiveUpdateOp<Context>::MPIAllReduceWithFloat() {
     ws()->ReleaseBuffer(buffer);
 }
 
+template <class Context>
+void CollectiveUpdateOp<Context>::MakeBuckets() {
+    //  the last inputs are produced first by the backward
+    bucket_of.assign(InputSize(), -1);
+    TIndex bytes = 0, max_count = 0;
+    for (int i = InputSize() - 1; i >= 0; i--) {
+        const TIndex size = Input(i).count() * sizeof(float);
+        if (buckets.empty() || (bytes > 0 && bytes + size > bucket_size)) {
+            buckets.push_back(vector<int>());
+            bytes = 0;
+        }
+        buckets.back().push_back(i);
+        bucket_of[i] = (int)buckets.size() - 1;
+        bytes += size;
+    }
+    //  a single tensor is reduced in place, the others are packed
+    for (int idx = 0; idx < buckets.size(); idx++) {
+        TIndex count = 0;
+        for (auto i : buckets[idx]) count += Input(i).count();
+        max_count = std::max(max_count, count);
+        Tensor* packed = nullptr;
+        if (buckets[idx].size() > 1) {
+            packed = ws()->CreateTensor("/mnt/" + name() + "/bucket_" +
+                                        dragon_cast<string, int>(idx));
+            packed->Reshape(vector<TIndex>(1, count));
+            packed->mutable_data<float, CPUContext>();
+        }
+        bucket_buffers.push_back(packed);
+    }
+    buffer = ws()->CreateTensor("/mnt/" + name() + "/ring_buffer");
+    buffer->Reshape(vector<TIndex>(1, (max_count + ring_size - 1) / ring_size));
+    buffer->mutable_data<float, CPUContext>();
+    //  the halves are sent by the communication thread,
+    //  which should not create the tensors
+    if (compression == "FP16") {
+        half_buffer = ws()->CreateTensor("/mnt/" + name() + "/half_buffer");
+        half_buffer->Reshape(vector<TIndex>(1, 2 * ((max_count + ring_size - 1) / ring_size)));
+        half_buffer->mutable_data<float16, CPUContext>();
+    }
+    num_ready.assign(buckets.size(), 0);
+    num_pending.assign(buckets.size(), 0);
+    reduced.assign(buckets.size(), false);
+    input_ready.assign(InputSize(), false);
+}
+
+template <class Context>
+void CollectiveUpdateOp<Context>::ReduceBucket(const int idx) {
+    if (comm_size == 1) return;
+    const float scale = float(1.0 / comm_size);
+    auto* Bdata = buffer->mutable_data<float, CPUContext>();
+    if (!bucket_buffers[idx]) {
+        Tensor& dX = Input(buckets[idx][0]);
+        auto* dXdata = dX.mutable_data<float, CPUContext>();
+        AllReduce(dX.count(), bucket_comm, dXdata, Bdata);
+        math::Scal<float, CPUContext>(dX.count(), scale, dXdata);
+        return;
+    }
+    auto* Pdata = bucket_buffers[idx]->mutable_data<float, CPUContext>();
+    TIndex offset = 0;
+    for (auto i : buckets[idx]) {
+        auto* dXdata = Input(i).template data<float, CPUContext>();
+        CPUContext::Copy<float, CPUContext, CPUContext>(Input(i).count(),
+                                                        Pdata + offset,
+                                                        dXdata);
+        offset += Input(i).count();
+    }
+    AllReduce(offset, bucket_comm, Pdata, Bdata);
+    offset = 0;
+    for (auto i : buckets[idx]) {
+        auto* dXdata = Input(i).template mutable_data<float, CPUContext>();
+        math::Scale<float, CPUContext>(Input(i).count(), scale, Pdata + offset, dXdata);
+        offset += Input(i).count();
+    }
+}
+
+template <class Context>
+void CollectiveUpdateOp<Context>::EnqueueBucket(const int idx) {
+    //  called with comm_mutex held
+    for (auto i : buckets[idx]) input_ready[i] = false;
+    num_ready[idx] = 0;
+    num_pending[idx]++;
+    reduced[idx] = true;
+    comm_queue.push_back(idx);
+    comm_cond.notify_all();
+}
+
+template <class Context>
+void CollectiveUpdateOp<Context>::GradientHook(const int idx, bool ready) {
+    std::unique_lock<std::mutex> lock(comm_mutex);
+    //  the buckets are made at the first run
+    if (bucket_of.empty()) return;
+    const int bucket = bucket_of[idx];
+    if (!ready) {
+        //  written again, e.g. the accumulation of gradients,
+        //  wait until the reduction in flight has finished
+        comm_cond.wait(lock, [this, bucket] { return num_pending[bucket] == 0; });
+        return;
+    }
+    reduced[bucket] = false;
+    if (!input_ready[idx]) {
+        input_ready[idx] = true;
+        num_ready[bucket]++;
+    }
+    if (num_ready[bucket] == buckets[bucket].size()) EnqueueBucket(bucket);
+}
+
+template <class Context>
+void CollectiveUpdateOp<Context>::CommunicationLoop() {
+    while (true) {
+        int idx;
+        {
+            std::unique_lock<std::mutex> lock(comm_mutex);
+            comm_cond.wait(lock, [this] { return comm_stop || !comm_queue.empty(); });
+            if (comm_queue.empty()) return;
+            idx = comm_queue.front();
+        }
+        ReduceBucket(idx);
+        {
+            std::lock_guard<std::mutex> lock(comm_mutex);
+            comm_queue.pop_front();
+            num_pending[idx]--;
+        }
+        comm_cond.notify_all();
+    }
+}
+
+template <class Context>
+void CollectiveUpdateOp<Context>::BucketAllReduceWithFloat() {
+    if (!overlap) {
+        if (buckets.empty()) MakeBuckets();
+        for (int idx = 0; idx < buckets.size(); idx++) ReduceBucket(idx);
+        return;
+    }
+    std::unique_lock<std::mutex> lock(comm_mutex);
+    if (buckets.empty()) MakeBuckets();
+    //  reduce the buckets not fired by the hooks
+    for (int idx = 0; idx < buckets.size(); idx++)
+        if (!reduced[idx]) EnqueueBucket(idx);
+    comm_cond.wait(lock, [this] { return comm_queue.empty(); });
+    //  the next iteration starts over
+    reduced.assign(buckets.size(), false);
+    num_ready.assign(buckets.size(), 0);
+    input_ready.assign(InputSize(), false);
+}
+
 template <class Context>
 void CollectiveUpdateOp<Context>::NCCLAllReduceWithFloat() {
 #ifdef WITH_MPI_NCCL
@@ -176,8 +548,9 @@ void CollectiveUpdateOp<Context>::NCCLBcastWithFloat() {
 template <class Context>
 void CollectiveUpdateOp<Context>::RunOnDevice() {
     if (Input(0).template IsType<float>()) {
-        if (mode == "MPI_ALLREDUCE") {
-            MPIAllReduceWithFloat();
+        if (mode == "MPI_ALLREDUCE" || mode == "MIXED_ALLREDUCE") {
+            if (use_buckets) BucketAllReduceWithFloat();
+            else MPIAllReduceWithFloat();
         } else if (mode == "NCCL_ALLREDUCE") {
             NCCLAllReduceWithFloat();
         } else if (mode == "MPI_BCAST") {
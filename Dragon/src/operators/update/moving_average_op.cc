@@ -23,7 +23,7 @@ DEPLOY_CPU(MovingAverage);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(MovingAverage);
 #endif
-OPERATOR_SCHEMA(MovingAverage).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(MovingAverage).NumInputs(1).NumOutputs(1).IdenticalShape();
 
 NO_GRADIENT(MovingAverage);
 
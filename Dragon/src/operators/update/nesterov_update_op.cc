@@ -1,33 +1,37 @@
 #include "operators/update/nesterov_update_op.h"
 #include "core/workspace.h"
-#include "utils/math_functions.h"
 #include "utils/op_kernel.h"
 
 namespace dragon {
 
 template <class Context>
-void NesterovUpdateOp<Context>::ComputeRunWithFloat() {
-    h = ws()->CreateTensor("/mnt/" + Slot() + "/nesterov/h");
-    tmp = ws()->CreateTensor("/mnt/" + Slot() + "/nesterov/tmp");
-    h->ReshapeLike(Input(0));
+void NesterovUpdateOp<Context>::SetupRunWithFloat() {
+    lr = Param("base_lr");
+}
+
+template <class Context>
+void NesterovUpdateOp<Context>::ComputeRunWithFloat(const int idx) {
+    h = ws()->CreateTensor("/mnt/" + Slot(idx) + "/nesterov/h");
+    h->ReshapeLike(Input(idx));
 
-    lr = Param("base_lr") * this->lr_mult;
-    auto* dXdata = Input(0).template mutable_data<float, Context>();
+    auto* dXdata = Input(idx).template mutable_data<float, Context>();
+    auto* Xdata = Output(idx)->template mutable_data<float, Context>();
     auto* Hdata = h->template mutable_data<float, Context>();
-    kernel::NesterovUpdate<float, Context>(Input(0).count(),
-                                                     dXdata,
-                                                      Hdata,
-                                                        tmp,
-                                                   momentum,
-                                                         lr,
-                                                    &ctx());
+    kernel::NesterovUpdate<float, Context>(Input(idx).count(),
+                                              lr * lr_mults[idx],
+                                                        momentum,
+                                                      grad_scale,
+                                                      grad_decay,
+                                                           Xdata,
+                                                          dXdata,
+                                                          Hdata);
 }
 
 DEPLOY_CPU(NesterovUpdate);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(NesterovUpdate);
 #endif
-OPERATOR_SCHEMA(NesterovUpdate).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(NesterovUpdate).NumInputs(1, INT_MAX).NumOutputs(1, INT_MAX);
 
 NO_GRADIENT(NesterovUpdate);
 
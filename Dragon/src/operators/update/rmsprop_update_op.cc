@@ -5,28 +5,34 @@
 namespace dragon {
 
 template <class Context>
-void RMSPropUpdateOp<Context>::ComputeRunWithFloat() {
-    h = ws()->CreateTensor("/mnt/" + Slot() + "/rmsprop/h");
-    tmp = ws()->CreateTensor("/mnt/" + Slot() + "/rmsprop/tmp");
-    h->ReshapeLike(Input(0));
+void RMSPropUpdateOp<Context>::SetupRunWithFloat() {
+    lr = Param("base_lr");
+}
+
+template <class Context>
+void RMSPropUpdateOp<Context>::ComputeRunWithFloat(const int idx) {
+    h = ws()->CreateTensor("/mnt/" + Slot(idx) + "/rmsprop/h");
+    h->ReshapeLike(Input(idx));
 
-    lr = Param("base_lr") * this->lr_mult;
-    auto* dXdata = Input(0).template mutable_data<float, Context>();
+    auto* dXdata = Input(idx).template mutable_data<float, Context>();
+    auto* Xdata = Output(idx)->template mutable_data<float, Context>();
     auto* Hdata = h->template mutable_data<float, Context>();
-    kernel::RMSPropUpdate<float, Context>(Input(0).count(),
-                                                    dXdata,
-                                                     Hdata,
-                                                       tmp,
-                                                     decay,
-                                                       eps,
-                                                       lr);
+    kernel::RMSPropUpdate<float, Context>(Input(idx).count(),
+                                             lr * lr_mults[idx],
+                                                          decay,
+                                                            eps,
+                                                     grad_scale,
+                                                     grad_decay,
+                                                          Xdata,
+                                                         dXdata,
+                                                         Hdata);
 }
 
 DEPLOY_CPU(RMSPropUpdate);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(RMSPropUpdate);
 #endif
-OPERATOR_SCHEMA(RMSPropUpdate).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(RMSPropUpdate).NumInputs(1, INT_MAX).NumOutputs(1, INT_MAX);
 
 NO_GRADIENT(RMSPropUpdate);
     
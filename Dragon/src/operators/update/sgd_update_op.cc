@@ -1,26 +1,37 @@
 #include "operators/update/sgd_update_op.h"
 #include "core/workspace.h"
-#include "utils/math_functions.h"
+#include "utils/op_kernel.h"
 
 namespace dragon {
 
 template <class Context>
-void SGDUpdateOp<Context>::ComputeRunWithFloat() {
-    h = ws()->CreateTensor("/mnt/" + Slot() + "/sgd/h");
-    h->ReshapeLike(Input(0));
+void SGDUpdateOp<Context>::SetupRunWithFloat() {
+    lr = Param("base_lr");
+}
+
+template <class Context>
+void SGDUpdateOp<Context>::ComputeRunWithFloat(const int idx) {
+    h = ws()->CreateTensor("/mnt/" + Slot(idx) + "/sgd/h");
+    h->ReshapeLike(Input(idx));
 
-    lr = Param("base_lr") * this->lr_mult;
-    auto* dXdata = Input(0).template mutable_data<float, Context>();
+    auto* dXdata = Input(idx).template mutable_data<float, Context>();
+    auto* Xdata = Output(idx)->template mutable_data<float, Context>();
     auto* Hdata = h->template mutable_data<float, Context>();
-    math::Axpby<float, Context>(h->count(), lr, dXdata, momentum, Hdata);
-    ctx().template Copy<float, Context, Context>(h->count(), dXdata, Hdata);
+    kernel::SGDUpdate<float, Context>(Input(idx).count(),
+                                         lr * lr_mults[idx],
+                                                   momentum,
+                                                 grad_scale,
+                                                 grad_decay,
+                                                      Xdata,
+                                                     dXdata,
+                                                     Hdata);
 }
 
 DEPLOY_CPU(SGDUpdate);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(SGDUpdate);
 #endif
-OPERATOR_SCHEMA(SGDUpdate).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(SGDUpdate).NumInputs(1, INT_MAX).NumOutputs(1, INT_MAX);
 
 NO_GRADIENT(SGDUpdate);
 
@@ -0,0 +1,44 @@
+#include "operators/update/shm_collective_update_op.h"
+
+namespace dragon {
+
+#ifdef WITH_SHM
+
+template <class Context>
+void SHMCollectiveUpdateOp<Context>::InitSHM() {
+    //  the ranks attach at the first run, with the same gradients
+    TIndex count = 0;
+    for (int i = 0; i < InputSize(); i++) count += Input(i).count();
+    count = std::max(std::min(count, (TIndex)SHM_MAX_SLOT_COUNT), (TIndex)16);
+    comm.reset(new SHMComm(key, comm_rank, comm_size, count));
+}
+
+template <class Context>
+void SHMCollectiveUpdateOp<Context>::RunOnDevice() {
+    CHECK(Input(0).template IsType<float>()) << "Unsupported input types.";
+    if (!comm) InitSHM();
+    //  the device gradients are staged on the host
+    vector<float*> x;
+    vector<TIndex> counts;
+    for (int i = 0; i < InputSize(); i++) {
+        x.push_back(Input(i).template mutable_data<float, CPUContext>());
+        counts.push_back(Input(i).count());
+    }
+    if (mode == "SHM_ALLREDUCE") {
+        comm->AllReduce(x, counts, float(1.0 / comm_size));
+    } else if (mode == "SHM_BCAST") {
+        comm->Bcast(x, counts, comm_root);
+    } else {
+        LOG(FATAL) << "Unsupported collective types.";
+    }
+}
+
+DEPLOY_CPU(SHMCollectiveUpdate);
+#ifdef WITH_CUDA
+DEPLOY_CUDA(SHMCollectiveUpdate);
+#endif
+OPERATOR_SCHEMA(SHMCollectiveUpdate).IgnoreVerify();
+
+#endif    // WITH_SHM
+
+}    // namespace dragon
@@ -11,61 +11,46 @@ float UpdateOpBase<Context>::Param(const string& name) const {
 }
 
 template <class Context>
-string UpdateOpBase<Context>::Slot() {
-    const string slot = OperatorBase::GetSingleArg<string>("slot", "");
-    return slot.empty() ? name() : slot;
+string UpdateOpBase<Context>::Slot(const int idx) {
+    return slots[idx].empty() ? name() : slots[idx];
 }
 
 template <class Context> template <typename T>
-void UpdateOpBase<Context>::PreprocessRunWithType() {
+void UpdateOpBase<Context>::PreprocessRunWithType(const int idx) {
     //  scale
-    scale_factor = Param("scale_gradient");
-    if (scale_factor != 1) {
-        auto* dXdata = Input(0).template mutable_data<T, Context>();
-        math::Scal<T, Context>(Input(0).count(), scale_factor, dXdata);
-    }
-    //  clip
-    clip_thresh = Param("clip_gradient");
+    grad_scale = scale_factor;
+    //  clip, only the norm is computed here
     if (clip_thresh > 0) {
-        auto* dXdata = Input(0).template mutable_data<T, Context>();
-        T sumsq_grad = math::Dot<T, Context>(Input(0).count(), dXdata, dXdata);
-        const T l2norm = sqrt(sumsq_grad);
-        if (l2norm > clip_thresh) {
-            T factor = clip_thresh / l2norm;
-            math::Scal<T, Context>(Input(0).count(), factor, dXdata);
-        }
+        auto* dXdata = Input(idx).template data<T, Context>();
+        T sumsq_grad = math::Dot<T, Context>(Input(idx).count(), dXdata, dXdata);
+        const T l2norm = std::abs(scale_factor) * sqrt(sumsq_grad);
+        if (l2norm > clip_thresh) grad_scale *= clip_thresh / l2norm;
     }
     //  decay
-    l2_decay = Param("l2_decay") * decay_mult;
-    if (l2_decay > 0) {
-        auto* dXdata = Input(0).template mutable_data<T, Context>();
-        auto* Xdata = Output(0)->template data<T, Context>();
-        math::Axpy<T, Context>(Input(0).count(), l2_decay, Xdata, dXdata);
-    }
+    grad_decay = l2_decay * decay_mults[idx];
+    if (grad_decay < 0) grad_decay = 0;
 }
 
-template <class Context> template <typename T>
-void UpdateOpBase<Context>::UpdateRunWithType() {
-    auto* dXdata = Input(0).template mutable_data<T, Context>();
-    auto* Xdata = Output(0)->template mutable_data<T, Context>();
-    math::Axpy<T, Context>(Output(0)->count(), -1.0, dXdata, Xdata);
-    math::Set<T, Context>(Input(0).count(), 0, dXdata);
-}
-
-
 template <class Context>
 void UpdateOpBase<Context>::RunOnDevice() {
-    CHECK(Input(0).dims() == Output(0)->dims())
-        << "\nTensor and its gradient must have same dims if update.";
-    if (Input(0).count() == 0 || Output(0)->count() == 0) return;
-    if (Input(0).template IsType<float>()) {
-        PreprocessRunWithType<float>();
-        ComputeRunWithFloat();
-        UpdateRunWithType<float>();
-    } else {
-        LOG(FATAL) << "Unsupported input types.";
+    CHECK_EQ(InputSize(), OutputSize())
+        << "\nExpected the same number of tensors and gradients.";
+    scale_factor = Param("scale_gradient");
+    clip_thresh = Param("clip_gradient");
+    l2_decay = Param("l2_decay");
+    SetupRunWithFloat();
+    for (int i = 0; i < InputSize(); i++) {
+        CHECK(Input(i).dims() == Output(i)->dims())
+            << "\nTensor and its gradient must have same dims if update.";
+        if (Input(i).count() == 0 || Output(i)->count() == 0) continue;
+        if (Input(i).template IsType<float>()) {
+            PreprocessRunWithType<float>(i);
+            ComputeRunWithFloat(i);
+        } else {
+            LOG(FATAL) << "Unsupported input types.";
+        }
     }
-} 
+}
 
 template class UpdateOpBase<CPUContext>;
 #ifdef WITH_CUDA
@@ -21,9 +21,21 @@ void Conv2dOp<Context>::RunWithType() {
 
     for (int n = 0; n < Input(0).dim(0); n++) {
         Wx(Xdata + n * this->x_offset, Wdata, Ydata + n * this->y_offset);
-        if (HasBias()) {
+        if (HasBias() && activation == "Relu") {
+            //  add the bias and activate in one pass
+            auto* Bdata = Input(2).template data<T, Context>();
+            const bool nchw = this->data_format == "NCHW";
+            kernel::BiasRelu<T, Context>(nchw ? 1 : this->out_spatial_dim,
+                                                         this->num_output,
+                                         nchw ? this->out_spatial_dim : 1,
+                                        Bdata, slope, Ydata + n * this->y_offset);
+        } else if (HasBias()) {
             auto* Bdata = Input(2).template data<T, Context>();
             Pb(Bdata, Ydata + n * this->y_offset);
+        } else if (activation == "Relu") {
+            kernel::Relu<T, Context>(this->y_offset,
+                Ydata + n * this->y_offset, slope,
+                        Ydata + n * this->y_offset);
         }
     }
 
@@ -43,7 +55,10 @@ DEPLOY_CPU(Conv2d);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Conv2d);
 #endif
-OPERATOR_SCHEMA(Conv2d).NumInputs(2, 3).NumOutputs(1);
+OPERATOR_SCHEMA(Conv2d).NumInputs(2, 3).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        return ConvShapeInference(def, inputs, false);
+    }, 1);
 
 template <class Context> template <typename T>
 void Conv2dGradientOp<Context>::RunWithType() {
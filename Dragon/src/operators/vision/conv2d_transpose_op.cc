@@ -46,7 +46,10 @@ DEPLOY_CPU(Conv2dTranspose);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Conv2dTranspose);
 #endif
-OPERATOR_SCHEMA(Conv2dTranspose).NumInputs(2, 3).NumOutputs(1);
+OPERATOR_SCHEMA(Conv2dTranspose).NumInputs(2, 3).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        return ConvShapeInference(def, inputs, true);
+    }, 1);
 
 template <class Context> template <typename T>
 void Conv2dTransposeGradientOp<Context>::RunWithType() {
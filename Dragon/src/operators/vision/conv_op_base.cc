@@ -4,6 +4,50 @@
 
 namespace dragon {
 
+vector<TensorProto> ConvShapeInference(const OperatorDef& def,
+                                       const vector<TensorProto>& inputs,
+                                       bool transposed) {
+    const int num_spatial_axes = 2;
+    const string data_format = GetArgument<string>(def, "data_format", "NCHW");
+    const string padding = GetArgument<string>(def, "padding", "VALID");
+    const TIndex num_output = GetArgument<int>(def, "num_output", 1);
+    const int spatial_axis = data_format == "NCHW" ? 2 : 1;
+    vector<int> ks = GetArguments<int>(def, "kernel_size");
+    vector<int> s = GetArguments<int>(def, "stride");
+    vector<int> p = GetArguments<int>(def, "pad");
+    vector<int> d = GetArguments<int>(def, "dilation");
+    vector<int> output_dims = GetArguments<int>(def, "output_shape");
+    const vector<TIndex> in_dims = TensorDims(inputs[0]);
+    CHECK_EQ((int)in_dims.size(), num_spatial_axes + 2)
+        << "\n[" << def.name() << "] ConvNd has not been implemented yet";
+    vector<TIndex> dims;
+    if (data_format == "NCHW") dims.assign({ in_dims[0], num_output });
+    else dims.assign({ in_dims[0] });
+    for (int i = 0; i < num_spatial_axes; i++) {
+        const TIndex input_dim = in_dims[spatial_axis + i];
+        const TIndex kernel_size = i < (int)ks.size() ? ks[i] : ks[0];
+        const TIndex stride = i < (int)s.size() ? s[i] : s[0];
+        const TIndex pad = i < (int)p.size() ? p[i] : p[0];
+        const TIndex dilation = i < (int)d.size() ? d[i] : d[0];
+        const TIndex dilated_kernel = dilation * (kernel_size - 1) + 1;
+        if (!transposed) {
+            if (padding != "SAME") dims.push_back((input_dim + 2 * pad - dilated_kernel) / stride + 1);
+            else dims.push_back((input_dim + stride - 1) / stride);
+        } else {
+            if (padding != "SAME") {
+                dims.push_back(stride * (input_dim - 1) + dilated_kernel - 2 * pad);
+            } else {
+                CHECK_EQ((int)output_dims.size(), num_spatial_axes + 2)
+                    << "\n[" << def.name() << "] The output shape must be specified "
+                    << "if using SAME padding algorithm.";
+                dims.push_back(output_dims[spatial_axis + i]);
+            }
+        }
+    }
+    if (data_format == "NHWC") dims.push_back(num_output);
+    return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+}
+
 template <class Context>
 void ConvOpBase<Context>::ComputeOutputShape() {
     output_shape.clear();
@@ -86,13 +86,27 @@ void CuDNNConv2dOp<Context>::RunWithType() {
                                                                          fwd_algo,
                  workspace + g * workspace_fwd_data_size, workspace_fwd_data_size,
                     CUDNNType<T>::zero, output_desc, Ydata + this->y_offset * g));
-        if (HasBias()) {
+        if (HasBias() && this->activation != "Relu") {
             auto* bias = Input(2).template data<T, Context>();
             CUDNN_CHECK(cudnnAddTensor(handle[g],
                        CUDNNType<T>::one, bias_desc, bias + this->bias_offset * g,
                      CUDNNType<T>::one, output_desc, Ydata + this->y_offset * g));
         }
     }
+    if (this->activation == "Relu") {
+        if (HasBias()) {
+            //  add the bias and activate in one pass
+            auto* bias = Input(2).template data<T, Context>();
+            const bool nchw = this->data_format == "NCHW";
+            const int spatial_dim = (int)this->out_spatial_dim;
+            kernel::BiasRelu<T, Context>(
+                nchw ? Input(0).dim(0) : Input(0).dim(0) * spatial_dim,
+                    this->num_output, nchw ? spatial_dim : 1,
+                        bias, this->slope, Ydata);
+        } else {
+            kernel::Relu<T, Context>(Output(0)->count(), Ydata, this->slope, Ydata);
+        }
+    }
     kernel::Empty<T, Context>();
     ws()->ReleaseBuffer(buffer);
 }
@@ -121,7 +121,7 @@ DEPLOY_CPU(LRN);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(LRN);
 #endif
-OPERATOR_SCHEMA(LRN).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(LRN).NumInputs(1).NumOutputs(1).IdenticalShape();
 
 template <class Context> template <typename T>
 void LRNGradientOp<Context>::AcrossRunWithType() {
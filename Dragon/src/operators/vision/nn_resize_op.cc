@@ -57,7 +57,24 @@ DEPLOY_CPU(NNResize);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(NNResize);
 #endif
-OPERATOR_SCHEMA(NNResize).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(NNResize).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const string data_format = GetArgument<string>(def, "data_format", "NCHW");
+        const int spatial_axis = data_format == "NCHW" ? 2 : 1;
+        vector<int> dsize = GetArguments<int>(def, "dsize");
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        if (dsize.size() > 0) {
+            for (int i = 0; i < 2; i++) dims[spatial_axis + i] = dsize[i];
+        } else {
+            const float fy = GetArgument<float>(def, "fy", -1.0);
+            const float fx = GetArgument<float>(def, "fx", -1.0);
+            CHECK(fy != -1.0 && fx != -1.0)
+                << "\n[" << def.name() << "] The fx and fy should be set.";
+            dims[spatial_axis] = int(dims[spatial_axis] * fy);
+            dims[spatial_axis + 1] = int(dims[spatial_axis + 1] * fx);
+        }
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void NNResizeGradientOp<Context>::RunWithType() {
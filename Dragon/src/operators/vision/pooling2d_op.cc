@@ -118,7 +118,38 @@ DEPLOY_CPU(Pooling2d);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(Pooling2d);
 #endif
-OPERATOR_SCHEMA(Pooling2d).NumInputs(1).NumOutputs(1);
+OPERATOR_SCHEMA(Pooling2d).NumInputs(1).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        const string data_format = GetArgument<string>(def, "data_format", "NCHW");
+        const string padding = GetArgument<string>(def, "padding", "VALID");
+        const bool global_pooling = GetArgument<bool>(def, "global_pooling", false);
+        const int spatial_axis = data_format == "NCHW" ? 2 : 1;
+        vector<int> ks = GetArguments<int>(def, "kernel_size");
+        vector<int> s = GetArguments<int>(def, "stride");
+        vector<int> p = GetArguments<int>(def, "pad");
+        vector<TIndex> dims = TensorDims(inputs[0]);
+        if (dims.size() != 4) return InvalidShape(def, "The input should be a 4d tensor.");
+        if (!global_pooling && (ks.empty() || s.empty() || p.empty()))
+            return InvalidShape(def, "Missing the kernel size, stride or pad.");
+        for (int i = 0; i < 2; i++) {
+            const TIndex input_size = dims[spatial_axis + i];
+            TIndex kernel_size = input_size, stride = 1, pad = 0;
+            if (!global_pooling) {
+                kernel_size = i < (int)ks.size() ? ks[i] : ks[0];
+                stride = i < (int)s.size() ? s[i] : s[0];
+                pad = i < (int)p.size() ? p[i] : p[0];
+            }
+            TIndex pool_size;
+            if (padding != "SAME") {
+                pool_size = ceil((input_size + 2 * pad - kernel_size) / (float)stride) + 1;
+                if ((pool_size - 1) * stride >= (input_size + pad)) pool_size--;
+            } else {
+                pool_size = (input_size + stride - 1) / (float)stride;
+            }
+            dims[spatial_axis + i] = pool_size;
+        }
+        return vector<TensorProto>(1, TensorShape(dims, inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void Pooling2dGradientOp<Context>::MAXRunWithType() {
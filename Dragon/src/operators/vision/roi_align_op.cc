@@ -29,7 +29,12 @@ DEPLOY_CPU(ROIAlign);
 #ifdef WITH_CUDA
 DEPLOY_CUDA(ROIAlign);
 #endif
-OPERATOR_SCHEMA(ROIAlign).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(ROIAlign).NumInputs(2).NumOutputs(1)
+    .ShapeInference([](const OperatorDef& def, const vector<TensorProto>& inputs) {
+        return vector<TensorProto>(1, TensorShape({ inputs[1].dims(0), inputs[0].dims(1),
+            GetArgument<int>(def, "pool_h", 0), GetArgument<int>(def, "pool_w", 0) },
+                inputs[0].data_type()));
+    });
 
 template <class Context> template <typename T>
 void ROIAlignGradientOp<Context>::RunWithType() {
@@ -0,0 +1,266 @@
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "utils/checkpoint.h"
+
+namespace dragon {
+
+static const Map<string, TypeMeta>& CheckpointTypes() {
+    static Map<string, TypeMeta> types{
+        { "float16", TypeMeta::Make<float16>() },
+        { "float32", TypeMeta::Make<float>() },
+        { "float64", TypeMeta::Make<double>() },
+        { "int32", TypeMeta::Make<int>() },
+        { "int64", TypeMeta::Make<int64_t>() },
+        { "uint8", TypeMeta::Make<uint8_t>() }};
+    return types;
+}
+
+static string CheckpointTypeName(const TypeMeta& meta) {
+    for (auto& it : CheckpointTypes())
+        if (it.second.id() == meta.id()) return it.first;
+    return "";
+}
+
+template <typename T>
+static void Append(string* s, const T& value) {
+    s->append((const char*)&value, sizeof(T));
+}
+
+static void Append(string* s, const string& value) {
+    Append(s, (uint32_t)value.size());
+    s->append(value);
+}
+
+//  read the fields of header, bounded by the end of header
+class HeaderReader {
+ public:
+    HeaderReader(const char* data, size_t size, const string& file)
+        : cur(data), end(data + size), file(file) {}
+
+    template <typename T> T Read() {
+        Require(sizeof(T));
+        T value;
+        memcpy(&value, cur, sizeof(T));
+        cur += sizeof(T);
+        return value;
+    }
+
+    string ReadString() {
+        uint32_t len = Read<uint32_t>();
+        Require(len);
+        string value(cur, len);
+        cur += len;
+        return value;
+    }
+
+ private:
+    void Require(size_t n) {
+        CHECK_LE(n, (size_t)(end - cur)) << "\nThe checkpoint is broken: " << file;
+    }
+
+    const char* cur, *end;
+    const string& file;
+};
+
+bool IsCheckpoint(const string& file) {
+    char magic[8];
+    std::ifstream input(file, std::ios::in | std::ios::binary);
+    if (!input.read(magic, 8)) return false;
+    return memcmp(magic, CHECKPOINT_MAGIC, 8) == 0;
+}
+
+void SaveCheckpoint(const string& file, const vector<Tensor*>& tensors) {
+    //  the header is sized before the offsets are known
+    vector<Tensor*> valid_tensors;
+    vector<string> dtypes;
+    size_t header_bytes = 8 + 4 + 4 + 8;
+    for (auto* tensor : tensors) {
+        string dtype = CheckpointTypeName(tensor->meta());
+        if (tensor->count() <= 0 || dtype.empty()) {
+            LOG(WARNING) << "Tensor(" << tensor->name() << ") "
+                         << "is empty or not numerical, skip.";
+            continue;
+        }
+        valid_tensors.push_back(tensor);
+        dtypes.push_back(dtype);
+        header_bytes += 4 + tensor->name().size() + 4 + dtype.size()
+            + 4 + 8 * tensor->ndim() + 8 + 8;
+    }
+    auto align = [](uint64_t offset) {
+        return (offset + CHECKPOINT_ALIGNMENT - 1)
+            / CHECKPOINT_ALIGNMENT * CHECKPOINT_ALIGNMENT;
+    };
+    string header(CHECKPOINT_MAGIC, 8);
+    Append(&header, (uint32_t)CHECKPOINT_VERSION);
+    Append(&header, (uint32_t)valid_tensors.size());
+    Append(&header, (uint64_t)header_bytes);
+    vector<uint64_t> offsets;
+    uint64_t offset = align(header_bytes);
+    for (int i = 0; i < valid_tensors.size(); i++) {
+        Tensor* tensor = valid_tensors[i];
+        Append(&header, tensor->name());
+        Append(&header, dtypes[i]);
+        Append(&header, (uint32_t)tensor->ndim());
+        for (auto dim : tensor->dims()) Append(&header, (int64_t)dim);
+        Append(&header, offset);
+        Append(&header, (uint64_t)tensor->nbytes());
+        offsets.push_back(offset);
+        offset = align(offset + tensor->nbytes());
+    }
+    CHECK_EQ(header.size(), header_bytes);
+
+    std::ofstream output(file, std::ios::out | std::ios::trunc | std::ios::binary);
+    CHECK(output.is_open()) << "\nFailed to open the file: " << file;
+    output.write(header.data(), header.size());
+    const char zeros[CHECKPOINT_ALIGNMENT] = { 0 };
+    uint64_t written = header.size();
+    for (int i = 0; i < valid_tensors.size(); i++) {
+        output.write(zeros, offsets[i] - written);
+        Tensor* tensor = valid_tensors[i];
+        output.write((const char*)tensor->raw_data<CPUContext>(), tensor->nbytes());
+        written = offsets[i] + tensor->nbytes();
+    }
+    output.write(zeros, offset - written);
+    CHECK(output.good()) << "\nFailed to write the file: " << file;
+    LOG(INFO) << "Save the model @: " << file << "......";
+    LOG(INFO) << "Model format: checkpoint";
+}
+
+//  map the whole file privately, the mapping is released with its last user
+static shared_ptr<void> MapCheckpoint(const string& file, size_t* size) {
+#ifndef _MSC_VER
+    int fd = open(file.c_str(), O_RDONLY);
+    CHECK_GE(fd, 0) << "\nFailed to open the file: " << file;
+    struct stat info;
+    CHECK_EQ(fstat(fd, &info), 0) << "\nFailed to stat the file: " << file;
+    *size = info.st_size;
+    void* addr = mmap(nullptr, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    CHECK(addr != MAP_FAILED) << "\nFailed to map the file: " << file;
+    const size_t nbytes = *size;
+    return shared_ptr<void>(addr, [nbytes](void* p) { munmap(p, nbytes); });
+#else
+    //  no mmap, read the file into an aligned buffer
+    std::ifstream input(file, std::ios::in | std::ios::binary | std::ios::ate);
+    CHECK(input.is_open()) << "\nFailed to open the file: " << file;
+    *size = input.tellg();
+    void* addr = CPUContext::New(*size);
+    input.seekg(0);
+    input.read((char*)addr, *size);
+    return shared_ptr<void>(addr, [](void* p) { CPUContext::Delete(p); });
+#endif
+}
+
+void LoadCheckpoint(const string& file, Workspace* ws, bool create_missing) {
+    size_t size;
+    shared_ptr<void> mapping = MapCheckpoint(file, &size);
+    char* base = (char*)mapping.get();
+    LOG(INFO) << "Restore From Model @: " << file << "......";
+    LOG(INFO) << "Model Format: checkpoint";
+
+    CHECK(size >= 24 && memcmp(base, CHECKPOINT_MAGIC, 8) == 0)
+        << "\nNot a checkpoint: " << file;
+    HeaderReader preamble(base + 8, 16, file);
+    uint32_t version = preamble.Read<uint32_t>();
+    CHECK_EQ(version, CHECKPOINT_VERSION)
+        << "\nUnsupported version of checkpoint: " << version;
+    uint32_t count = preamble.Read<uint32_t>();
+    uint64_t header_bytes = preamble.Read<uint64_t>();
+    CHECK(header_bytes >= 24 && header_bytes <= size)
+        << "\nThe checkpoint is broken: " << file;
+    HeaderReader reader(base + 24, header_bytes - 24, file);
+
+    for (int i = 0; i < count; i++) {
+        const string name = reader.ReadString();
+        const string dtype = reader.ReadString();
+        vector<TIndex> dims(reader.Read<uint32_t>());
+        for (auto& dim : dims) dim = reader.Read<int64_t>();
+        const uint64_t offset = reader.Read<uint64_t>();
+        const uint64_t nbytes = reader.Read<uint64_t>();
+        CHECK(offset + nbytes <= size && CheckpointTypes().count(dtype))
+            << "\nThe checkpoint is broken: " << file;
+        if (!ws->HasTensor(name)) {
+            if (!create_missing) {
+                LOG(WARNING) << "Tensor(" << name << ") "
+                             << "does not exist in any Graphs, skip.";
+                continue;
+            }
+            ws->CreateTensor(name);
+        }
+        Tensor* tensor = ws->GetTensor(name);
+        const TypeMeta& meta = CheckpointTypes().at(dtype);
+        tensor->Reshape(dims);
+        CHECK_EQ(tensor->count() * meta.itemsize(), nbytes)
+            << "\nTensor(" << name << ") failed to load, the size is mismatched.";
+        if (tensor->own_mem()) {
+            //  borrow the mapped pages until written
+            shared_ptr<MixedMemory> memory(new MixedMemory(meta, nbytes));
+            memory->set_cpu_data(base + offset, nbytes, mapping);
+            tensor->SetMeta(meta);
+            tensor->SetMemory(memory);
+        } else {
+            void* data = tensor->raw_mutable_data<CPUContext>(meta);
+            memcpy(data, base + offset, nbytes);
+        }
+        LOG(INFO) << "Tensor(" << name << ") "
+                  << "loaded, shape: " << tensor->dim_string()
+                  << ", size: " << tensor->count();
+    }
+}
+
+void CommitFile(const string& tmp_file, const string& file) {
+#ifndef _MSC_VER
+    int fd = open(tmp_file.c_str(), O_RDONLY);
+    CHECK_GE(fd, 0) << "\nFailed to open the file: " << tmp_file;
+    CHECK_EQ(fsync(fd), 0) << "\nFailed to flush the file: " << tmp_file;
+    close(fd);
+#else
+    //  the existing target can not be replaced by renaming
+    remove(file.c_str());
+#endif
+    CHECK_EQ(rename(tmp_file.c_str(), file.c_str()), 0)
+        << "\nFailed to rename " << tmp_file << " as " << file;
+}
+
+AsyncCheckpoint::AsyncCheckpoint(const string& file,
+                                 const vector<Tensor*>& tensors,
+                                 SaveFunction save_func)
+    : file_(file), save_func_(save_func), done_(false) {
+    for (auto* tensor : tensors) {
+        Tensor* copy = new Tensor(tensor->name());
+        copies_.emplace_back(copy);
+        if (tensor->count() <= 0) continue;
+        const TypeMeta& meta = tensor->meta();
+        const void* src = tensor->raw_data<CPUContext>();
+        copy->Reshape(tensor->dims());
+        void* dst = copy->raw_mutable_data<CPUContext>(meta);
+        if (meta.copy()) meta.copy()(src, dst, tensor->count());
+        else memcpy(dst, src, tensor->nbytes());
+    }
+    thread_ = std::thread(&AsyncCheckpoint::Run, this);
+}
+
+void AsyncCheckpoint::Run() {
+    vector<Tensor*> tensors;
+    for (auto& copy : copies_) tensors.push_back(copy.get());
+    save_func_(file_ + ".tmp", tensors);
+    CommitFile(file_ + ".tmp", file_);
+    //  release the copies as soon as possible
+    copies_.clear();
+    done_ = true;
+}
+
+void AsyncCheckpoint::Wait() {
+    if (thread_.joinable()) thread_.join();
+}
+
+}    // namespace dragon
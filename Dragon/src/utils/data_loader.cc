@@ -0,0 +1,211 @@
+#include <cmath>
+
+#include "protos/caffemodel.pb.h"
+#include "utils/data_loader.h"
+
+#ifdef WITH_OPENCV
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgcodecs/imgcodecs.hpp>
+#endif
+
+namespace dragon {
+
+DataReader::DataReader(const DataLoaderParam& param,
+                       int num_parts, int part_idx,
+                       BlockingQueue<string>* Q_out)
+    : param(param), num_parts(num_parts), part_idx(part_idx),
+      Q_out(Q_out), rng(param.random_seed + part_idx),
+      cur_idx(0), cur_chunk_idx(0) {}
+
+void DataReader::Redirect(TIndex target_idx) {
+    cur_idx = target_idx;
+    db->Seek(cur_idx);
+}
+
+void DataReader::Reset() {
+    if (param.shuffle || param.node_step) {
+        if (param.shuffle) std::shuffle(perm.begin(), perm.end(), rng);
+        cur_chunk_idx = 0;
+        start_idx = (part_idx * num_shuffle_parts + perm[cur_chunk_idx]) * chunk_size;
+        if (start_idx >= db_size) NextChunk();
+        end_idx = std::min(db_size, start_idx + chunk_size);
+    } else {
+        start_idx = 0;
+        end_idx = db_size;
+    }
+    Redirect(start_idx);
+}
+
+void DataReader::NextChunk() {
+    cur_chunk_idx++;
+    if (cur_chunk_idx >= num_shuffle_parts) { Reset(); return; }
+    start_idx = (part_idx * num_shuffle_parts + perm[cur_chunk_idx]) * chunk_size;
+    if (start_idx >= db_size) { NextChunk(); return; }
+    end_idx = std::min(db_size, start_idx + chunk_size);
+    Redirect(start_idx);
+}
+
+void DataReader::Run() {
+    db.reset(CreateDB(param.source));
+    db_size = db->size();
+    CHECK_GT(db_size, 0) << "\nThe database is empty: " << param.source;
+    //  search an optimal chunk size by the number of chunks
+    chunk_size = param.chunk_size;
+    if (chunk_size == -1) {
+        double max_chunk_size = (double)db->total_bytes()
+            / ((double)param.num_chunks * (1 << 20));
+        chunk_size = 1;
+        while (chunk_size * 2 < max_chunk_size) chunk_size *= 2;
+    }
+    num_shuffle_parts = (TIndex)std::ceil(db->total_bytes() * 1.1
+        / (double)((num_parts * chunk_size) << 20));
+    num_shuffle_parts = std::max(num_shuffle_parts, (TIndex)1);
+    chunk_size = db_size / num_shuffle_parts / num_parts + 1;
+    perm.resize(num_shuffle_parts);
+    for (TIndex i = 0; i < num_shuffle_parts; i++) perm[i] = i;
+    std::shuffle(perm.begin(), perm.end(), rng);
+
+    Reset();
+    string value;
+    while (true) {
+        db->Value(&value);
+        if (!Q_out->Push(std::move(value))) break;
+        cur_idx++;
+        db->Next();
+        if (cur_idx >= end_idx) {
+            if (param.shuffle || param.node_step) NextChunk();
+            else Reset();
+        }
+    }
+    db->Close();
+}
+
+DataTransformer::DataTransformer(const DataLoaderParam& param,
+                                 unsigned int seed,
+                                 BlockingQueue<string>* Q_in,
+                                 BlockingQueue<DataSample>* Q_out)
+    : param(param), Q_in(Q_in), Q_out(Q_out), rng(seed) {}
+
+template <typename T>
+void DataTransformer::TransformImage(const T* im,
+                                     int h, int w, int c,
+                                     DataSample* sample) {
+    //  random crop, or the center crop for testing
+    int crop_h = h, crop_w = w, h_off = 0, w_off = 0;
+    if (param.crop_size > 0) {
+        CHECK(h >= param.crop_size && w >= param.crop_size)
+            << "\nThe image (" << h << ", " << w << ") is smaller than "
+            << "the crop size " << param.crop_size << ".";
+        crop_h = crop_w = param.crop_size;
+        if (param.is_train) {
+            h_off = std::uniform_int_distribution<int>(0, h - crop_h)(rng);
+            w_off = std::uniform_int_distribution<int>(0, w - crop_w)(rng);
+        } else {
+            h_off = (h - crop_h) / 2;
+            w_off = (w - crop_w) / 2;
+        }
+    }
+    const bool mirror = param.mirror && (rng() & 1);
+    //  duplicate the gray channel if necessary
+    const int out_c = (param.force_color && c == 1) ? 3 : c;
+    const int pad = param.padding;
+    const int out_h = crop_h + 2 * pad, out_w = crop_w + 2 * pad;
+    const int num_means = (int)param.mean_values.size();
+    CHECK(num_means == 0 || num_means == 1 || num_means == out_c)
+        << "\nExcepted 1 or " << out_c << " mean values, got " << num_means << ".";
+    sample->channels = out_c;
+    sample->height = out_h;
+    sample->width = out_w;
+    sample->data.resize(out_c * out_h * out_w);
+    //  crop, mirror, pad, subtract and scale, from HWC into CHW in one pass
+    float* y = sample->data.data();
+    for (int oc = 0; oc < out_c; oc++) {
+        const int ic = c == 1 ? 0 : oc;
+        const float mean = num_means == 0 ? 0.f :
+            param.mean_values[num_means == 1 ? 0 : oc];
+        for (int oh = 0; oh < out_h; oh++) {
+            const int ih = oh - pad;
+            for (int ow = 0; ow < out_w; ow++) {
+                const int iw = ow - pad;
+                float v = (float)param.fill_value;
+                if (ih >= 0 && ih < crop_h && iw >= 0 && iw < crop_w) {
+                    const int x = w_off + (mirror ? crop_w - 1 - iw : iw);
+                    v = (float)im[((h_off + ih) * w + x) * c + ic];
+                }
+                *(y++) = (v - mean) * param.scale;
+            }
+        }
+    }
+}
+
+void DataTransformer::Transform(const string& serialized, DataSample* sample) {
+    Datum datum;
+    CHECK(datum.ParseFromString(serialized)) << "\nFailed to parse the Datum.";
+    sample->labels.assign(1, (float)datum.label());
+    const int h = datum.height(), w = datum.width(), c = datum.channels();
+    if (datum.encoded()) {
+#ifdef WITH_OPENCV
+        cv::Mat buf(1, (int)datum.data().size(), CV_8UC1, (void*)datum.data().data());
+        cv::Mat im = cv::imdecode(buf, -1);
+        CHECK(!im.empty() && im.isContinuous()) << "\nFailed to decode the Datum.";
+        TransformImage(im.ptr<uint8_t>(), im.rows, im.cols, im.channels(), sample);
+#else
+        LOG(FATAL) << "Decoding the encoded Datum requires WITH_OPENCV.";
+#endif
+    } else if (datum.data().size() > 0) {
+        CHECK_EQ((TIndex)datum.data().size(), (TIndex)h * w * c)
+            << "\nThe raw data does not match (" << h << ", " << w << ", " << c << ").";
+        TransformImage((const uint8_t*)datum.data().data(), h, w, c, sample);
+    } else {
+        CHECK_EQ((TIndex)datum.float_data_size(), (TIndex)h * w * c)
+            << "\nThe float data does not match (" << h << ", " << w << ", " << c << ").";
+        TransformImage(datum.float_data().data(), h, w, c, sample);
+    }
+}
+
+void DataTransformer::Run() {
+    string serialized;
+    while (Q_in->Pop(&serialized)) {
+        DataSample sample;
+        Transform(serialized, &sample);
+        if (!Q_out->Push(std::move(sample))) break;
+    }
+}
+
+DataLoader::DataLoader(const DataLoaderParam& param)
+    : param(param),
+      Q_level_1(param.prefetch * param.num_readers * param.batch_size),
+      Q_level_2(param.prefetch * param.num_readers * param.batch_size) {
+    //  the readers are partitioned over all the parallel nodes
+    for (int i = 0; i < this->param.num_readers; i++) {
+        int num_parts = this->param.num_readers, part_idx = i;
+        if (this->param.shuffle || this->param.node_step) {
+            num_parts *= this->param.node_size;
+            part_idx += this->param.node_rank * this->param.num_readers;
+        }
+        readers.emplace_back(new DataReader(this->param,
+            num_parts, part_idx, &Q_level_1));
+    }
+    for (int i = 0; i < this->param.num_transformers; i++) {
+        unsigned int seed = this->param.random_seed + i +
+            this->param.node_rank * this->param.num_transformers;
+        transformers.emplace_back(new DataTransformer(this->param,
+            seed, &Q_level_1, &Q_level_2));
+    }
+    for (auto& reader : readers)
+        threads.emplace_back(&DataReader::Run, reader.get());
+    for (auto& transformer : transformers)
+        threads.emplace_back(&DataTransformer::Run, transformer.get());
+}
+
+DataLoader::~DataLoader() {
+    Q_level_1.Close();
+    Q_level_2.Close();
+    for (auto& thread : threads) thread.join();
+}
+
+void DataLoader::Next(DataSample* sample) {
+    CHECK(Q_level_2.Pop(sample)) << "\nThe DataLoader has been closed.";
+}
+
+}    // namespace dragon
@@ -0,0 +1,141 @@
+#include <sys/stat.h>
+#include <cctype>
+#include <cstring>
+
+#include "utils/db.h"
+
+namespace dragon {
+
+#define RECORD_MAGIC "DRAGONRC"
+#define RECORD_MAGIC_SIZE 8
+
+void RecordDB::Open(const string& source) {
+    file.open(source, std::ios::in | std::ios::binary);
+    CHECK(file.is_open()) << "\nFailed to open the record file: " << source;
+    //  the trailer holds the count and the offsets
+    char magic[RECORD_MAGIC_SIZE];
+    uint64_t count;
+    file.seekg(0, std::ios::end);
+    total_bytes_ = file.tellg();
+    CHECK_GE(total_bytes_, 2 * RECORD_MAGIC_SIZE + 8)
+        << "\nThe record file is broken: " << source;
+    file.seekg(-(RECORD_MAGIC_SIZE + 8), std::ios::end);
+    file.read((char*)&count, 8);
+    file.read(magic, RECORD_MAGIC_SIZE);
+    CHECK(!memcmp(magic, RECORD_MAGIC, RECORD_MAGIC_SIZE))
+        << "\nThe record file is broken: " << source;
+    offsets.resize(count);
+    file.seekg(-(RECORD_MAGIC_SIZE + 8 + (TIndex)count * 8), std::ios::end);
+    file.read((char*)offsets.data(), count * 8);
+    CHECK(file.good()) << "\nThe record file is broken: " << source;
+    size_ = count;
+    Seek(0);
+}
+
+void RecordDB::Close() {
+    if (file.is_open()) file.close();
+    offsets.clear();
+}
+
+void RecordDB::Seek(TIndex index) {
+    CHECK(index >= 0 && index < size_)
+        << "\nThe index " << index << " is out of the " << size_ << " records.";
+    cursor = index;
+}
+
+void RecordDB::Next() {
+    if (++cursor >= size_) cursor = 0;
+}
+
+void RecordDB::Value(string* value) {
+    uint64_t length;
+    file.seekg(offsets[cursor]);
+    file.read((char*)&length, 8);
+    value->resize(length);
+    file.read(&(*value)[0], length);
+    CHECK(file.good()) << "\nFailed to read the record " << cursor << ".";
+}
+
+#ifdef WITH_LMDB
+
+#define MDB_CHECK(condition) \
+    do { \
+        int rc = condition; \
+        CHECK_EQ(rc, MDB_SUCCESS) << "\n" << mdb_strerror(rc); \
+    } while (0)
+
+bool LMDB::Get(const string& key, string* value) {
+    MDB_val k, v;
+    k.mv_size = key.size();
+    k.mv_data = (void*)key.data();
+    int rc = mdb_get(txn, dbi, &k, &v);
+    if (rc == MDB_NOTFOUND) return false;
+    MDB_CHECK(rc);
+    value->assign((const char*)v.mv_data, v.mv_size);
+    return true;
+}
+
+void LMDB::Open(const string& source) {
+    MDB_CHECK(mdb_env_create(&env));
+    MDB_CHECK(mdb_env_open(env, source.c_str(), MDB_RDONLY | MDB_NOLOCK, 0664));
+    MDB_CHECK(mdb_txn_begin(env, NULL, MDB_RDONLY, &txn));
+    MDB_CHECK(mdb_dbi_open(txn, NULL, 0, &dbi));
+    MDB_CHECK(mdb_cursor_open(txn, dbi, &cursor));
+    string value;
+    CHECK(Get("size", &value)) << "\nThe key <size> is missing in " << source;
+    size_ = std::stoll(value);
+    if (Get("zfill", &value)) zfill = std::stoi(value);
+    MDB_envinfo info;
+    MDB_CHECK(mdb_env_info(env, &info));
+    total_bytes_ = info.me_mapsize;
+    Seek(0);
+}
+
+void LMDB::Close() {
+    if (cursor) mdb_cursor_close(cursor);
+    if (txn) mdb_txn_abort(txn);
+    if (env) { mdb_dbi_close(env, dbi); mdb_env_close(env); }
+    cursor = nullptr; txn = nullptr; env = nullptr;
+}
+
+void LMDB::Seek(TIndex index) {
+    string key = std::to_string(index);
+    if ((int)key.size() < zfill) key.insert(0, zfill - key.size(), '0');
+    mdb_key.mv_size = key.size();
+    mdb_key.mv_data = (void*)key.data();
+    MDB_CHECK(mdb_cursor_get(cursor, &mdb_key, &mdb_value, MDB_SET_KEY));
+}
+
+void LMDB::Next() {
+    //  the "size" and "zfill" keys are sorted behind the records
+    int rc = mdb_cursor_get(cursor, &mdb_key, &mdb_value, MDB_NEXT);
+    if (rc != MDB_NOTFOUND) MDB_CHECK(rc);
+    if (rc == MDB_NOTFOUND || !isdigit(*(const char*)mdb_key.mv_data)) Seek(0);
+}
+
+void LMDB::Value(string* value) {
+    value->assign((const char*)mdb_value.mv_data, mdb_value.mv_size);
+}
+
+#endif    // WITH_LMDB
+
+DB* CreateDB(const string& source) {
+    struct stat info;
+    CHECK_EQ(stat(source.c_str(), &info), 0)
+        << "\nThe database does not exist: " << source;
+    DB* db = nullptr;
+    if (info.st_mode & S_IFDIR) {
+#ifdef WITH_LMDB
+        db = new LMDB();
+#else
+        LOG(FATAL) << "LMDB was not compiled, "
+                   << "set WITH_LMDB or convert it into a record file.";
+#endif
+    } else {
+        db = new RecordDB();
+    }
+    db->Open(source);
+    return db;
+}
+
+}    // namespace dragon
@@ -2,7 +2,7 @@
 
 #include "core/context.h"
 #include "utils/omp_alternative.h"
-#include "utils/sse_alternative.h"
+#include "utils/simd_alternative.h"
 #include "utils/math_functions.h"
 
 namespace dragon {
@@ -19,7 +19,7 @@ template <> void Set<float, CPUContext>(const int n,
         return;
     }
 #ifdef WITH_SSE
-    sse::Set<float>(n, alpha, x);
+    simd::Set<float>(n, alpha, x);
 #else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
@@ -36,7 +36,7 @@ template <> void Set<int, CPUContext>(const int n,
         return;
     }
 #ifdef WITH_SSE
-    sse::Set<int>(n, alpha, x);
+    simd::Set<int>(n, alpha, x);
 #else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
@@ -51,15 +51,26 @@ template <> void Set<float16, CPUContext>(const int n,
     LOG(FATAL) << "float16 is unsupported for CPUContext.";
 }
 
+//  the random kernels use the counter-based generator,
+//  the element i takes the word (i % 4) of the block (i / 4),
+//  which is independent of the number of threads
+
 template <> void RandomUniform<float, CPUContext>(const int n, 
                                                   const float low, 
                                                   const float high, 
                                                   float* x) {
-    std::uniform_real_distribution<float> distribution(low, high);
+    const float scale = high - low;
+    const Philox4x32 philox = philox_generator();
+    const int num_blocks = (n + 3) / 4;
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
 #endif
-    for (int i = 0; i < n; ++i) x[i] = distribution(*rand_generator());
+    for (int b = 0; b < num_blocks; ++b) {
+        uint32_t words[4];
+        philox.Generate(b, 0, words);
+        for (int i = b * 4, j = 0; j < 4 && i < n; ++i, ++j)
+            x[i] = low + scale * Philox4x32::ToUniform(words[j]);
+    }
 }
 
 template <> void RandomUniform<float16, CPUContext>(const int n, 
@@ -73,22 +84,63 @@ template <> void RandomUniform<uint32_t, CPUContext>(const int n,
                                                      const float low, 
                                                      const float high, 
                                                      uint32_t* x) {
-    std::uniform_int_distribution<uint32_t> distribution(low, high);
+    //  map a word into [low, high] by the multiply-shift,
+    //  rejecting the few words that make it biased (Lemire, 2019),
+    //  the rejections of a block retry on its own substreams
+    const uint32_t base = (uint32_t)low;
+    const uint32_t top = high >= 4294967295.f ? UINT32_MAX : (uint32_t)high;
+    const uint64_t range = (uint64_t)top - base + 1;
+    const uint32_t threshold = (uint32_t)(((uint64_t)1 << 32) % range);
+    const Philox4x32 philox = philox_generator();
+    const int num_blocks = (n + 3) / 4;
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
 #endif
-    for (int i = 0; i < n; ++i) x[i] = distribution(*rand_generator());
+    for (int b = 0; b < num_blocks; ++b) {
+        uint32_t words[4], substream = 0;
+        for (int i = b * 4, j = 4; i < n && i < b * 4 + 4; ++i) {
+            while (1) {
+                if (j == 4) { philox.Generate(b, substream++, words); j = 0; }
+                const uint64_t m = (uint64_t)words[j++] * range;
+                if ((uint32_t)m < threshold) continue;
+                x[i] = base + (uint32_t)(m >> 32);
+                break;
+            }
+        }
+    }
+}
+
+//  box-muller, each block of 4 words gives 2 pairs of normals
+static inline void PhiloxNormal(const Philox4x32& philox,
+                                const uint32_t block,
+                                const uint32_t substream,
+                                const float mu,
+                                const float sigma,
+                                float* y) {
+    uint32_t words[4];
+    philox.Generate(block, substream, words);
+    for (int j = 0; j < 4; j += 2) {
+        float r = sqrt(-2.f * log(Philox4x32::ToUniformNonZero(words[j])));
+        float theta = 6.2831853f * Philox4x32::ToUniform(words[j + 1]);
+        y[j] = mu + sigma * r * cos(theta);
+        y[j + 1] = mu + sigma * r * sin(theta);
+    }
 }
 
 template <> void RandomNormal<float, CPUContext>(const int n, 
                                                  const float mu, 
                                                  const float sigma, 
                                                  float* x) {
-    std::normal_distribution<float> distribution(mu, sigma);
+    const Philox4x32 philox = philox_generator();
+    const int num_blocks = (n + 3) / 4;
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
 #endif
-    for (int i = 0; i < n; ++i) x[i] = distribution(*rand_generator());
+    for (int b = 0; b < num_blocks; ++b) {
+        float y[4];
+        PhiloxNormal(philox, b, 0, mu, sigma, y);
+        for (int i = b * 4, j = 0; j < 4 && i < n; ++i, ++j) x[i] = y[j];
+    }
 }
 
 template <> void RandomNormal<float16, CPUContext>(const int n, 
@@ -104,14 +156,25 @@ template <> void RandomTruncatedNormal<float, CPUContext>(const int n,
                                                           const float low,
                                                           const float high,
                                                           float* x) {
-    std::normal_distribution<float> distribution(mu, sigma);
-    int cur_pos = 0; float gen_value;
-    while (1) {
-        gen_value = distribution(*rand_generator());
-        if (gen_value < low) continue;
-        if (gen_value > high) continue;
-        x[cur_pos++] = gen_value;
-        if (cur_pos >= n) break;
+    //  the rejections of a block retry on its own substreams
+    CHECK_LT(low, high) << "\nThe truncated range is empty.";
+    const Philox4x32 philox = philox_generator();
+    const int num_blocks = (n + 3) / 4;
+#ifdef WITH_OMP
+    #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
+#endif
+    for (int b = 0; b < num_blocks; ++b) {
+        float y[4];
+        uint32_t substream = 0;
+        for (int i = b * 4, j = 4; i < n && i < b * 4 + 4; ++i) {
+            while (1) {
+                if (j == 4) { PhiloxNormal(philox, b, substream++, mu, sigma, y); j = 0; }
+                float value = y[j++];
+                if (value < low || value > high) continue;
+                x[i] = value;
+                break;
+            }
+        }
     }
 }
 
@@ -127,11 +190,17 @@ template <> void RandomTruncatedNormal<float16, CPUContext>(const int n,
 template <> void RandomBernoulli<float, CPUContext>(const int n, 
                                                     const float p,
                                                     uint32_t* x) {
-    std::bernoulli_distribution distribution(p);
+    const Philox4x32 philox = philox_generator();
+    const int num_blocks = (n + 3) / 4;
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
 #endif
-    for (int i = 0; i < n; ++i) x[i] = distribution(*rand_generator());
+    for (int b = 0; b < num_blocks; ++b) {
+        uint32_t words[4];
+        philox.Generate(b, 0, words);
+        for (int i = b * 4, j = 0; j < 4 && i < n; ++i, ++j)
+            x[i] = Philox4x32::ToUniform(words[j]) < p ? 1 : 0;
+    }
 }
 
 /******************** Level-1 ********************/
@@ -141,7 +210,7 @@ template <> void Add<float, CPUContext>(const int n,
                                         const float* b,
                                         float* y) {
 #ifdef WITH_SSE
-    sse::Add<float>(n, a, b, y);
+    simd::Add<float>(n, a, b, y);
 #else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
@@ -165,7 +234,7 @@ template <> void Sub<float, CPUContext>(const int n,
                                         const float* b,
                                         float* y) {
 #ifdef WITH_SSE
-    sse::Sub<float>(n, a, b, y);
+    simd::Sub<float>(n, a, b, y);
 #else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
@@ -179,7 +248,7 @@ template <> void Mul<float, CPUContext>(const int n,
                                         const float* b,
                                         float* y) {
 #ifdef WITH_SSE
-    sse::Mul<float>(n, a, b, y);
+    simd::Mul<float>(n, a, b, y);
 #else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
@@ -200,7 +269,7 @@ template <> void Div<float, CPUContext>(const int n,
                                         const float* b,
                                         float* y) {
 #ifdef WITH_SSE
-    sse::Div<float>(n, a, b, y);
+    simd::Div<float>(n, a, b, y);
 #else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
@@ -220,45 +289,61 @@ template <> void Clip<float, CPUContext>(const int n,
                                          const float low, 
                                          const float high,
                                          float* x) {
+#ifdef WITH_SSE
+    simd::Clip<float>(n, low, high, x);
+#else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
 #endif
     for (int i = 0; i < n; ++i) {
         x[i] = std::max(low, std::min(x[i], high));
     }
+#endif  // WITH_SSE
 }
 
 template <> void Exp<float, CPUContext>(int n, 
                                         const float* x, 
                                         float* y) {
+#ifdef WITH_SSE
+    simd::Exp<float>(n, x, y);
+#else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
 #endif
     for (int i = 0; i < n; ++i) {
         y[i] = std::exp(x[i]);
     }
+#endif  // WITH_SSE
 }
 
 template <> void Log<float, CPUContext>(int n,
                                         const float* x, 
                                         float* y) {
+#ifdef WITH_SSE
+    simd::Log<float>(n, x, y);
+#else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
 #endif
     for (int i = 0; i < n; ++i) {
         y[i] = std::log(x[i]);
     }
+#endif  // WITH_SSE
 }
 
 template <> void Square<float, CPUContext>(int n,
                                            const float* x,
                                            float* y) {
+#ifdef WITH_SSE
+    simd::Square<float>(n, x, y);
+#else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
 #endif
     for (int i = 0; i < n; ++i) {
         y[i] = x[i] * x[i];
     }
+#endif  // WITH_SSE
 }
 
 template <> void Square<float16, CPUContext>(int n,
@@ -270,12 +355,16 @@ template <> void Square<float16, CPUContext>(int n,
 template <> void Sqrt<float, CPUContext>(int n,
                                          const float* x,
                                          float* y) {
+#ifdef WITH_SSE
+    simd::Sqrt<float>(n, x, y);
+#else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
 #endif
     for (int i = 0; i < n; ++i) {
         y[i] = std::sqrt(x[i]);
     }
+#endif  // WITH_SSE
 }
 
 template <> void Sqrt<float16, CPUContext>(int n,
@@ -288,12 +377,16 @@ template <> void Pow<float, CPUContext>(int n,
                                         const float alpha, 
                                         const float* x,
                                         float* y) {
+#ifdef WITH_SSE
+    simd::Pow<float>(n, alpha, x, y);
+#else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
 #endif
     for (int i = 0; i < n; ++i) {
         y[i] = std::pow(x[i], alpha);
-    }    
+    }
+#endif  // WITH_SSE
 }
 
 template <> void Pow<float16, CPUContext>(int n, 
@@ -307,12 +400,16 @@ template <> void Inv<float, CPUContext>(const int n,
                                         const float numerator,
                                         const float* x, 
                                         float* y) {
+#ifdef WITH_SSE
+    simd::Inv<float>(n, numerator, x, y);
+#else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
 #endif
     for (int i = 0; i < n; ++i) {
-        y[i] = 1.0 / y[i];
+        y[i] = numerator / x[i];
     }
+#endif  // WITH_SSE
 }
 
 template <> void Inv<float16, CPUContext>(const int n,
@@ -330,7 +427,7 @@ template <> void Scal<float, CPUContext>(const int n,
 #ifdef WITH_BLAS
     cblas_sscal(n, alpha, y, 1);
 #elif  WITH_SSE
-    sse::Scal<float>(n, alpha, y);
+    simd::Scal<float>(n, alpha, y);
 #else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
@@ -360,7 +457,7 @@ template <> void Scale<float, CPUContext>(const int n,
     cblas_scopy(n, x, 1, y, 1);
     cblas_sscal(n, alpha, y, 1);
 #elif  WITH_SSE
-    sse::Scale<float>(n, alpha, x, y);
+    simd::Scale<float>(n, alpha, x, y);
 #else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
@@ -392,7 +489,7 @@ template <> float Dot<float, CPUContext>(int n,
 #ifdef WITH_BLAS
     return StridedDot<float, CPUContext>(n, a, 1, b, 1);
 #elif  WITH_SSE
-    return sse::Dot<float>(n, a, b);
+    return simd::Dot<float>(n, a, b);
 #else
     float ret = 0.f;
 #ifdef WITH_OMP
@@ -414,13 +511,13 @@ template <> float ASum<float, CPUContext>(const int n, const float* x) {
 #ifdef WITH_BLAS
     return cblas_sasum(n, x, 1);
 #elif WITH_SSE
-    return sse::ASum<float>(n, x);
+    return simd::ASum<float>(n, x);
 #else
     float ret = 0.f;
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
 #endif
-    for (int i = 0; i < n; ++i) ret += x[i];
+    for (int i = 0; i < n; ++i) ret += std::abs(x[i]);
     return ret;
 #endif  // WITH_BLAS
 }
@@ -429,7 +526,7 @@ template <> void AddScalar<float, CPUContext>(const int n,
                                               const float alpha, 
                                               float* y) {
 #ifdef WITH_SSE
-    sse::AddScalar<float>(n, alpha, y);
+    simd::AddScalar<float>(n, alpha, y);
 #else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
@@ -448,7 +545,7 @@ template <> void MulScalar<float, CPUContext>(const int n,
                                               const float alpha,
                                               float* y) {
 #ifdef WITH_SSE
-    sse::MulScalar<float>(n, alpha, y);
+    simd::MulScalar<float>(n, alpha, y);
 #else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
@@ -470,7 +567,7 @@ template <> void Axpy<float, CPUContext>(const int n,
 #ifdef WITH_BLAS
     cblas_saxpy(n, alpha, x, 1, y, 1);
 #elif  WITH_SSE
-    sse::Axpy<float>(n, alpha, x, y);
+    simd::Axpy<float>(n, alpha, x, y);
 #else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
@@ -495,7 +592,7 @@ template <> void Axpby<float, CPUContext>(const int n,
     cblas_sscal(n, beta, y, 1);
     cblas_saxpy(n, alpha, x, 1, y, 1);
 #elif  WITH_SSE
-    sse::Axpby<float>(n, alpha, x, beta, y);
+    simd::Axpby<float>(n, alpha, x, beta, y);
 #else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(n))
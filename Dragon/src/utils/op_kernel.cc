@@ -4,7 +4,7 @@
 #include "core/tensor.h"
 #include "utils/op_kernel.h"
 #include "utils/omp_alternative.h"
-#include "utils/sse_alternative.h"
+#include "utils/simd_alternative.h"
 #include "utils/math_functions.h"
 
 bool judge(int a, int b)  { return unsigned(a) < unsigned(b); }
@@ -50,6 +50,9 @@ template<> void Elu<float, CPUContext>(const int count,
                                        const float* x,
                                        const float alpha,
                                        float* y) {
+#ifdef WITH_SSE
+    simd::Elu<float>(count, alpha, 1.f, x, y);
+#else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(count))
 #endif
@@ -57,6 +60,7 @@ template<> void Elu<float, CPUContext>(const int count,
         y[i] = std::max(x[i], float(0))
             + alpha * (std::exp(std::min(x[i], float(0))) - float(1));
     }
+#endif  // WITH_SSE
 }
 
 template<> void EluGrad<float, CPUContext>(const int count,
@@ -222,6 +226,9 @@ template<> void ReluGrad<float, CPUContext>(const int count,
 template<> void SElu<float, CPUContext>(const int count,
                                         const float* x,
                                         float* y) {
+#ifdef WITH_SSE
+    simd::Elu<float>(count, 1.7581f, 1.0507f, x, y);
+#else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(count))
 #endif
@@ -229,6 +236,7 @@ template<> void SElu<float, CPUContext>(const int count,
         y[i] = 1.0507 * std::max(x[i], float(0))
              + 1.7581 * (std::exp(std::min(x[i], float(0))) - float(1));
     }
+#endif  // WITH_SSE
 }
 
 template<> void SEluGrad<float, CPUContext>(const int count,
@@ -249,10 +257,14 @@ template <typename T>
 T _sigmoid(T x) { return T(1) / (T(1) + exp(-x)); }
 
 template<> void Sigmoid<float, CPUContext>(const int count, const float* x, float* y) {
+#ifdef WITH_SSE
+    simd::Sigmoid<float>(count, x, y);
+#else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(count))
 #endif
     for (int i = 0; i < count; ++i)  y[i] = _sigmoid<float>(x[i]);
+#endif  // WITH_SSE
 }
 
 template<> void SigmoidGrad<float, CPUContext>(const int count, 
@@ -278,6 +290,9 @@ template<> void Softmax<float, CPUContext>(const int count,
                                            float* scale, 
                                            float* y, 
                                            CPUContext* context) {
+#ifdef WITH_SSE
+    simd::Softmax<float>(outer_dim, classes, inner_dim, x, y);
+#else
     const int dim = count / outer_dim;
     for (int i = 0; i < outer_dim; ++i) {
         context->Copy<float, CPUContext, CPUContext>(inner_dim, scale, x + i*dim);
@@ -302,6 +317,7 @@ template<> void Softmax<float, CPUContext>(const int count,
             y += inner_dim;
         }
     }
+#endif  // WITH_SSE
 }
 
 template<> void SoftmaxGrad<float, CPUContext>(const int count, 
@@ -313,6 +329,9 @@ template<> void SoftmaxGrad<float, CPUContext>(const int count,
                                                const float* y, 
                                                float* scale, 
                                                float* dx) {
+#ifdef WITH_SSE
+    simd::SoftmaxGrad<float>(outer_dim, classes, inner_dim, dy, y, dx);
+#else
     const int dim = count / outer_dim;
     for (int i = 0; i < outer_dim; ++i) {
         for (int k = 0; k < inner_dim; ++k)
@@ -327,17 +346,22 @@ template<> void SoftmaxGrad<float, CPUContext>(const int count,
                                                        dx + i*dim);
     }
     math::Mul<float, CPUContext>(count, dx, y, dx);
+#endif  // WITH_SSE
 }
 
 /******************** activation.tanh ********************/
 
 template<> void Tanh<float, CPUContext>(const int count, const float* x, float* y) {
+#ifdef WITH_SSE
+    simd::Tanh<float>(count, x, y);
+#else
 #ifdef WITH_OMP
     #pragma omp parallel for num_threads(GET_OMP_THREADS(count))
 #endif
     for (int i = 0; i < count; ++i) {
         y[i] = std::tanh(x[i]);
     }
+#endif  // WITH_SSE
 }
 
 template<> void TanhGrad<float, CPUContext>(const int count, 
@@ -383,6 +407,26 @@ template<> void BiasAdd<float, CPUContext>(const int count,
     }
 }
 
+template<> void BiasRelu<float, CPUContext>(const int outer_dim,
+                                            const int dim,
+                                            const int inner_dim,
+                                            const float* bias,
+                                            const float slope,
+                                            float* y) {
+    const int rows = outer_dim * dim;
+#ifdef WITH_OMP
+    #pragma omp parallel for num_threads(GET_OMP_THREADS(rows * inner_dim))
+#endif
+    for (int row = 0; row < rows; ++row) {
+        const float b = bias[row % dim];
+        float* y_row = y + row * inner_dim;
+        for (int i = 0; i < inner_dim; ++i) {
+            const float v = y_row[i] + b;
+            y_row[i] = std::max(v, 0.f) + slope * std::min(v, 0.f);
+        }
+    }
+}
+
 /******************** arithmetic.clip ********************/
 
 template <> void Clip<float, CPUContext>(const int count,
@@ -401,6 +445,115 @@ template <> void Clip<float, CPUContext>(const int count,
     }
 }
 
+/******************** arithmetic.fused_elementwise ********************/
+
+template <typename T>
+inline T _FusedApply(const int opcode, const T a, const T b, const float* p) {
+    switch (opcode) {
+        case FUSED_ADD: return a + b;
+        case FUSED_SUB: return a - b;
+        case FUSED_MUL: return a * b;
+        case FUSED_DIV: return a / b;
+        case FUSED_RELU: return a > 0 ? a : a * p[0];
+        case FUSED_ELU: return a > 0 ? a : p[0] * (std::exp(a) - 1);
+        case FUSED_SIGMOID: return T(1) / (T(1) + std::exp(-a));
+        case FUSED_TANH: return std::tanh(a);
+        case FUSED_EXP: return std::exp(a);
+        case FUSED_LOG: return std::log(a);
+        case FUSED_SQUARE: return a * a;
+        //  power, scale, shift
+        case FUSED_POW: return p[0] * p[1] == 0 ? (p[0] == 0 ? T(1) :
+            std::pow(T(p[2]), T(p[0]))) : std::pow(p[1] * a + p[2], T(p[0]));
+        //  low, high
+        case FUSED_CLIP: return std::max(T(p[0]), std::min(a, T(p[1])));
+    }
+    return T(0);
+}
+
+//  the local derivatives of y = opcode(a, b)
+template <typename T>
+inline void _FusedDerivative(const int opcode,
+                             const T a,
+                             const T b,
+                             const T y,
+                             const float* p,
+                             T* da,
+                             T* db) {
+    switch (opcode) {
+        case FUSED_ADD: *da = 1; *db = 1; break;
+        case FUSED_SUB: *da = 1; *db = -1; break;
+        case FUSED_MUL: *da = b; *db = a; break;
+        case FUSED_DIV: *da = T(1) / b; *db = -a / (b * b); break;
+        case FUSED_RELU: *da = y > 0 ? T(1) : T(p[0]); break;
+        case FUSED_ELU: *da = y > 0 ? T(1) : p[0] + y; break;
+        case FUSED_SIGMOID: *da = y * (1 - y); break;
+        case FUSED_TANH: *da = 1 - y * y; break;
+        case FUSED_EXP: *da = y; break;
+        case FUSED_LOG: *da = T(1) / a; break;
+        case FUSED_SQUARE: *da = 2 * a; break;
+        case FUSED_POW: *da = p[0] * p[1] == 0 ? T(0) : (p[0] == 1 ? T(p[1]) :
+            p[0] * p[1] * std::pow(p[1] * a + p[2], T(p[0] - 1))); break;
+        case FUSED_CLIP: *da = (a < p[0] || a > p[1]) ? T(0) : T(1); break;
+        default: *da = 0; break;
+    }
+}
+
+template<> void FusedElementwise<float, CPUContext>(const int count,
+                                                    const FusedProgram& program,
+                                                    const FusedData<float>& data,
+                                                    float* y) {
+    const int num_inputs = program.num_inputs;
+    const int num_values = num_inputs + program.num_insts;
+#ifdef WITH_OMP
+    #pragma omp parallel for num_threads(GET_OMP_THREADS(count))
+#endif
+    for (int i = 0; i < count; ++i) {
+        float v[FUSED_MAX_VALUES];
+        for (int j = 0; j < num_inputs; ++j)
+            v[j] = data.x[j][(i / program.div[j]) % program.mod[j]];
+        for (int k = 0; k < program.num_insts; ++k) {
+            const int b = program.b[k];
+            v[num_inputs + k] = _FusedApply<float>(program.opcode[k],
+                v[program.a[k]], b < 0 ? 0.f : v[b], program.params[k]);
+        }
+        y[i] = v[num_values - 1];
+    }
+}
+
+template<> void FusedElementwiseGrad<float, CPUContext>(const int count,
+                                                        const FusedProgram& program,
+                                                        const FusedData<float>& data,
+                                                        const float* dy) {
+    const int num_inputs = program.num_inputs;
+    const int num_values = num_inputs + program.num_insts;
+#ifdef WITH_OMP
+    #pragma omp parallel for num_threads(GET_OMP_THREADS(count))
+#endif
+    for (int i = 0; i < count; ++i) {
+        //  recompute the values, then accumulate the adjoints in reverse
+        float v[FUSED_MAX_VALUES], g[FUSED_MAX_VALUES];
+        for (int j = 0; j < num_inputs; ++j)
+            v[j] = data.x[j][(i / program.div[j]) % program.mod[j]];
+        for (int k = 0; k < program.num_insts; ++k) {
+            const int b = program.b[k];
+            v[num_inputs + k] = _FusedApply<float>(program.opcode[k],
+                v[program.a[k]], b < 0 ? 0.f : v[b], program.params[k]);
+        }
+        for (int j = 0; j < num_values; ++j) g[j] = 0;
+        g[num_values - 1] = dy[i];
+        for (int k = program.num_insts - 1; k >= 0; --k) {
+            const int a = program.a[k], b = program.b[k];
+            float da = 0, db = 0;
+            _FusedDerivative<float>(program.opcode[k], v[a], b < 0 ? 0.f : v[b],
+                v[num_inputs + k], program.params[k], &da, &db);
+            g[a] += g[num_inputs + k] * da;
+            if (b >= 0) g[b] += g[num_inputs + k] * db;
+        }
+        for (int j = 0; j < num_inputs; ++j)
+            if (data.dx[j]) data.dx[j][i] = g[j];
+    }
+}
+
 /******************** arithmetic.scale ********************/
 
 template<> void Scale<float, CPUContext>(const int axis, 
@@ -857,6 +1010,128 @@ template <> void ImageData<uint8_t, float16, CPUContext>(const int count,
     LOG(FATAL) << "float16 is unsupported for CPUContext.";
 }
 
+/******************** misc.image_augment ********************/
+
+template <typename Tx>
+void _ImageAugment(const int N, const int C,
+                   const int H, const int W,
+                   const int crop_h, const int crop_w,
+                   const int pad, const float fill_value,
+                   const int* params,
+                   const float* mean_values,
+                   const float* std_values,
+                   const string& data_format,
+                   const Tx* x,
+                   float* y) {
+    const int out_h = crop_h + 2 * pad, out_w = crop_w + 2 * pad;
+    const bool nchw = data_format == "NCHW";
+    if (!nchw && data_format != "NHWC")
+        LOG(FATAL) << "Unknown data format: " << data_format;
+    //  y = (x - mean) / std, the padded pixels are normalized too
+    vector<float> mean(C, 0.f), inv_std(C, 1.f), fill(C);
+    for (int c = 0; c < C; ++c) {
+        if (mean_values != nullptr) mean[c] = mean_values[c];
+        if (std_values != nullptr) inv_std[c] = 1.f / std_values[c];
+        fill[c] = (fill_value - mean[c]) * inv_std[c];
+    }
+#ifdef WITH_OMP
+    #pragma omp parallel for num_threads(GET_OMP_THREADS(N * C * out_h * out_w))
+#endif
+    for (int n = 0; n < N; ++n) {
+        const int* p = params + n * 5;
+        const int h_off = p[2], w_off = p[3];
+        const bool mirror = p[4] > 0;
+        const float scale_h = (float)H / p[0], scale_w = (float)W / p[1];
+        const Tx* im = x + n * H * W * C;
+        float* out = y + n * C * out_h * out_w;
+        //  the horizontal taps of the output columns, -1 for the padding
+        vector<int> left(out_w, -1), right(out_w, -1);
+        vector<float> x_lerp(out_w, 0.f);
+        int lo = W, hi = 0;
+        for (int ow = 0; ow < out_w; ++ow) {
+            const int iw = ow - pad;
+            if (iw < 0 || iw >= crop_w) continue;
+            const float w_in = (w_off + (mirror ? crop_w - 1 - iw : iw)) * scale_w;
+            left[ow] = floorf(w_in);
+            right[ow] = (w_in < W - 1) ? ceilf(w_in) : W - 1;
+            x_lerp[ow] = w_in - left[ow];
+            lo = std::min(lo, left[ow]);
+            hi = std::max(hi, right[ow]);
+        }
+        const int row_dim = (hi - lo + 1) * C;
+        vector<float> top(row_dim), bottom(row_dim);
+        for (int oh = 0; oh < out_h; ++oh) {
+            const int ih = oh - pad;
+            if (ih < 0 || ih >= crop_h) {
+                for (int ow = 0; ow < out_w; ++ow)
+                    for (int c = 0; c < C; ++c)
+                        out[nchw ? (c * out_h + oh) * out_w + ow
+                                 : (oh * out_w + ow) * C + c] = fill[c];
+                continue;
+            }
+            const float h_in = (h_off + ih) * scale_h;
+            const int top_y_idx = floorf(h_in);
+            const int bottom_y_idx = (h_in < H - 1) ? ceilf(h_in) : H - 1;
+            const float y_lerp = h_in - top_y_idx;
+            //  the vertical lerp over the contiguous (w, c) of two rows
+            const Tx* top_row = im + (top_y_idx * W + lo) * C;
+            for (int i = 0; i < row_dim; ++i) top[i] = top_row[i];
+            if (y_lerp > 0.f) {
+                const Tx* bottom_row = im + (bottom_y_idx * W + lo) * C;
+                for (int i = 0; i < row_dim; ++i) bottom[i] = bottom_row[i];
+#ifdef WITH_SSE
+                simd::Axpby<float>(row_dim, y_lerp, bottom.data(),
+                                   1.f - y_lerp, top.data());
+#else
+                for (int i = 0; i < row_dim; ++i)
+                    top[i] += (bottom[i] - top[i]) * y_lerp;
+#endif
+            }
+            //  the horizontal lerp, normalization and layout in one pass
+            for (int ow = 0; ow < out_w; ++ow) {
+                for (int c = 0; c < C; ++c) {
+                    float value = fill[c];
+                    if (left[ow] >= 0) {
+                        const float l = top[(left[ow] - lo) * C + c];
+                        const float r = top[(right[ow] - lo) * C + c];
+                        value = (l + (r - l) * x_lerp[ow] - mean[c]) * inv_std[c];
+                    }
+                    out[nchw ? (c * out_h + oh) * out_w + ow
+                             : (oh * out_w + ow) * C + c] = value;
+                }
+            }
+        }
+    }
+}
+
+template <> void ImageAugment<uint8_t, CPUContext>(const int N, const int C,
+                                                   const int H, const int W,
+                                                   const int crop_h, const int crop_w,
+                                                   const int pad, const float fill_value,
+                                                   const int* params,
+                                                   const float* mean_values,
+                                                   const float* std_values,
+                                                   const string& data_format,
+                                                   const uint8_t* x,
+                                                   float* y) {
+    _ImageAugment<uint8_t>(N, C, H, W, crop_h, crop_w, pad, fill_value,
+                           params, mean_values, std_values, data_format, x, y);
+}
+
+template <> void ImageAugment<float, CPUContext>(const int N, const int C,
+                                                 const int H, const int W,
+                                                 const int crop_h, const int crop_w,
+                                                 const int pad, const float fill_value,
+                                                 const int* params,
+                                                 const float* mean_values,
+                                                 const float* std_values,
+                                                 const string& data_format,
+                                                 const float* x,
+                                                 float* y) {
+    _ImageAugment<float>(N, C, H, W, crop_h, crop_w, pad, fill_value,
+                         params, mean_values, std_values, data_format, x, y);
+}
+
 /******************** ndarray.arange ********************/
 
 template<> void Arange<float, CPUContext>(const int count,
@@ -1561,31 +1836,25 @@ template <> void LSTMUnit<float, CPUContext>(const int count,
                                              float* x_act, 
                                              float* c, 
                                              float* h) {
-    float i, f, o, g;
     int f_offset = channels, o_offset = 2 * channels, 
         g_offset = 3 * channels, x_offset = 4 * channels;
     for (int n = 0; n < num; ++n) {
-        for (int ch = 0; ch < channels; ++ch) {
-            i = _sigmoid<float>(x[ch]);
-            if (cont != nullptr) {
-                f = (cont[n] == 0) ? 
-                     0 : (cont[n] * _sigmoid<float>(x[f_offset + ch]));
-            } else { 
-                f = _sigmoid<float>(x[f_offset + ch]); 
-            }
-            o = _sigmoid<float>(x[o_offset + ch]);
-            g = tanh(x[g_offset + ch]);
-            c[ch] = f * c_1[ch] + i * g;
-            h[ch] = o * tanh(c[ch]);
-            x_act[ch] = i;
-            x_act[f_offset + ch] = f;
-            x_act[o_offset + ch] = o;
-            x_act[g_offset + ch] = g;
-        }
+        //  the gates of (i, f, o) are contiguous
+        Sigmoid<float, CPUContext>(3 * channels, x, x_act);
+        Tanh<float, CPUContext>(channels, x + g_offset, x_act + g_offset);
+        float* i = x_act, *f = x_act + f_offset;
+        float* o = x_act + o_offset, *g = x_act + g_offset;
+        if (cont != nullptr && cont[n] != 1)
+            math::Scal<float, CPUContext>(channels, cont[n], f);
+        for (int ch = 0; ch < channels; ++ch)
+            c[ch] = f[ch] * c_1[ch] + i[ch] * g[ch];
+        Tanh<float, CPUContext>(channels, c, h);
+        math::Mul<float, CPUContext>(channels, o, h, h);
         c_1 += channels;
         c += channels;
         h += channels;
         x += x_offset;
+        x_act += x_offset;
     }
 }
 
@@ -1604,6 +1873,8 @@ template <> void LSTMUnitGrad<float, CPUContext>(const int count,
     int f_offset = channels, o_offset = 2 * channels,
         g_offset = 3 * channels, x_offset = 4 * channels;
     for (int n = 0; n < num; ++n) {
+        //  dc_1 holds tanh(c) until it is computed
+        Tanh<float, CPUContext>(channels, c, dc_1);
         for (int ch = 0; ch < channels; ++ch) {
             i = x_act[ch];
             f = x_act[f_offset + ch];
@@ -1618,7 +1889,7 @@ template <> void LSTMUnitGrad<float, CPUContext>(const int count,
             //                  + d(c_{t+1}) / d(c_{t}) * d(c_{t}) / d(c_{t-1})
             //           =  (dl / d(h_{t}) * d(h_{t}) / d(c_{t}) + d(c_{t+1}) / d(c_{t}))
             //                  * d(c_{t}) / d(c_{t-1})
-            tanh_c_t = tanh(c[ch]);
+            tanh_c_t = dc_1[ch];
             dc_1_sum_term = dh[ch] * o * (1 - tanh_c_t * tanh_c_t) + dc[ch];
             dc_1[ch] = dc_1_sum_term * f;
             *p_di = dc_1_sum_term * g * i * (1 - i);
@@ -1638,63 +1909,108 @@ template <> void LSTMUnitGrad<float, CPUContext>(const int count,
 
 /******************** update.adam_update ********************/
 
-template <> void AdamUpdate<float, CPUContext>(Tensor* x, 
-                                               Tensor* m, 
-                                               Tensor* v, 
-                                               Tensor* t,
-                                               const float beta1, 
-                                               const float beta2, 
-                                               const float eps, 
-                                               const float lr) {
-    TIndex count = x->count();
-    t->Reshape(vector<TIndex>(1, count));
-    auto* Xdata = x->mutable_data<float, CPUContext>();
-    auto* Mdata = m->mutable_data<float, CPUContext>();
-    auto* Vdata = v->mutable_data<float, CPUContext>();
-    auto* Tdata = t->mutable_data<float, CPUContext>();
-    math::Axpby<float, CPUContext>(count, 1.0 - beta1, Xdata, beta1, Mdata);
-    math::Mul<float, CPUContext>(count, Xdata, Xdata, Tdata);
-    math::Axpby<float, CPUContext>(count, 1.0 - beta2, Tdata, beta2, Vdata);
-    math::Sqrt<float, CPUContext>(count, Vdata, Tdata);
-    math::AddScalar<float, CPUContext>(count, eps, Tdata);
-    math::Div<float, CPUContext>(count, Mdata, Tdata, Tdata);
-    math::Scale<float, CPUContext>(count, lr, Tdata, Xdata);
+template <> void AdamUpdate<float, CPUContext>(const int count,
+                                               const float lr,
+                                               const float beta1,
+                                               const float beta2,
+                                               const float eps,
+                                               const float alpha,
+                                               const float l2_decay,
+                                               float* x,
+                                               float* dx,
+                                               float* m,
+                                               float* v) {
+#ifdef WITH_SSE
+    simd::AdamUpdate<float>(count, lr, beta1, beta2, eps, alpha, l2_decay, x, dx, m, v);
+#else
+#ifdef WITH_OMP
+    #pragma omp parallel for num_threads(GET_OMP_THREADS(count))
+#endif
+    for (int i = 0; i < count; ++i) {
+        float g = alpha * dx[i] + l2_decay * x[i];
+        float mi = m[i] = beta1 * m[i] + (1 - beta1) * g;
+        float vi = v[i] = beta2 * v[i] + (1 - beta2) * g * g;
+        x[i] -= lr * mi / (std::sqrt(vi) + eps);
+        dx[i] = 0;
+    }
+#endif    // WITH_SSE
 }
 
 /******************** update.nesterov_update ********************/
 
-template <> void NesterovUpdate<float,  CPUContext>(const int count,
-                                                    float* x,
-                                                    float* h,
-                                                    Tensor* t,
-                                                    const float momentum,
-                                                    const float lr,
-                                                    CPUContext* ctx) {
-    t->Reshape(vector<TIndex>(1, count));
-    float* Tdata = t->mutable_data<float, CPUContext>();
-    ctx->Copy<float, CPUContext, CPUContext>(count, Tdata, h);
-    math::Axpby<float, CPUContext>(count, lr, x, momentum, h);
-    math::Axpby<float, CPUContext>(count, 1.0 + momentum, h, -momentum, Tdata);
-    ctx->Copy<float, CPUContext, CPUContext>(count, x, Tdata);
+template <> void NesterovUpdate<float, CPUContext>(const int count,
+                                                   const float lr,
+                                                   const float momentum,
+                                                   const float alpha,
+                                                   const float l2_decay,
+                                                   float* x,
+                                                   float* dx,
+                                                   float* h) {
+#ifdef WITH_SSE
+    simd::NesterovUpdate<float>(count, lr, momentum, alpha, l2_decay, x, dx, h);
+#else
+#ifdef WITH_OMP
+    #pragma omp parallel for num_threads(GET_OMP_THREADS(count))
+#endif
+    for (int i = 0; i < count; ++i) {
+        float g = alpha * dx[i] + l2_decay * x[i];
+        float hi = h[i];
+        float hi_new = h[i] = momentum * hi + lr * g;
+        x[i] -= (1 + momentum) * hi_new - momentum * hi;
+        dx[i] = 0;
+    }
+#endif    // WITH_SSE
 }
 
 /******************** update.rmsprop_update ********************/
 
-template <> void RMSPropUpdate<float, CPUContext>(const int count, 
-                                                  float* x, 
-                                                  float* h,
-                                                  Tensor* t,
-                                                  const float decay, 
-                                                  const float eps, 
-                                                  const float lr) {
-    t->Reshape(vector<TIndex>(1, count));
-    float* Tdata = t->mutable_data<float, CPUContext>();
-    math::Square<float, CPUContext>(count, x, Tdata);
-    math::Axpby<float, CPUContext>(count, 1.0 - decay, Tdata, decay, h);
-    math::Sqrt<float, CPUContext>(count, h, Tdata);
-    math::AddScalar<float, CPUContext>(count, eps, Tdata);
-    math::Div<float, CPUContext>(count, x, Tdata, Tdata);
-    math::Axpby<float, CPUContext>(count, lr, Tdata, 0.0, x);
+template <> void RMSPropUpdate<float, CPUContext>(const int count,
+                                                  const float lr,
+                                                  const float decay,
+                                                  const float eps,
+                                                  const float alpha,
+                                                  const float l2_decay,
+                                                  float* x,
+                                                  float* dx,
+                                                  float* h) {
+#ifdef WITH_SSE
+    simd::RMSPropUpdate<float>(count, lr, decay, eps, alpha, l2_decay, x, dx, h);
+#else
+#ifdef WITH_OMP
+    #pragma omp parallel for num_threads(GET_OMP_THREADS(count))
+#endif
+    for (int i = 0; i < count; ++i) {
+        float g = alpha * dx[i] + l2_decay * x[i];
+        float hi = h[i] = decay * h[i] + (1 - decay) * g * g;
+        x[i] -= lr * g / (std::sqrt(hi) + eps);
+        dx[i] = 0;
+    }
+#endif    // WITH_SSE
+}
+
+/******************** update.sgd_update ********************/
+
+template <> void SGDUpdate<float, CPUContext>(const int count,
+                                              const float lr,
+                                              const float momentum,
+                                              const float alpha,
+                                              const float l2_decay,
+                                              float* x,
+                                              float* dx,
+                                              float* h) {
+#ifdef WITH_SSE
+    simd::SGDUpdate<float>(count, lr, momentum, alpha, l2_decay, x, dx, h);
+#else
+#ifdef WITH_OMP
+    #pragma omp parallel for num_threads(GET_OMP_THREADS(count))
+#endif
+    for (int i = 0; i < count; ++i) {
+        float g = alpha * dx[i] + l2_decay * x[i];
+        float hi = h[i] = momentum * h[i] + lr * g;
+        x[i] -= hi;
+        dx[i] = 0;
+    }
+#endif    // WITH_SSE
 }
 
 /******************** vision.bilinear_resize ********************/
@@ -696,6 +696,35 @@ template<> void BiasAdd<float, CUDAContext>(const int count,
     } else LOG(FATAL) << "Unknown data format: " << data_format;
 }
 
+template <typename T>
+__global__ void _BiasRelu(const int count,
+                          const int dim,
+                          const int inner_dim,
+                          const T* bias,
+                          const float slope,
+                          T* y) {
+    CUDA_KERNEL_LOOP(idx, count) {
+        const T v = y[idx] + bias[(idx / inner_dim) % dim];
+        y[idx] = v > 0 ? v : v * slope;
+    }
+}
+
+template<> void BiasRelu<float, CUDAContext>(const int outer_dim,
+                                             const int dim,
+                                             const int inner_dim,
+                                             const float* bias,
+                                             const float slope,
+                                             float* y) {
+    const int count = outer_dim * dim * inner_dim;
+    _BiasRelu<float> << <GET_BLOCKS(count), CUDA_NUM_THREADS >> >(count,
+                                                                    dim,
+                                                              inner_dim,
+                                                                   bias,
+                                                                  slope,
+                                                                     y);
+    CUDA_POST_KERNEL_CHECK;
+}
+
 /******************** arithmetic.clip ********************/
 
 template <typename T>
@@ -727,6 +756,131 @@ template <> void Clip<float, CUDAContext>(const int count,
                                                                   y);
 }
 
+/******************** arithmetic.fused_elementwise ********************/
+
+template <typename T>
+__device__ T _FusedApply(const int opcode, const T a, const T b, const float* p) {
+    switch (opcode) {
+        case FUSED_ADD: return a + b;
+        case FUSED_SUB: return a - b;
+        case FUSED_MUL: return a * b;
+        case FUSED_DIV: return a / b;
+        case FUSED_RELU: return a > 0 ? a : a * p[0];
+        case FUSED_ELU: return a > 0 ? a : p[0] * (exp(a) - 1);
+        case FUSED_SIGMOID: return T(1) / (T(1) + exp(-a));
+        case FUSED_TANH: return tanh(a);
+        case FUSED_EXP: return exp(a);
+        case FUSED_LOG: return log(a);
+        case FUSED_SQUARE: return a * a;
+        //  power, scale, shift
+        case FUSED_POW: return p[0] * p[1] == 0 ? (p[0] == 0 ? T(1) :
+            pow(T(p[2]), T(p[0]))) : pow(p[1] * a + p[2], T(p[0]));
+        //  low, high
+        case FUSED_CLIP: return a < p[0] ? T(p[0]) : (a > p[1] ? T(p[1]) : a);
+    }
+    return T(0);
+}
+
+template <typename T>
+__device__ void _FusedDerivative(const int opcode,
+                                 const T a,
+                                 const T b,
+                                 const T y,
+                                 const float* p,
+                                 T* da,
+                                 T* db) {
+    switch (opcode) {
+        case FUSED_ADD: *da = 1; *db = 1; break;
+        case FUSED_SUB: *da = 1; *db = -1; break;
+        case FUSED_MUL: *da = b; *db = a; break;
+        case FUSED_DIV: *da = T(1) / b; *db = -a / (b * b); break;
+        case FUSED_RELU: *da = y > 0 ? T(1) : T(p[0]); break;
+        case FUSED_ELU: *da = y > 0 ? T(1) : p[0] + y; break;
+        case FUSED_SIGMOID: *da = y * (1 - y); break;
+        case FUSED_TANH: *da = 1 - y * y; break;
+        case FUSED_EXP: *da = y; break;
+        case FUSED_LOG: *da = T(1) / a; break;
+        case FUSED_SQUARE: *da = 2 * a; break;
+        case FUSED_POW: *da = p[0] * p[1] == 0 ? T(0) : (p[0] == 1 ? T(p[1]) :
+            p[0] * p[1] * pow(p[1] * a + p[2], T(p[0] - 1))); break;
+        case FUSED_CLIP: *da = (a < p[0] || a > p[1]) ? T(0) : T(1); break;
+        default: *da = 0; break;
+    }
+}
+
+template <typename T>
+__global__ void _FusedElementwise(const int count,
+                                  const FusedProgram program,
+                                  const FusedData<T> data,
+                                  T* y) {
+    const int num_inputs = program.num_inputs;
+    const int num_values = num_inputs + program.num_insts;
+    CUDA_KERNEL_LOOP(idx, count) {
+        T v[FUSED_MAX_VALUES];
+        for (int j = 0; j < num_inputs; ++j)
+            v[j] = data.x[j][(idx / program.div[j]) % program.mod[j]];
+        for (int k = 0; k < program.num_insts; ++k) {
+            const int b = program.b[k];
+            v[num_inputs + k] = _FusedApply<T>(program.opcode[k],
+                v[program.a[k]], b < 0 ? T(0) : v[b], program.params[k]);
+        }
+        y[idx] = v[num_values - 1];
+    }
+}
+
+template<> void FusedElementwise<float, CUDAContext>(const int count,
+                                                     const FusedProgram& program,
+                                                     const FusedData<float>& data,
+                                                     float* y) {
+    _FusedElementwise<float> << <GET_BLOCKS(count), CUDA_NUM_THREADS >> >(count,
+                                                                        program,
+                                                                           data,
+                                                                             y);
+    CUDA_POST_KERNEL_CHECK;
+}
+
+template <typename T>
+__global__ void _FusedElementwiseGrad(const int count,
+                                      const FusedProgram program,
+                                      const FusedData<T> data,
+                                      const T* dy) {
+    const int num_inputs = program.num_inputs;
+    const int num_values = num_inputs + program.num_insts;
+    CUDA_KERNEL_LOOP(idx, count) {
+        T v[FUSED_MAX_VALUES], g[FUSED_MAX_VALUES];
+        for (int j = 0; j < num_inputs; ++j)
+            v[j] = data.x[j][(idx / program.div[j]) % program.mod[j]];
+        for (int k = 0; k < program.num_insts; ++k) {
+            const int b = program.b[k];
+            v[num_inputs + k] = _FusedApply<T>(program.opcode[k],
+                v[program.a[k]], b < 0 ? T(0) : v[b], program.params[k]);
+        }
+        for (int j = 0; j < num_values; ++j) g[j] = 0;
+        g[num_values - 1] = dy[idx];
+        for (int k = program.num_insts - 1; k >= 0; --k) {
+            const int a = program.a[k], b = program.b[k];
+            T da = 0, db = 0;
+            _FusedDerivative<T>(program.opcode[k], v[a], b < 0 ? T(0) : v[b],
+                v[num_inputs + k], program.params[k], &da, &db);
+            g[a] += g[num_inputs + k] * da;
+            if (b >= 0) g[b] += g[num_inputs + k] * db;
+        }
+        for (int j = 0; j < num_inputs; ++j)
+            if (data.dx[j]) data.dx[j][idx] = g[j];
+    }
+}
+
+template<> void FusedElementwiseGrad<float, CUDAContext>(const int count,
+                                                         const FusedProgram& program,
+                                                         const FusedData<float>& data,
+                                                         const float* dy) {
+    _FusedElementwiseGrad<float> << <GET_BLOCKS(count), CUDA_NUM_THREADS >> >(count,
+                                                                            program,
+                                                                               data,
+                                                                                dy);
+    CUDA_POST_KERNEL_CHECK;
+}
+
 /******************** arithmetic.scale ********************/
 
 template <typename T>
@@ -2700,41 +2854,47 @@ template <> void LSTMUnitGrad<float, CUDAContext>(const int count,
 
 template <typename T>
 __global__ void _AdamUpdate(const int n, 
-                            T* g, 
-                            T* m, 
-                            T* v,
+                            const T lr,
                             const T beta1, 
                             const T beta2, 
                             const T eps, 
-                            const T lr) {
+                            const T alpha,
+                            const T l2_decay,
+                            T* x,
+                            T* dx,
+                            T* m, 
+                            T* v) {
     CUDA_KERNEL_LOOP(i, n) {
-        T gi = g[i];
+        T gi = alpha * dx[i] + l2_decay * x[i];
         T mi = m[i] = m[i] * beta1 + gi * (1 - beta1);
         T vi = v[i] = v[i] * beta2 + gi * gi * (1 - beta2);
-        g[i] = lr * mi / (sqrt(vi) + eps);
+        x[i] -= lr * mi / (sqrt(vi) + eps);
+        dx[i] = 0;
     }
 }
 
-template <> void AdamUpdate<float, CUDAContext>(Tensor* x, 
-                                                Tensor* m, 
-                                                Tensor* v, 
-                                                Tensor* t,
+template <> void AdamUpdate<float, CUDAContext>(const int count,
+                                                const float lr,
                                                 const float beta1, 
                                                 const float beta2, 
                                                 const float eps, 
-                                                const float lr) {
-    TIndex count = x->count();
-    auto* Xdata = x->mutable_data<float, CUDAContext>();
-    auto* Mdata = m->mutable_data<float, CUDAContext>();
-    auto* Vdata = v->mutable_data<float, CUDAContext>();
+                                                const float alpha,
+                                                const float l2_decay,
+                                                float* x,
+                                                float* dx,
+                                                float* m,
+                                                float* v) {
     _AdamUpdate<float> << <GET_BLOCKS(count), CUDA_NUM_THREADS >> >(count, 
-                                                                    Xdata, 
-                                                                    Mdata, 
-                                                                    Vdata, 
+                                                                       lr,
                                                                     beta1, 
                                                                     beta2, 
                                                                       eps, 
-                                                                      lr);
+                                                                    alpha,
+                                                                 l2_decay,
+                                                                        x,
+                                                                       dx,
+                                                                        m,
+                                                                        v);
     CUDA_POST_KERNEL_CHECK;
 }
 
@@ -2742,28 +2902,38 @@ template <> void AdamUpdate<float, CUDAContext>(Tensor* x,
 
 template <typename T>
 __global__ void _NesterovUpdate(const int n, 
-                               T* g, 
-                               T* h,
-                               const T momentum,
-                               const T lr) {
+                                const T lr,
+                                const T momentum,
+                                const T alpha,
+                                const T l2_decay,
+                                T* x,
+                                T* dx,
+                                T* h) {
     CUDA_KERNEL_LOOP(i, n) {
+        T gi = alpha * dx[i] + l2_decay * x[i];
         T hi = h[i];
-        T hi_new = h[i] = momentum * hi + lr * g[i];
-        g[i] = (1 + momentum) * hi_new - momentum * hi;
+        T hi_new = h[i] = momentum * hi + lr * gi;
+        x[i] -= (1 + momentum) * hi_new - momentum * hi;
+        dx[i] = 0;
     }
 }
+
 template <> void NesterovUpdate<float, CUDAContext>(const int count,
-                                                    float* x,
-                                                    float* h,
-                                                    Tensor* t,
-                                                    const float momentum,
                                                     const float lr,
-                                                    CUDAContext* ctx) {
+                                                    const float momentum,
+                                                    const float alpha,
+                                                    const float l2_decay,
+                                                    float* x,
+                                                    float* dx,
+                                                    float* h) {
     _NesterovUpdate<float> << <GET_BLOCKS(count), CUDA_NUM_THREADS >> >(count,
-                                                                            x, 
-                                                                            h, 
-                                                                     momentum,
-                                                                          lr);
+                                                                          lr,
+                                                                    momentum,
+                                                                       alpha,
+                                                                    l2_decay,
+                                                                           x, 
+                                                                          dx,
+                                                                           h);
     CUDA_POST_KERNEL_CHECK;
 }
 
@@ -2771,31 +2941,78 @@ template <> void NesterovUpdate<float, CUDAContext>(const int count,
 
 template <typename T>
 __global__ void _RMSPropUpdate(const int n, 
-                               T* g, 
-                               T* h,
+                               const T lr,
                                const T decay, 
                                const T eps, 
-                               const T lr) {
+                               const T alpha,
+                               const T l2_decay,
+                               T* x,
+                               T* dx,
+                               T* h) {
     CUDA_KERNEL_LOOP(i, n) {
-        T gi = g[i];
+        T gi = alpha * dx[i] + l2_decay * x[i];
         T hi = h[i] = decay * h[i] + (1 - decay) * gi * gi;
-        g[i] = lr * g[i] / (sqrt(hi) + eps);
+        x[i] -= lr * gi / (sqrt(hi) + eps);
+        dx[i] = 0;
     }
 }
 
 template <> void RMSPropUpdate<float, CUDAContext>(const int count,
-                                                   float* x, 
-                                                   float* h,
-                                                   Tensor* t,
-                                                   const float decay, 
-                                                   const float eps, 
-                                                   const float lr) {
+                                                   const float lr,
+                                                   const float decay,
+                                                   const float eps,
+                                                   const float alpha,
+                                                   const float l2_decay,
+                                                   float* x,
+                                                   float* dx,
+                                                   float* h) {
     _RMSPropUpdate<float> << <GET_BLOCKS(count), CUDA_NUM_THREADS >> >(count, 
-                                                                           x, 
-                                                                           h, 
+                                                                          lr,
                                                                        decay, 
                                                                          eps, 
-                                                                         lr);
+                                                                       alpha,
+                                                                    l2_decay,
+                                                                           x,
+                                                                          dx,
+                                                                           h);
+    CUDA_POST_KERNEL_CHECK;
+}
+
+/******************** update.sgd_update ********************/
+
+template <typename T>
+__global__ void _SGDUpdate(const int n, 
+                           const T lr,
+                           const T momentum,
+                           const T alpha,
+                           const T l2_decay,
+                           T* x,
+                           T* dx,
+                           T* h) {
+    CUDA_KERNEL_LOOP(i, n) {
+        T gi = alpha * dx[i] + l2_decay * x[i];
+        T hi = h[i] = momentum * h[i] + lr * gi;
+        x[i] -= hi;
+        dx[i] = 0;
+    }
+}
+
+template <> void SGDUpdate<float, CUDAContext>(const int count,
+                                               const float lr,
+                                               const float momentum,
+                                               const float alpha,
+                                               const float l2_decay,
+                                               float* x,
+                                               float* dx,
+                                               float* h) {
+    _SGDUpdate<float> << <GET_BLOCKS(count), CUDA_NUM_THREADS >> >(count,
+                                                                      lr,
+                                                                momentum,
+                                                                   alpha,
+                                                                l2_decay,
+                                                                       x,
+                                                                      dx,
+                                                                       h);
     CUDA_POST_KERNEL_CHECK;
 }
 
@@ -0,0 +1,201 @@
+#ifdef WITH_SHM
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <thread>
+
+#include "core/context.h"
+#include "utils/math_functions.h"
+#include "utils/shm_comm.h"
+
+namespace dragon {
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2,
+    "The barrier of SHM requires the lock-free atomics.");
+
+//  the ranks spin before yielding the cpu,
+//  which matters when the processes are more than the cores
+#define SHM_SPIN_COUNT 4096
+#define SHM_ATTACH_TIMEOUT 120
+
+//  call func(i, offset in x[i], offset in the stream, count)
+//  for the pieces of the concatenated inputs in [begin, end)
+template <class Func>
+static void ForEachPiece(const vector<TIndex>& counts,
+                         const TIndex begin,
+                         const TIndex end,
+                         Func func) {
+    TIndex start = 0;
+    for (int i = 0; i < counts.size() && start < end; i++) {
+        const TIndex lo = std::max(begin, start);
+        const TIndex hi = std::min(end, start + counts[i]);
+        if (lo < hi) func(i, lo - start, lo, hi - lo);
+        start += counts[i];
+    }
+}
+
+SHMComm::SHMComm(const string& key, int rank, int size, TIndex slot_count)
+    : rank_(rank), size_(size), slot_count_(slot_count) {
+    CHECK(rank >= 0 && rank < size)
+        << "\nInvalid SHM rank " << rank << " of " << size << ".";
+    //  a POSIX name is a single component starting with "/"
+    name_ = "/dragon_" + key;
+    for (int i = 1; i < name_.size(); i++)
+        if (name_[i] == '/') name_[i] = '_';
+    nbytes_ = sizeof(Header) + sizeof(float) * size * slot_count;
+
+    void* addr = MAP_FAILED;
+    if (rank == 0) {
+        //  the ranks attached to a stale segment will find it replaced
+        int fd = shm_open(name_.c_str(), O_RDWR, 0600);
+        if (fd != -1) {
+            struct stat st;
+            if (fstat(fd, &st) == 0 && st.st_size >= sizeof(Header)) {
+                void* stale = mmap(nullptr, sizeof(Header),
+                    PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (stale != MAP_FAILED) {
+                    ((Header*)stale)->state.store(kStale, std::memory_order_release);
+                    munmap(stale, sizeof(Header));
+                }
+            }
+            close(fd);
+        }
+        shm_unlink(name_.c_str());
+        fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        CHECK(fd != -1) << "\nFailed to create the SHM segment: " << name_;
+        CHECK(ftruncate(fd, nbytes_) == 0)
+            << "\nFailed to allocate " << nbytes_ << " bytes for SHM.";
+        addr = mmap(nullptr, nbytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        CHECK(addr != MAP_FAILED) << "\nFailed to map the SHM segment: " << name_;
+        //  the truncated segment is zero-filled, i.e. the initial barrier
+        Header* header = (Header*)addr;
+        header->creator = (int)getpid();
+        header->state.store(kReady, std::memory_order_release);
+    } else {
+        //  wait for the rank 0 to create and publish the segment
+        auto start = std::chrono::steady_clock::now();
+        while (true) {
+            int fd = shm_open(name_.c_str(), O_RDWR, 0600);
+            struct stat st;
+            if (fd != -1 && fstat(fd, &st) == 0 && st.st_size == nbytes_)
+                addr = mmap(nullptr, nbytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (fd != -1) close(fd);
+            if (addr != MAP_FAILED) {
+                Header* header = (Header*)addr;
+                if (header->state.load(std::memory_order_acquire) == kReady &&
+                        (kill(header->creator, 0) == 0 || errno == EPERM)) break;
+                munmap(addr, nbytes_);
+                addr = MAP_FAILED;
+            }
+            CHECK(std::chrono::steady_clock::now() - start <
+                  std::chrono::seconds(SHM_ATTACH_TIMEOUT))
+                << "\nTimeout to attach the SHM segment: " << name_;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    base_ = (char*)addr;
+    header_ = (Header*)base_;
+    Barrier();
+    if (rank == 0) shm_unlink(name_.c_str());
+}
+
+SHMComm::~SHMComm() {
+    munmap(base_, nbytes_);
+}
+
+void SHMComm::Barrier() {
+    if (size_ == 1) return;
+    const int generation = header_->generation.load(std::memory_order_acquire);
+    if (header_->count.fetch_add(1, std::memory_order_acq_rel) == size_ - 1) {
+        header_->count.store(0, std::memory_order_relaxed);
+        header_->generation.fetch_add(1, std::memory_order_release);
+        return;
+    }
+    int spins = 0;
+    while (header_->generation.load(std::memory_order_acquire) == generation) {
+        if (++spins > SHM_SPIN_COUNT) {
+            CHECK_NE(header_->state.load(std::memory_order_relaxed), kStale)
+                << "\nThe SHM segment was replaced by another job: " << name_;
+            std::this_thread::yield();
+        }
+    }
+}
+
+void SHMComm::AllReduce(const vector<float*>& x,
+                        const vector<TIndex>& counts,
+                        const float scale) {
+    TIndex total = 0;
+    for (auto count : counts) total += count;
+    for (TIndex offset = 0; offset < total; offset += slot_count_) {
+        const TIndex n = std::min(slot_count_, total - offset);
+        //  the segments are aligned to the widest vector
+        const TIndex segment = ((n + size_ - 1) / size_ + 15) / 16 * 16;
+        ForEachPiece(counts, offset, offset + n,
+            [&](int i, TIndex x_offset, TIndex s_offset, TIndex count) {
+                CPUContext::Copy<float, CPUContext, CPUContext>(count,
+                    slot(rank_) + s_offset - offset, x[i] + x_offset);
+        });
+        Barrier();
+
+        //  reduce-scatter
+        const TIndex begin = std::min(n, rank_ * segment);
+        const TIndex end = std::min(n, begin + segment);
+        if (begin < end) {
+            float* y = slot(rank_) + begin;
+            for (int j = 0; j < size_; j++)
+                if (j != rank_) math::Add<float, CPUContext>(end - begin,
+                                                     y, slot(j) + begin, y);
+            if (scale != 1.f) math::Scal<float, CPUContext>(end - begin, scale, y);
+        }
+        Barrier();
+
+        //  allgather
+        for (int j = 0; j < size_; j++) {
+            const TIndex lo = std::min(n, j * segment);
+            const TIndex hi = std::min(n, lo + segment);
+            ForEachPiece(counts, offset + lo, offset + hi,
+                [&](int i, TIndex x_offset, TIndex s_offset, TIndex count) {
+                    CPUContext::Copy<float, CPUContext, CPUContext>(count,
+                        x[i] + x_offset, slot(j) + s_offset - offset);
+            });
+        }
+        //  the slots are rewritten by the next chunk
+        Barrier();
+    }
+}
+
+void SHMComm::Bcast(const vector<float*>& x,
+                    const vector<TIndex>& counts,
+                    const int root) {
+    TIndex total = 0;
+    for (auto count : counts) total += count;
+    for (TIndex offset = 0; offset < total; offset += slot_count_) {
+        const TIndex n = std::min(slot_count_, total - offset);
+        if (rank_ == root) {
+            ForEachPiece(counts, offset, offset + n,
+                [&](int i, TIndex x_offset, TIndex s_offset, TIndex count) {
+                    CPUContext::Copy<float, CPUContext, CPUContext>(count,
+                        slot(root) + s_offset - offset, x[i] + x_offset);
+            });
+        }
+        Barrier();
+        if (rank_ != root) {
+            ForEachPiece(counts, offset, offset + n,
+                [&](int i, TIndex x_offset, TIndex s_offset, TIndex count) {
+                    CPUContext::Copy<float, CPUContext, CPUContext>(count,
+                        x[i] + x_offset, slot(root) + s_offset - offset);
+            });
+        }
+        Barrier();
+    }
+}
+
+}    // namespace dragon
+
+#endif    // WITH_SHM
@@ -0,0 +1,320 @@
+#ifdef WITH_SSE
+
+#include <algorithm>
+
+#include "utils/omp_alternative.h"
+#include "utils/simd_alternative.h"
+#include "utils/simd_device.h"
+
+namespace dragon {
+
+namespace simd {
+
+class Dispatcher {
+ public:
+    Dispatcher() {
+        InitSSEKernels(&sse_);
+        InitAVX2Kernels(&avx2_);
+        InitAVX512Kernels(&avx512_);
+        active_ = &sse_;
+#if defined(__GNUC__)
+        //  also checks whether the os saves the wider registers
+        __builtin_cpu_init();
+        has_avx2_ = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        has_avx512_ = __builtin_cpu_supports("avx512f");
+#else
+        has_avx2_ = has_avx512_ = false;
+#endif
+        if (has_avx2_) active_ = &avx2_;
+        if (has_avx512_) active_ = &avx512_;
+    }
+
+    static Dispatcher* Get() {
+        static Dispatcher dispatcher;
+        return &dispatcher;
+    }
+
+    inline const Kernels* active() const { return active_; }
+
+    bool Select(const std::string& name) {
+        if (name == sse_.name) { active_ = &sse_; return true; }
+        if (name == avx2_.name && has_avx2_) { active_ = &avx2_; return true; }
+        if (name == avx512_.name && has_avx512_) { active_ = &avx512_; return true; }
+        return false;
+    }
+
+ private:
+    Kernels sse_, avx2_, avx512_;
+    const Kernels* active_;
+    bool has_avx2_, has_avx512_;
+};
+
+static inline const Kernels* kernels() { return Dispatcher::Get()->active(); }
+
+const char* ISA() { return kernels()->name; }
+
+bool SetISA(const std::string& name) { return Dispatcher::Get()->Select(name); }
+
+//  split the elementwise kernels into the chunks of threads,
+//  the chunks are aligned to the widest vector
+template <class Func>
+static inline void ParallelFor(const int n, Func func) {
+#ifdef WITH_OMP
+    const int num_threads = GET_OMP_THREADS(n);
+    if (num_threads > 1) {
+        const int chunk = ((n + num_threads - 1) / num_threads + 15) / 16 * 16;
+        #pragma omp parallel for num_threads(num_threads)
+        for (int t = 0; t < num_threads; ++t) {
+            const int start = t * chunk;
+            const int count = std::min(chunk, n - start);
+            if (count > 0) func(start, count);
+        }
+        return;
+    }
+#endif
+    func(0, n);
+}
+
+/******************** Level-0 ********************/
+
+template<> void Set(const int n, const float alpha, float* x) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Set(c, alpha, x + i); });
+}
+
+template<> void Set(const int n, const int alpha, int* x) {
+    ParallelFor(n, [=](int i, int c) { std::fill(x + i, x + i + c, alpha); });
+}
+
+/******************** Level-1 ********************/
+
+template<> void Add(const int n, const float* a, const float* b, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Add(c, a + i, b + i, y + i); });
+}
+
+template<> void Sub(const int n, const float* a, const float* b, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Sub(c, a + i, b + i, y + i); });
+}
+
+template<> void Mul(const int n, const float* a, const float* b, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Mul(c, a + i, b + i, y + i); });
+}
+
+template<> void Div(const int n, const float* a, const float* b, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Div(c, a + i, b + i, y + i); });
+}
+
+template<> void Clip(const int n, const float low, const float high, float* x) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Clip(c, low, high, x + i); });
+}
+
+template<> void Exp(const int n, const float* x, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Exp(c, x + i, y + i); });
+}
+
+template<> void Log(const int n, const float* x, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Log(c, x + i, y + i); });
+}
+
+template<> void Square(const int n, const float* x, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Square(c, x + i, y + i); });
+}
+
+template<> void Sqrt(const int n, const float* x, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Sqrt(c, x + i, y + i); });
+}
+
+template<> void Pow(const int n, const float alpha, const float* x, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Pow(c, alpha, x + i, y + i); });
+}
+
+template<> void Inv(const int n, const float numerator, const float* x, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Inv(c, numerator, x + i, y + i); });
+}
+
+/******************** Level-2 ********************/
+
+template<> void Scal(const int n, const float alpha, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Scale(c, alpha, y + i, y + i); });
+}
+
+template<> void Scale(const int n, const float alpha, const float* x, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Scale(c, alpha, x + i, y + i); });
+}
+
+template<> float Dot(const int n, const float* a, const float* b) {
+    return kernels()->Dot(n, a, b);
+}
+
+template<> float ASum(const int n, const float* x) {
+    return kernels()->ASum(n, x);
+}
+
+template<> void AddScalar(const int n, const float alpha, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->AddScalar(c, alpha, y + i); });
+}
+
+template<> void MulScalar(const int n, const float alpha, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Scale(c, alpha, y + i, y + i); });
+}
+
+template<> void Axpy(const int n, const float alpha, const float* x, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Axpy(c, alpha, x + i, y + i); });
+}
+
+template<> void Axpby(const int n,
+                      const float alpha,
+                      const float* x,
+                      const float beta,
+                      float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Axpby(c, alpha, x + i, beta, y + i); });
+}
+
+/******************** Activation ********************/
+
+template<> void Sigmoid(const int n, const float* x, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Sigmoid(c, x + i, y + i); });
+}
+
+template<> void Tanh(const int n, const float* x, float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Tanh(c, x + i, y + i); });
+}
+
+template<> void Elu(const int n,
+                    const float alpha,
+                    const float scale,
+                    const float* x,
+                    float* y) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) { k->Elu(c, alpha, scale, x + i, y + i); });
+}
+
+//  the tasks are the outer slices, or the blocks of inner positions
+#define SOFTMAX_INNER_BLOCK 256
+
+template <class Func>
+static inline void ParallelForSlices(const int outer_dim,
+                                     const int classes,
+                                     const int inner_dim,
+                                     Func func) {
+    const int num_blocks = (inner_dim + SOFTMAX_INNER_BLOCK - 1) / SOFTMAX_INNER_BLOCK;
+    const int num_tasks = outer_dim * num_blocks;
+#ifdef WITH_OMP
+    #pragma omp parallel for num_threads(GET_OMP_THREADS(outer_dim * classes * inner_dim))
+#endif
+    for (int t = 0; t < num_tasks; ++t) {
+        const int i = t / num_blocks, b = t % num_blocks;
+        const int offset = i * classes * inner_dim + b * SOFTMAX_INNER_BLOCK;
+        func(offset, std::min(SOFTMAX_INNER_BLOCK, inner_dim - b * SOFTMAX_INNER_BLOCK));
+    }
+}
+
+template<> void Softmax(const int outer_dim,
+                        const int classes,
+                        const int inner_dim,
+                        const float* x,
+                        float* y) {
+    auto* k = kernels();
+    ParallelForSlices(outer_dim, classes, inner_dim, [=](int offset, int c) {
+        k->Softmax(classes, inner_dim, c, x + offset, y + offset);
+    });
+}
+
+template<> void SoftmaxGrad(const int outer_dim,
+                            const int classes,
+                            const int inner_dim,
+                            const float* dy,
+                            const float* y,
+                            float* dx) {
+    auto* k = kernels();
+    ParallelForSlices(outer_dim, classes, inner_dim, [=](int offset, int c) {
+        k->SoftmaxGrad(classes, inner_dim, c, dy + offset, y + offset, dx + offset);
+    });
+}
+
+/******************** Update ********************/
+
+template<> void SGDUpdate(const int n,
+                          const float lr,
+                          const float momentum,
+                          const float alpha,
+                          const float l2_decay,
+                          float* x,
+                          float* dx,
+                          float* h) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) {
+        k->SGDUpdate(c, lr, momentum, alpha, l2_decay, x + i, dx + i, h + i);
+    });
+}
+
+template<> void NesterovUpdate(const int n,
+                               const float lr,
+                               const float momentum,
+                               const float alpha,
+                               const float l2_decay,
+                               float* x,
+                               float* dx,
+                               float* h) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) {
+        k->NesterovUpdate(c, lr, momentum, alpha, l2_decay, x + i, dx + i, h + i);
+    });
+}
+
+template<> void RMSPropUpdate(const int n,
+                              const float lr,
+                              const float decay,
+                              const float eps,
+                              const float alpha,
+                              const float l2_decay,
+                              float* x,
+                              float* dx,
+                              float* h) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) {
+        k->RMSPropUpdate(c, lr, decay, eps, alpha, l2_decay, x + i, dx + i, h + i);
+    });
+}
+
+template<> void AdamUpdate(const int n,
+                           const float lr,
+                           const float beta1,
+                           const float beta2,
+                           const float eps,
+                           const float alpha,
+                           const float l2_decay,
+                           float* x,
+                           float* dx,
+                           float* m,
+                           float* v) {
+    auto* k = kernels();
+    ParallelFor(n, [=](int i, int c) {
+        k->AdamUpdate(c, lr, beta1, beta2, eps, alpha, l2_decay, x + i, dx + i, m + i, v + i);
+    });
+}
+
+}    // namespace simd
+
+}    // namespace dragon
+
+#endif    // WITH_SSE
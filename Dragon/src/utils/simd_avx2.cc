@@ -0,0 +1,89 @@
+#ifdef WITH_SSE
+
+//  include the standard headers before enabling the target,
+//  their inline functions should not be compiled with it
+#include <cmath>
+#include <cfloat>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+
+#include <immintrin.h>
+
+#include "utils/simd_device.h"
+
+namespace dragon {
+
+namespace simd {
+
+struct AVX2 {
+    typedef __m256 reg;
+    static const int W = 8;
+
+    static inline reg load(const float* x) { return _mm256_loadu_ps(x); }
+    static inline void store(float* y, reg x) { _mm256_storeu_ps(y, x); }
+    static inline reg set1(float x) { return _mm256_set1_ps(x); }
+    static inline reg zero() { return _mm256_setzero_ps(); }
+    static inline reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+    static inline reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+    static inline reg div(reg a, reg b) { return _mm256_div_ps(a, b); }
+    static inline reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+    static inline reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+    static inline reg sqrt(reg x) { return _mm256_sqrt_ps(x); }
+    static inline reg abs(reg x) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), x); }
+    static inline reg fmadd(reg a, reg b, reg c) { return _mm256_fmadd_ps(a, b, c); }
+    static inline reg round(reg x) {
+        return _mm256_round_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+    static inline reg lt(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static inline reg select(reg m, reg a, reg b) { return _mm256_blendv_ps(b, a, m); }
+
+    static inline float reduce(reg x) {
+        __m128 y = _mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+        y = _mm_add_ps(y, _mm_movehl_ps(y, y));
+        y = _mm_add_ss(y, _mm_shuffle_ps(y, y, 1));
+        return _mm_cvtss_f32(y);
+    }
+
+    static inline reg pow2n(reg n) {
+        __m256i e = _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+        return _mm256_castsi256_ps(_mm256_slli_epi32(e, 23));
+    }
+
+    static inline reg frexp(reg x, reg* e) {
+        __m256i bits = _mm256_castps_si256(x);
+        __m256i exp = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126));
+        *e = _mm256_cvtepi32_ps(exp);
+        bits = _mm256_and_si256(bits, _mm256_set1_epi32(0x807FFFFF));
+        return _mm256_or_ps(_mm256_castsi256_ps(bits), _mm256_set1_ps(0.5f));
+    }
+
+    static inline int in_range(reg x, float lo, float hi) {
+        reg m = _mm256_and_ps(_mm256_cmp_ps(x, _mm256_set1_ps(lo), _CMP_GE_OQ),
+                              _mm256_cmp_ps(x, _mm256_set1_ps(hi), _CMP_LE_OQ));
+        return _mm256_movemask_ps(m);
+    }
+};
+
+void InitAVX2Kernels(Kernels* kernels) {
+    InitKernels<AVX2>("AVX2", kernels);
+}
+
+}    // namespace simd
+
+}    // namespace dragon
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif    // WITH_SSE
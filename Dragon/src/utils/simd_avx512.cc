@@ -0,0 +1,95 @@
+#ifdef WITH_SSE
+
+//  include the standard headers before enabling the target,
+//  their inline functions should not be compiled with it
+#include <cmath>
+#include <cfloat>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+
+#include <immintrin.h>
+
+#include "utils/simd_device.h"
+
+namespace dragon {
+
+namespace simd {
+
+struct AVX512 {
+    typedef __m512 reg;
+    static const int W = 16;
+
+    static inline reg load(const float* x) { return _mm512_loadu_ps(x); }
+    static inline void store(float* y, reg x) { _mm512_storeu_ps(y, x); }
+    static inline reg set1(float x) { return _mm512_set1_ps(x); }
+    static inline reg zero() { return _mm512_setzero_ps(); }
+    static inline reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+    static inline reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+    static inline reg div(reg a, reg b) { return _mm512_div_ps(a, b); }
+    static inline reg min(reg a, reg b) { return _mm512_min_ps(a, b); }
+    static inline reg max(reg a, reg b) { return _mm512_max_ps(a, b); }
+    static inline reg sqrt(reg x) { return _mm512_sqrt_ps(x); }
+    static inline reg abs(reg x) {
+        return _mm512_castsi512_ps(_mm512_and_si512(
+            _mm512_castps_si512(x), _mm512_set1_epi32(0x7FFFFFFF)));
+    }
+    static inline reg fmadd(reg a, reg b, reg c) { return _mm512_fmadd_ps(a, b, c); }
+    static inline reg round(reg x) {
+        return _mm512_roundscale_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+    static inline float reduce(reg x) { return _mm512_reduce_add_ps(x); }
+
+    //  the comparisons of AVX-512 give the bit masks,
+    //  keep them as the all-ones lanes like SSE and AVX2
+    static inline reg lt(reg a, reg b) {
+        __mmask16 m = _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+        return _mm512_castsi512_ps(_mm512_maskz_set1_epi32(m, -1));
+    }
+    static inline reg select(reg m, reg a, reg b) {
+        __mmask16 k = _mm512_test_epi32_mask(_mm512_castps_si512(m), _mm512_castps_si512(m));
+        return _mm512_mask_blend_ps(k, b, a);
+    }
+
+    static inline reg pow2n(reg n) {
+        __m512i e = _mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127));
+        return _mm512_castsi512_ps(_mm512_slli_epi32(e, 23));
+    }
+
+    static inline reg frexp(reg x, reg* e) {
+        __m512i bits = _mm512_castps_si512(x);
+        __m512i exp = _mm512_sub_epi32(_mm512_srli_epi32(bits, 23), _mm512_set1_epi32(126));
+        *e = _mm512_cvtepi32_ps(exp);
+        bits = _mm512_and_si512(bits, _mm512_set1_epi32(0x807FFFFF));
+        bits = _mm512_or_si512(bits, _mm512_castps_si512(_mm512_set1_ps(0.5f)));
+        return _mm512_castsi512_ps(bits);
+    }
+
+    static inline int in_range(reg x, float lo, float hi) {
+        return _mm512_cmp_ps_mask(x, _mm512_set1_ps(lo), _CMP_GE_OQ) &
+               _mm512_cmp_ps_mask(x, _mm512_set1_ps(hi), _CMP_LE_OQ);
+    }
+};
+
+void InitAVX512Kernels(Kernels* kernels) {
+    InitKernels<AVX512>("AVX-512", kernels);
+}
+
+}    // namespace simd
+
+}    // namespace dragon
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif    // WITH_SSE
@@ -0,0 +1,89 @@
+#ifdef WITH_SSE
+
+//  include the standard headers before enabling the target,
+//  their inline functions should not be compiled with it
+#include <cmath>
+#include <cfloat>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse4.1"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+#endif
+
+#include <immintrin.h>
+
+#include "utils/simd_device.h"
+
+namespace dragon {
+
+namespace simd {
+
+struct SSE {
+    typedef __m128 reg;
+    static const int W = 4;
+
+    static inline reg load(const float* x) { return _mm_loadu_ps(x); }
+    static inline void store(float* y, reg x) { _mm_storeu_ps(y, x); }
+    static inline reg set1(float x) { return _mm_set1_ps(x); }
+    static inline reg zero() { return _mm_setzero_ps(); }
+    static inline reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+    static inline reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+    static inline reg div(reg a, reg b) { return _mm_div_ps(a, b); }
+    static inline reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+    static inline reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+    static inline reg sqrt(reg x) { return _mm_sqrt_ps(x); }
+    static inline reg abs(reg x) { return _mm_andnot_ps(_mm_set1_ps(-0.f), x); }
+    //  no fma in SSE, round twice
+    static inline reg fmadd(reg a, reg b, reg c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static inline reg round(reg x) {
+        return _mm_round_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+    static inline reg lt(reg a, reg b) { return _mm_cmplt_ps(a, b); }
+    static inline reg select(reg m, reg a, reg b) { return _mm_blendv_ps(b, a, m); }
+
+    static inline float reduce(reg x) {
+        x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+        x = _mm_add_ss(x, _mm_shuffle_ps(x, x, 1));
+        return _mm_cvtss_f32(x);
+    }
+
+    static inline reg pow2n(reg n) {
+        __m128i e = _mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127));
+        return _mm_castsi128_ps(_mm_slli_epi32(e, 23));
+    }
+
+    static inline reg frexp(reg x, reg* e) {
+        __m128i bits = _mm_castps_si128(x);
+        __m128i exp = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126));
+        *e = _mm_cvtepi32_ps(exp);
+        bits = _mm_and_si128(bits, _mm_set1_epi32(0x807FFFFF));
+        return _mm_or_ps(_mm_castsi128_ps(bits), _mm_set1_ps(0.5f));
+    }
+
+    static inline int in_range(reg x, float lo, float hi) {
+        reg m = _mm_and_ps(_mm_cmpge_ps(x, _mm_set1_ps(lo)),
+                           _mm_cmple_ps(x, _mm_set1_ps(hi)));
+        return _mm_movemask_ps(m);
+    }
+};
+
+void InitSSEKernels(Kernels* kernels) {
+    InitKernels<SSE>("SSE4.1", kernels);
+}
+
+}    // namespace simd
+
+}    // namespace dragon
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif    // WITH_SSE
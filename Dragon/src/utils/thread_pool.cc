@@ -0,0 +1,108 @@
+#include <algorithm>
+
+#include "utils/thread_pool.h"
+
+namespace dragon {
+
+//  the pool, the worker index and the global id of the calling thread
+static thread_local ThreadPool* tls_pool = nullptr;
+static thread_local int tls_worker_idx = -1;
+static thread_local int tls_thread_id = -1;
+
+//  the ids are reused after the workers exit
+static std::mutex g_thread_ids_mutex;
+static std::vector<bool> g_thread_ids;
+
+int ThreadPool::AcquireThreadId() {
+    std::unique_lock<std::mutex> lock(g_thread_ids_mutex);
+    for (int i = 0; i < g_thread_ids.size(); i++)
+        if (!g_thread_ids[i]) { g_thread_ids[i] = true; return i; }
+    g_thread_ids.push_back(true);
+    return (int)g_thread_ids.size() - 1;
+}
+
+void ThreadPool::ReleaseThreadId(int id) {
+    std::unique_lock<std::mutex> lock(g_thread_ids_mutex);
+    g_thread_ids[id] = false;
+}
+
+int ThreadPool::ThreadId() { return tls_thread_id; }
+
+int ThreadPool::NumCoresPerWorker() {
+    return tls_pool ? tls_pool->cores_per_worker_ : 0;
+}
+
+ThreadPool::ThreadPool(int num_threads)
+    : pending_(0), next_(0), stop_(false) {
+    if (num_threads < 1) num_threads = 1;
+    int num_cores = (int)std::thread::hardware_concurrency();
+    cores_per_worker_ = std::max(num_cores / num_threads, 1);
+    for (int i = 0; i < num_threads; i++)
+        workers_.push_back(std::unique_ptr<Worker>(new Worker()));
+    for (int i = 0; i < num_threads; i++)
+        threads_.push_back(std::thread(&ThreadPool::WorkerLoop, this, i));
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+    for (auto& thread : threads_) thread.join();
+}
+
+void ThreadPool::Schedule(Task task) {
+    int idx = tls_pool == this ? tls_worker_idx
+                               : (int)(next_++ % workers_.size());
+    {
+        std::unique_lock<std::mutex> lock(workers_[idx]->mutex);
+        workers_[idx]->tasks.push_back(std::move(task));
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        pending_++;
+    }
+    cond_.notify_one();
+}
+
+bool ThreadPool::Pop(int idx, Task* task) {
+    std::unique_lock<std::mutex> lock(workers_[idx]->mutex);
+    if (workers_[idx]->tasks.empty()) return false;
+    *task = std::move(workers_[idx]->tasks.back());
+    workers_[idx]->tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::Steal(int idx, Task* task) {
+    int num_workers = (int)workers_.size();
+    for (int i = 1; i < num_workers; i++) {
+        Worker* victim = workers_[(idx + i) % num_workers].get();
+        std::unique_lock<std::mutex> lock(victim->mutex);
+        if (victim->tasks.empty()) continue;
+        *task = std::move(victim->tasks.front());
+        victim->tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::WorkerLoop(int idx) {
+    tls_pool = this;
+    tls_worker_idx = idx;
+    tls_thread_id = AcquireThreadId();
+    while (true) {
+        Task task;
+        if (Pop(idx, &task) || Steal(idx, &task)) {
+            pending_--;
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this]() { return stop_ || pending_ > 0; });
+        if (stop_ && pending_ == 0) break;
+    }
+    ReleaseThreadId(tls_thread_id);
+}
+
+}    // namespace dragon